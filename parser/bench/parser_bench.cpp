@@ -0,0 +1,95 @@
+#include "parser.hpp"
+#include "token.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Throughput of Parser::parse over token streams standing for 1 KiB to 1 GiB of TINY source.
+// The tokens are those of the program the scanner benchmarks generate, without its comments,
+// so bytes/sec counts the same source text. Sizes above the BENCH_MAX_BYTES environment
+// variable, if set, are skipped, since the largest streams need tens of GiB of memory.
+
+namespace
+{
+    // The program repeated by the benchmark
+    const std::string SNIPPET =
+        "read x;\n"
+        "if 0 < x then\n"
+        "    fact := 1;\n"
+        "    repeat\n"
+        "        fact := fact * x;\n"
+        "        x := x - 1\n"
+        "    until x = 0;\n"
+        "    write fact\n"
+        "end;\n"
+        "total := (total + fact) / 2;\n";
+
+    // The tokens of SNIPPET
+    const std::vector<Token> SNIPPET_TOKENS = {
+        Token(TokenType::READ, "read"), Token(TokenType::IDENTIFIER, "x"), Token(TokenType::SEMICOLON, ";"),
+        Token(TokenType::IF, "if"), Token(TokenType::NUMBER, "0"), Token(TokenType::LT, "<"),
+        Token(TokenType::IDENTIFIER, "x"), Token(TokenType::THEN, "then"),
+        Token(TokenType::IDENTIFIER, "fact"), Token(TokenType::ASSIGN, ":="), Token(TokenType::NUMBER, "1"),
+        Token(TokenType::SEMICOLON, ";"),
+        Token(TokenType::REPEAT, "repeat"),
+        Token(TokenType::IDENTIFIER, "fact"), Token(TokenType::ASSIGN, ":="), Token(TokenType::IDENTIFIER, "fact"),
+        Token(TokenType::TIMES, "*"), Token(TokenType::IDENTIFIER, "x"), Token(TokenType::SEMICOLON, ";"),
+        Token(TokenType::IDENTIFIER, "x"), Token(TokenType::ASSIGN, ":="), Token(TokenType::IDENTIFIER, "x"),
+        Token(TokenType::MINUS, "-"), Token(TokenType::NUMBER, "1"),
+        Token(TokenType::UNTIL, "until"), Token(TokenType::IDENTIFIER, "x"), Token(TokenType::EQ, "="),
+        Token(TokenType::NUMBER, "0"), Token(TokenType::SEMICOLON, ";"),
+        Token(TokenType::WRITE, "write"), Token(TokenType::IDENTIFIER, "fact"),
+        Token(TokenType::END, "end"), Token(TokenType::SEMICOLON, ";"),
+        Token(TokenType::IDENTIFIER, "total"), Token(TokenType::ASSIGN, ":="), Token(TokenType::LPAREN, "("),
+        Token(TokenType::IDENTIFIER, "total"), Token(TokenType::PLUS, "+"), Token(TokenType::IDENTIFIER, "fact"),
+        Token(TokenType::RPAREN, ")"), Token(TokenType::DIVIDE, "/"), Token(TokenType::NUMBER, "2"),
+        Token(TokenType::SEMICOLON, ";")};
+
+    // Repeats the snippet's tokens until they stand for at least `size` bytes of source
+    std::vector<Token> makeTokens(size_t size, size_t &sourceSize)
+    {
+        size_t repetitions = (size + SNIPPET.size() - 1) / SNIPPET.size();
+        sourceSize = repetitions * SNIPPET.size();
+
+        std::vector<Token> tokens;
+        tokens.reserve(repetitions * SNIPPET_TOKENS.size() + 1);
+        for (size_t i = 0; i < repetitions; ++i)
+        {
+            tokens.insert(tokens.end(), SNIPPET_TOKENS.begin(), SNIPPET_TOKENS.end());
+        }
+
+        // statements are separated, not terminated, by semicolons
+        tokens.back() = Token(TokenType::END_OF_INPUT, "$");
+        return tokens;
+    }
+}
+
+// Constructing a parser over the tokens and parsing them, as main() does
+void BM_Parse(benchmark::State &state)
+{
+    const char *limit = std::getenv("BENCH_MAX_BYTES");
+    if (limit != nullptr && static_cast<unsigned long long>(state.range(0)) > std::strtoull(limit, nullptr, 10))
+    {
+        state.SkipWithError("input larger than BENCH_MAX_BYTES");
+        return;
+    }
+
+    size_t sourceSize = 0;
+    const std::vector<Token> tokens = makeTokens(static_cast<size_t>(state.range(0)), sourceSize);
+
+    for (auto _ : state)
+    {
+        Parser parser(tokens);
+        if (!parser.parse())
+        {
+            state.SkipWithError("parse failed");
+            return;
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(sourceSize));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(state.iterations()) * static_cast<double>(tokens.size()),
+                                                  benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Parse)->RangeMultiplier(32)->Range(1 << 10, 1 << 30)->Unit(benchmark::kMillisecond);
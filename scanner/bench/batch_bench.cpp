@@ -0,0 +1,103 @@
+/**
+ * @file batch_bench.cpp
+ * @brief Tokenizing a directory of files with one scanner process per file against one batch run.
+ *
+ * Both benchmarks tokenize the same generated files into the same kind of output files. The
+ * process-per-file version starts `./scanner <in> <out>` for every file, as a shell loop over
+ * the tree would; it needs the scanner executable, built by `make`, in the working directory.
+ * The batch version runs `BatchScanner` in this process, on 1 thread and on all cores.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include "batch_scanner.hpp"
+#include "bench_sources.hpp"
+#include "file_handler.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    namespace
+    {
+        // Size of every generated input file
+        constexpr size_t FILE_SIZE = 16 << 10;
+
+        // Creates a directory of generated input files and returns its path
+        std::filesystem::path makeInputDirectory(size_t fileCount)
+        {
+            std::filesystem::path root = std::filesystem::temp_directory_path() / "scanner_batch_bench";
+            std::filesystem::remove_all(root);
+            std::filesystem::create_directories(root / "in");
+            const std::string source = makeSource(FILE_SIZE);
+            for (size_t i = 0; i < fileCount; ++i)
+            {
+                FileHandler::writeFile((root / "in" / ("f" + std::to_string(i) + ".tny")).string(), source);
+            }
+            return root;
+        }
+
+        // Reports the input size and file count of a run
+        void setCounters(benchmark::State &state, size_t fileCount)
+        {
+            state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * fileCount * FILE_SIZE));
+            state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * fileCount));
+        }
+    } // namespace
+
+    // One scanner process per file
+    void BM_ProcessPerFile(benchmark::State &state)
+    {
+        if (!std::filesystem::exists("scanner"))
+        {
+            state.SkipWithError("./scanner not found, run make first");
+            return;
+        }
+
+        size_t fileCount = static_cast<size_t>(state.range(0));
+        std::filesystem::path root = makeInputDirectory(fileCount);
+        std::filesystem::create_directories(root / "out");
+
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < fileCount; ++i)
+            {
+                std::string name = "f" + std::to_string(i) + ".tny";
+                std::string command = "./scanner " + (root / "in" / name).string() + " " +
+                                      (root / "out" / (name + ".tokens")).string() + " > /dev/null";
+                if (std::system(command.c_str()) != 0)
+                {
+                    state.SkipWithError("scanner process failed");
+                    break;
+                }
+            }
+        }
+
+        setCounters(state, fileCount);
+        std::filesystem::remove_all(root);
+    }
+    BENCHMARK(BM_ProcessPerFile)->Arg(64)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    // All files in one process, on the given number of threads (0 = all cores)
+    void BM_Batch(benchmark::State &state)
+    {
+        size_t fileCount = static_cast<size_t>(state.range(0));
+        size_t jobs = static_cast<size_t>(state.range(1));
+        std::filesystem::path root = makeInputDirectory(fileCount);
+
+        BatchScanner batch((root / "in").string());
+        for (auto _ : state)
+        {
+            BatchReport report = batch.run((root / "out").string(), jobs);
+            benchmark::DoNotOptimize(report);
+        }
+
+        setCounters(state, fileCount);
+        std::filesystem::remove_all(root);
+    }
+    BENCHMARK(BM_Batch)->Args({64, 1})->Args({64, 0})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace TINY::SCANNER::BENCH
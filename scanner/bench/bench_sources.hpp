@@ -0,0 +1,87 @@
+/**
+ * @file bench_sources.hpp
+ * @brief Generated TINY sources shared by the benchmarks.
+ */
+
+#ifndef BENCH_SOURCES_HPP
+#define BENCH_SOURCES_HPP
+
+#include <cstddef>
+#include <string>
+
+#include "program_generator.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    /**
+     * @brief Repeats a snippet until the source is at least `size` bytes long.
+     *
+     * @param snippet The text to repeat.
+     * @param size The minimum size of the source in bytes.
+     * @return The source.
+     */
+    inline std::string repeatSnippet(const std::string &snippet, std::size_t size)
+    {
+        std::string source;
+        source.reserve(size + snippet.size());
+        while (source.size() < size)
+        {
+            source += snippet;
+        }
+        return source;
+    }
+
+    /**
+     * @brief Builds a TINY source of roughly `size` bytes mixing every token kind, comments and indentation.
+     * @param size The minimum size of the source in bytes.
+     * @return The source.
+     */
+    inline std::string makeSource(std::size_t size)
+    {
+        static const std::string snippet =
+            "{ compute the factorial of x }\n"
+            "read x;\n"
+            "if 0 < x then { don't compute if x <= 0 }\n"
+            "    fact := 1;\n"
+            "    repeat\n"
+            "        fact := fact * x;\n"
+            "        x := x - 1\n"
+            "    until x = 0;\n"
+            "    write fact { output factorial of x }\n"
+            "end;\n"
+            "total := (total + fact) / 2;\n";
+        return repeatSnippet(snippet, size);
+    }
+
+    /**
+     * @brief Builds a source of roughly `size` bytes that is mostly comments and whitespace.
+     * @param size The minimum size of the source in bytes.
+     * @return The source.
+     */
+    inline std::string makeCommentHeavySource(std::size_t size)
+    {
+        static const std::string snippet =
+            "{ This block explains the loop below in far more detail than necessary,\n"
+            "  { including a nested remark { and a remark inside that one } }\n"
+            "  and then some more prose so the comment spans several lines. }\n"
+            "                                x := x + 1;\n"
+            "\t\t\t\t\t\t\t\t{ trailing comment after deep indentation }\n";
+        return repeatSnippet(snippet, size);
+    }
+
+    /**
+     * @brief Generates a random TINY program of roughly `size` bytes, the same one for every run.
+     *
+     * @param size The minimum size of the program in bytes.
+     * @param options The other knobs of the program; its `size` is overridden.
+     * @return The program.
+     */
+    inline std::string makeGeneratedSource(std::size_t size, GeneratorOptions options = GeneratorOptions())
+    {
+        options.size = size;
+        return ProgramGenerator(options).generate();
+    }
+} // namespace TINY::SCANNER::BENCH
+
+#endif // BENCH_SOURCES_HPP
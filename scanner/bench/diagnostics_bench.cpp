@@ -0,0 +1,90 @@
+/**
+ * @file diagnostics_bench.cpp
+ * @brief Reporting the unknown tokens of a malformed source with `Diagnostics` against one flushed line per error.
+ *
+ * Both benchmarks report every unknown token of the same token stream to a file stream on
+ * /dev/null, so the cost of the system calls is included. The per-line version is what
+ * `App::reportUnknownToken` did before: every error is streamed with `std::endl`, which
+ * flushes the stream once per error.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "bench_sources.hpp"
+#include "diagnostics.hpp"
+#include "scanner.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    namespace
+    {
+        // Scans a malformed source, a third of whose tokens are unknown, and reports them with `report`
+        template <typename Report>
+        void runReport(benchmark::State &state, Report report)
+        {
+            const std::string source = repeatSnippet("x := y @ 1; $ z # read w;\n", static_cast<size_t>(state.range(0)));
+            Scanner scanner(source);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            const TokenStream &tokens = builder.getTokens();
+
+            std::ofstream output("/dev/null");
+            size_t errors = 0;
+            for (auto _ : state)
+            {
+                errors += report(output, tokens);
+            }
+
+            state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+            state.SetItemsProcessed(static_cast<int64_t>(errors));
+        }
+    } // namespace
+
+    // One line per error, each flushed with std::endl
+    void BM_ReportPerLine(benchmark::State &state)
+    {
+        runReport(state, [](std::ostream &output, const TokenStream &tokens)
+                  {
+            size_t errors = 0;
+            for (TokenStream::Row token : tokens)
+            {
+                if (token.getType() == TokenType::UNKNOWN)
+                {
+                    output << "-\tError: unexpected token '" << token.getValue()
+                           << "' at line " << token.getLine()
+                           << ", column " << token.getColumn()
+                           << std::endl;
+                    ++errors;
+                }
+            }
+            return errors; });
+    }
+    BENCHMARK(BM_ReportPerLine)->RangeMultiplier(16)->Range(4 << 10, 1 << 20);
+
+    // Errors recorded by Diagnostics and written in batches
+    void BM_ReportDiagnostics(benchmark::State &state)
+    {
+        runReport(state, [](std::ostream &output, const TokenStream &tokens)
+                  {
+            Diagnostics diagnostics;
+            for (TokenStream::Row token : tokens)
+            {
+                if (token.getType() == TokenType::UNKNOWN &&
+                    (diagnostics.report(token.getValue(), token.getLine(), token.getColumn()) || diagnostics.isBatchFull()))
+                {
+                    diagnostics.flush(output);
+                }
+            }
+            diagnostics.flush(output);
+            output.flush();
+            return diagnostics.count(); });
+    }
+    BENCHMARK(BM_ReportDiagnostics)->RangeMultiplier(16)->Range(4 << 10, 1 << 20);
+
+} // namespace TINY::SCANNER::BENCH
@@ -0,0 +1,133 @@
+/**
+ * @file incremental_bench.cpp
+ * @brief Updating a token stream after a small edit against rebuilding it from scratch.
+ *
+ * Every iteration edits one identifier in the middle of the generated source and brings the
+ * token stream up to date. The rebuild cost grows with the source size. The update rescans
+ * only the tokens around the edit, but an edit that changes the length of the source still
+ * moves the source and token arrays after it and shifts the offsets of the later tokens, so
+ * the insert and delete benchmarks grow linearly with the size too, at memmove speed. The
+ * lookup benchmark adds the position of a token after the edit, whose LineIndex is rebuilt
+ * over the whole source after every edit.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "bench_sources.hpp"
+#include "scanner.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    namespace
+    {
+        // The source with the offset of a single-letter identifier (of "read x;") near its middle
+        std::string makeEditableSource(size_t size, size_t &editOffset)
+        {
+            std::string source = makeSource(size);
+            editOffset = source.find("read x;", source.size() / 2) + 5;
+            return source;
+        }
+
+        // Times edits that insert a byte after the identifier, or delete it again, undoing each one untimed
+        void runLengthChangingEdit(benchmark::State &state, bool insert, bool lookup)
+        {
+            size_t editOffset = 0;
+            std::string source = makeEditableSource(static_cast<size_t>(state.range(0)), editOffset);
+            if (!insert)
+            {
+                source.insert(editOffset + 1, 1, 'z');
+            }
+            Scanner scanner(source);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            const size_t lastToken = builder.getTokens().size() - 1;
+
+            size_t rescannedBytes = 0;
+            for (auto _ : state)
+            {
+                TokenStreamUpdate update = insert ? builder.applyEdit(source, editOffset + 1, 0, "z")
+                                                  : builder.applyEdit(source, editOffset + 1, 1, "");
+                rescannedBytes += update.rescannedBytes;
+                if (lookup)
+                {
+                    benchmark::DoNotOptimize(builder.getTokens()[lastToken].getLine());
+                }
+                benchmark::DoNotOptimize(builder.getTokens().size());
+
+                state.PauseTiming();
+                if (insert)
+                {
+                    builder.applyEdit(source, editOffset + 1, 1, "");
+                }
+                else
+                {
+                    builder.applyEdit(source, editOffset + 1, 0, "z");
+                }
+                state.ResumeTiming();
+            }
+            state.counters["rescanned_bytes"] = benchmark::Counter(static_cast<double>(rescannedBytes), benchmark::Counter::kAvgIterations);
+        }
+    } // namespace
+
+    // Apply the edit, then rebuild the whole stream
+    void BM_RebuildAfterEdit(benchmark::State &state)
+    {
+        size_t editOffset = 0;
+        std::string source = makeEditableSource(static_cast<size_t>(state.range(0)), editOffset);
+        for (auto _ : state)
+        {
+            source[editOffset] = source[editOffset] == 'x' ? 'y' : 'x';
+            Scanner scanner(source);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            benchmark::DoNotOptimize(builder.getTokens().size());
+        }
+    }
+    BENCHMARK(BM_RebuildAfterEdit)->RangeMultiplier(16)->Range(4 << 10, 16 << 20);
+
+    // Apply the edit through the incremental update
+    void BM_UpdateAfterEdit(benchmark::State &state)
+    {
+        size_t editOffset = 0;
+        std::string source = makeEditableSource(static_cast<size_t>(state.range(0)), editOffset);
+        Scanner scanner(source);
+        TokenStreamBuilder builder(scanner);
+        builder.build();
+
+        size_t rescannedBytes = 0;
+        for (auto _ : state)
+        {
+            TokenStreamUpdate update = builder.applyEdit(source, editOffset, 1, source[editOffset] == 'x' ? "y" : "x");
+            rescannedBytes += update.rescannedBytes;
+            benchmark::DoNotOptimize(builder.getTokens().size());
+        }
+        state.counters["rescanned_bytes"] = benchmark::Counter(static_cast<double>(rescannedBytes), benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_UpdateAfterEdit)->RangeMultiplier(16)->Range(4 << 10, 16 << 20);
+
+    // Insert a byte through the incremental update, growing the source by one
+    void BM_UpdateAfterInsert(benchmark::State &state)
+    {
+        runLengthChangingEdit(state, true, false);
+    }
+    BENCHMARK(BM_UpdateAfterInsert)->RangeMultiplier(16)->Range(4 << 10, 16 << 20);
+
+    // Delete a byte through the incremental update, shrinking the source by one
+    void BM_UpdateAfterDelete(benchmark::State &state)
+    {
+        runLengthChangingEdit(state, false, false);
+    }
+    BENCHMARK(BM_UpdateAfterDelete)->RangeMultiplier(16)->Range(4 << 10, 16 << 20);
+
+    // Insert a byte, then look up the position of the last token
+    void BM_UpdateAndLookupAfterInsert(benchmark::State &state)
+    {
+        runLengthChangingEdit(state, true, true);
+    }
+    BENCHMARK(BM_UpdateAndLookupAfterInsert)->RangeMultiplier(16)->Range(4 << 10, 16 << 20);
+
+} // namespace TINY::SCANNER::BENCH
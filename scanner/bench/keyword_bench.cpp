@@ -0,0 +1,80 @@
+/**
+ * @file keyword_bench.cpp
+ * @brief Microbenchmark of keyword recognition: the previous if-chain against the perfect hash.
+ *
+ * Both lookups classify the same identifier-heavy word list (mostly identifiers, some
+ * keywords, and identifiers that share a length or first letter with a keyword).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string_view>
+#include <vector>
+
+#include "keyword_table.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    namespace
+    {
+        // The keyword check the scanner used before the perfect hash
+        TokenType ifChainLookup(std::string_view identifier)
+        {
+            if (identifier == "if")
+                return TokenType::IF;
+            if (identifier == "then")
+                return TokenType::THEN;
+            if (identifier == "end")
+                return TokenType::END;
+            if (identifier == "repeat")
+                return TokenType::REPEAT;
+            if (identifier == "until")
+                return TokenType::UNTIL;
+            if (identifier == "read")
+                return TokenType::READ;
+            if (identifier == "write")
+                return TokenType::WRITE;
+            return TokenType::IDENTIFIER;
+        }
+
+        // Identifier-heavy words, roughly one keyword in six
+        const std::vector<std::string_view> &words()
+        {
+            static const std::vector<std::string_view> list = {
+                "x", "fact", "counter", "if", "total", "readme", "y", "tmp", "index", "then",
+                "result", "ended", "sum", "until", "value", "i", "write", "rate", "limit", "end",
+                "reader", "accumulator", "n", "repeat", "temp", "writer", "step", "read", "untill", "max"};
+            return list;
+        }
+
+        template <TokenType (*Lookup)(std::string_view)>
+        void runLookup(benchmark::State &state)
+        {
+            const std::vector<std::string_view> &list = words();
+            for (auto _ : state)
+            {
+                for (std::string_view word : list)
+                {
+                    benchmark::DoNotOptimize(Lookup(word));
+                }
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(list.size()));
+        }
+    } // namespace
+
+    // Up to seven string compares per word
+    void BM_KeywordIfChain(benchmark::State &state)
+    {
+        runLookup<ifChainLookup>(state);
+    }
+    BENCHMARK(BM_KeywordIfChain);
+
+    // One table probe and one compare per word
+    void BM_KeywordPerfectHash(benchmark::State &state)
+    {
+        runLookup<KEYWORDS::lookup>(state);
+    }
+    BENCHMARK(BM_KeywordPerfectHash);
+
+} // namespace TINY::SCANNER::BENCH
@@ -0,0 +1,311 @@
+/**
+ * @file legacy_scanner.hpp
+ * @brief Frozen copy of the character-at-a-time Scanner used as a benchmark baseline.
+ *
+ * This is the Scanner implementation before the DFA core (switch dispatch, `std::isalpha`,
+ * `std::string` building and per-character line/column updates), returning the token of that
+ * time, which owned a copy of its value. It is kept only so the
+ * benchmarks can report the throughput of the current Scanner against it on the same input.
+ */
+
+#ifndef LEGACY_SCANNER_HPP
+#define LEGACY_SCANNER_HPP
+
+#include <cctype>
+#include <stack>
+#include <string>
+#include <utility>
+
+#include "token.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    /**
+     * @struct LegacyToken
+     * @brief The original Token, which owned a copy of its value in const members, so vectors
+     *        of it copy every value when they grow.
+     */
+    struct LegacyToken
+    {
+        LegacyToken(TokenType type, std::string value, int line, int column)
+            : type(type), value(std::move(value)), line(line), column(column)
+        {
+        }
+
+        TokenType getType() const
+        {
+            return type;
+        }
+
+        const TokenType type;
+        const std::string value;
+        const int line;
+        const int column;
+    };
+
+    /**
+     * @class LegacyScanner
+     * @brief The original Scanner implementation, see the file comment.
+     */
+    class LegacyScanner
+    {
+    public:
+        LegacyScanner(const std::string &input);
+        LegacyToken getNextToken();
+        bool hasMoreTokens();
+
+    private:
+        std::string input;
+        size_t pos = 0;
+        int line = 1;
+        int column = 1;
+
+        char peek() const;
+        char get();
+        void skipWhitespace();
+        bool skipComments();
+        bool skipWhitespaceAndComments();
+    };
+
+    // Constructor: Initializes the Scanner with the input source code
+    inline LegacyScanner::LegacyScanner(const std::string &input) : input(input)
+    {
+    }
+
+    // Extracts the next token from the input source code
+    inline LegacyToken LegacyScanner::getNextToken()
+    {
+        // Skip any whitespace and comments before processing the next token
+        bool unclosedComment = skipWhitespaceAndComments();
+
+        // If an unclosed comment was detected, return an UNKNOWN token with an error message
+        if (unclosedComment)
+        {
+            return LegacyToken(TokenType::UNKNOWN, "Unclosed comment", line, column);
+        }
+
+        // Check if we've reached the end of the input
+        if (pos >= input.size())
+        {
+            // Return an UNKNOWN token to indicate end of input (or define an EOF token if desired)
+            return LegacyToken(TokenType::UNKNOWN, "", line, column);
+        }
+
+        // Get the next character from the input
+        char current = get();
+
+        // Handle single-character tokens using a switch statement
+        switch (current)
+        {
+        case '+':
+            return LegacyToken(TokenType::PLUS, "+", line, column);
+        case '-':
+            return LegacyToken(TokenType::MINUS, "-", line, column);
+        case '*':
+            return LegacyToken(TokenType::MULT, "*", line, column);
+        case '/':
+            return LegacyToken(TokenType::DIV, "/", line, column);
+        case '(':
+            return LegacyToken(TokenType::OPENBRACKET, "(", line, column);
+        case ')':
+            return LegacyToken(TokenType::CLOSEDBRACKET, ")", line, column);
+        case ';':
+            return LegacyToken(TokenType::SEMICOLON, ";", line, column);
+        case ':':
+            // Check if the next character is '=' to form the ':=' token
+            if (peek() == '=')
+            {
+                get(); // Consume '='
+                return LegacyToken(TokenType::ASSIGN, ":=", line, column);
+            }
+            // If not, return an UNKNOWN token for ':'
+            return LegacyToken(TokenType::UNKNOWN, ":", line, column);
+        case '<':
+            return LegacyToken(TokenType::LESSTHAN, "<", line, column);
+        case '=':
+            return LegacyToken(TokenType::EQUAL, "=", line, column);
+        }
+
+        // Identifiers and keywords
+        if (std::isalpha(current))
+        {
+            std::string identifier(1, current); // Start building the identifier
+
+            // Continue consuming alphabetic characters
+            while (std::isalpha(peek()))
+            {
+                identifier += get();
+            }
+
+            // Check if the identifier matches any reserved keywords
+            if (identifier == "if")
+                return LegacyToken(TokenType::IF, identifier, line, column);
+            if (identifier == "then")
+                return LegacyToken(TokenType::THEN, identifier, line, column);
+            if (identifier == "end")
+                return LegacyToken(TokenType::END, identifier, line, column);
+            if (identifier == "repeat")
+                return LegacyToken(TokenType::REPEAT, identifier, line, column);
+            if (identifier == "until")
+                return LegacyToken(TokenType::UNTIL, identifier, line, column);
+            if (identifier == "read")
+                return LegacyToken(TokenType::READ, identifier, line, column);
+            if (identifier == "write")
+                return LegacyToken(TokenType::WRITE, identifier, line, column);
+
+            // If not a keyword, it's an identifier
+            return LegacyToken(TokenType::IDENTIFIER, identifier, line, column);
+        }
+
+        // Numbers (integer literals)
+        if (std::isdigit(current))
+        {
+            std::string number(1, current); // Start building the number literal
+
+            // Continue consuming digit characters
+            while (std::isdigit(peek()))
+            {
+                number += get();
+            }
+
+            // Return a NUMBER token
+            return LegacyToken(TokenType::NUMBER, number, line, column);
+        }
+
+        // If the character doesn't match any known token patterns, return an UNKNOWN token
+        return LegacyToken(TokenType::UNKNOWN, std::string(1, current), line, column);
+    }
+
+    // Checks if there are more tokens to be extracted
+    inline bool LegacyScanner::hasMoreTokens()
+    {
+        // Save the current state to avoid modifying the scanner's actual state
+        size_t tempPos = pos;
+        int tempLine = line;
+        int tempColumn = column;
+
+        // Temporarily skip whitespace and comments
+        bool unclosedComment = skipWhitespaceAndComments();
+
+        // Determine if there are more tokens
+        bool hasMore = (pos < input.size()) && !unclosedComment;
+
+        // Restore the scanner's state
+        pos = tempPos;
+        line = tempLine;
+        column = tempColumn;
+
+        return hasMore;
+    }
+
+    // Skips over whitespace and comments in the input
+    inline bool LegacyScanner::skipWhitespaceAndComments()
+    {
+        while (true)
+        {
+            skipWhitespace();
+
+            bool unclosedComment = skipComments();
+            if (unclosedComment)
+            {
+                // Unclosed comment detected; return true to indicate error
+                return true;
+            }
+
+            // If no more whitespace or comments, break out of the loop
+            if (!std::isspace(peek()) && peek() != '{')
+            {
+                break;
+            }
+        }
+        // No unclosed comment detected
+        return false;
+    }
+
+    // Skips over whitespace characters in the input
+    inline void LegacyScanner::skipWhitespace()
+    {
+        // Consume all consecutive whitespace characters
+        while (pos < input.size() && std::isspace(peek()))
+        {
+            get(); // Consume the whitespace character
+        }
+    }
+
+    // Skips over comments in the input source code
+    inline bool LegacyScanner::skipComments()
+    {
+        if (pos < input.size() && peek() == '{')
+        {
+            get(); // Consume initial '{'
+            std::stack<char> commentStack;
+            commentStack.push('{'); // Push the initial '{' onto the stack
+
+            while (pos < input.size())
+            {
+                char currentChar = get();
+
+                if (currentChar == '{')
+                {
+                    commentStack.push('{'); // Push nested '{' onto the stack
+                }
+                else if (currentChar == '}')
+                {
+                    commentStack.pop(); // Pop a '{' from the stack
+
+                    if (commentStack.empty())
+                    {
+                        // All comments are closed
+                        skipWhitespace(); // Skip whitespace after comment
+                        return false;     // Comment was successfully skipped
+                    }
+                }
+                else if (currentChar == '\0')
+                {
+                    // End of input reached unexpectedly
+                    return true; // Unclosed comment detected
+                }
+                // Continue consuming characters inside the comment
+            }
+
+            // EOF reached before all comments were closed
+            return true; // Unclosed comment detected
+        }
+        return false; // No comment to skip
+    }
+
+    // Peeks at the next character in the input without advancing the position
+    inline char LegacyScanner::peek() const
+    {
+        // Return the next character if within bounds, or '\0' if at the end
+        return pos < input.size() ? input[pos] : '\0';
+    }
+
+    // Gets the next character in the input and advances the position
+    inline char LegacyScanner::get()
+    {
+        // Check if at the end of input
+        if (pos >= input.size())
+        {
+            return '\0';
+        }
+
+        char currentChar = input[pos++]; // Get the current character and advance position
+
+        // Update line and column numbers for error reporting and tracking
+        if (currentChar == '\n')
+        {
+            line++;     // Move to the next line
+            column = 1; // Reset column number
+        }
+        else
+        {
+            column++; // Move to the next column
+        }
+
+        return currentChar;
+    }
+} // namespace TINY::SCANNER::BENCH
+
+#endif // LEGACY_SCANNER_HPP
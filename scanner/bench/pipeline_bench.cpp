@@ -0,0 +1,158 @@
+/**
+ * @file pipeline_bench.cpp
+ * @brief Throughput of every phase of the scanner pipeline over inputs from 1 KiB to 1 GiB.
+ *
+ * The phases are measured separately on the same generated source: pulling tokens one by one
+ * with `Scanner::getNextToken`, building the whole `TokenStream` with `TokenStreamBuilder::build`,
+ * and writing a built stream with `FileHandler::writeTokens`. `build` also runs on a program from
+ * `ProgramGenerator`, whose nesting and comments are closer to real code. Every benchmark reports
+ * bytes/sec of input and a `tokens` rate, so `make bench-json` gives one comparable record per commit.
+ *
+ * The largest inputs need several GiB of memory (and of disk for the written tokens); sizes
+ * above the `BENCH_MAX_BYTES` environment variable, if set, are skipped.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include "bench_sources.hpp"
+#include "file_handler.hpp"
+#include "scanner.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    namespace
+    {
+        // Skips the benchmark when its input is larger than BENCH_MAX_BYTES allows
+        bool exceedsSizeLimit(benchmark::State &state)
+        {
+            const char *limit = std::getenv("BENCH_MAX_BYTES");
+            if (limit != nullptr && static_cast<unsigned long long>(state.range(0)) > std::strtoull(limit, nullptr, 10))
+            {
+                state.SkipWithError("input larger than BENCH_MAX_BYTES");
+                return true;
+            }
+            return false;
+        }
+
+        // Reports the input bytes and the tokens handled over all iterations
+        void setThroughput(benchmark::State &state, size_t sourceSize, size_t tokenCount)
+        {
+            state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(sourceSize));
+            state.counters["tokens"] = benchmark::Counter(static_cast<double>(state.iterations()) * static_cast<double>(tokenCount),
+                                                          benchmark::Counter::kIsRate);
+        }
+    } // namespace
+
+    // One token at a time, as the streaming mode consumes them
+    void BM_GetNextToken(benchmark::State &state)
+    {
+        if (exceedsSizeLimit(state))
+        {
+            return;
+        }
+        const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+        size_t tokenCount = 0;
+
+        for (auto _ : state)
+        {
+            Scanner scanner(source);
+            tokenCount = 0;
+            while (true)
+            {
+                const Token token = scanner.getNextToken();
+                if (token.getType() == TokenType::END_OF_INPUT)
+                {
+                    break;
+                }
+                benchmark::DoNotOptimize(token);
+                ++tokenCount;
+            }
+        }
+
+        setThroughput(state, source.size(), tokenCount);
+    }
+    BENCHMARK(BM_GetNextToken)->RangeMultiplier(32)->Range(1 << 10, 1 << 30)->Unit(benchmark::kMillisecond);
+
+    // The whole token stream in one pass
+    void BM_Build(benchmark::State &state)
+    {
+        if (exceedsSizeLimit(state))
+        {
+            return;
+        }
+        const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+        size_t tokenCount = 0;
+
+        for (auto _ : state)
+        {
+            Scanner scanner(source);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            tokenCount = builder.getTokens().size();
+            benchmark::DoNotOptimize(tokenCount);
+        }
+
+        setThroughput(state, source.size(), tokenCount);
+    }
+    BENCHMARK(BM_Build)->RangeMultiplier(32)->Range(1 << 10, 1 << 30)->Unit(benchmark::kMillisecond);
+
+    // The whole token stream of a generated program, with deeper nesting and more comments than makeSource()
+    void BM_BuildGenerated(benchmark::State &state)
+    {
+        if (exceedsSizeLimit(state))
+        {
+            return;
+        }
+        GeneratorOptions options;
+        options.maxNestingDepth = 6;
+        options.commentDensity = 0.3;
+        options.maxCommentDepth = 3;
+        options.vocabularySize = 1000;
+        const std::string source = makeGeneratedSource(static_cast<size_t>(state.range(0)), options);
+        size_t tokenCount = 0;
+
+        for (auto _ : state)
+        {
+            Scanner scanner(source);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            tokenCount = builder.getTokens().size();
+            benchmark::DoNotOptimize(tokenCount);
+        }
+
+        setThroughput(state, source.size(), tokenCount);
+    }
+    BENCHMARK(BM_BuildGenerated)->RangeMultiplier(32)->Range(1 << 10, 1 << 30)->Unit(benchmark::kMillisecond);
+
+    // Writing an already built token stream to a text file
+    void BM_WriteTokens(benchmark::State &state)
+    {
+        if (exceedsSizeLimit(state))
+        {
+            return;
+        }
+        const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+        Scanner scanner(source);
+        TokenStreamBuilder builder(scanner);
+        builder.build();
+        const TokenStream &tokens = builder.getTokens();
+
+        const std::string outputPath = (std::filesystem::temp_directory_path() / "scanner_pipeline_bench.tokens").string();
+        for (auto _ : state)
+        {
+            FileHandler::writeTokens(outputPath, tokens);
+        }
+        std::remove(outputPath.c_str());
+
+        setThroughput(state, source.size(), tokens.size());
+    }
+    BENCHMARK(BM_WriteTokens)->RangeMultiplier(32)->Range(1 << 10, 1 << 30)->Unit(benchmark::kMillisecond);
+
+} // namespace TINY::SCANNER::BENCH
@@ -0,0 +1,134 @@
+/**
+ * @file scanner_bench.cpp
+ * @brief Throughput benchmarks of the Scanner against the legacy character-at-a-time implementation.
+ *
+ * Both scanners tokenize the same generated TINY source, using the same
+ * `hasMoreTokens()` / `getNextToken()` loop, which returns a `Token` object per token.
+ * Throughput is reported in bytes/sec and tokens/sec.
+ *
+ * BM_Collect* store every token in a growing vector, where owning tokens copy their values
+ * on each reallocation and compact tokens are copied as plain bytes.
+ *
+ * A further set compares the policy instantiations of the scanner (scanner_policies.hpp):
+ * positions tracked or not, times values kept or dropped, with the single-pass
+ * `END_OF_INPUT` loop.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "bench_sources.hpp"
+#include "legacy_scanner.hpp"
+#include "scanner.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    namespace
+    {
+        template <typename ScannerType>
+        void runScanner(benchmark::State &state)
+        {
+            const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+            size_t tokenCount = 0;
+
+            for (auto _ : state)
+            {
+                ScannerType scanner(source);
+                while (scanner.hasMoreTokens())
+                {
+                    const auto token = scanner.getNextToken();
+                    benchmark::DoNotOptimize(token);
+                    ++tokenCount;
+                }
+            }
+
+            state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+            state.SetItemsProcessed(static_cast<int64_t>(tokenCount));
+        }
+    } // namespace
+
+    // Character-at-a-time scanner, before the DFA core
+    void BM_LegacyScanner(benchmark::State &state)
+    {
+        runScanner<LegacyScanner>(state);
+    }
+    BENCHMARK(BM_LegacyScanner)->RangeMultiplier(16)->Range(4 << 10, 1 << 20);
+
+    // Current table-driven scanner
+    void BM_Scanner(benchmark::State &state)
+    {
+        runScanner<Scanner>(state);
+    }
+    BENCHMARK(BM_Scanner)->RangeMultiplier(16)->Range(4 << 10, 1 << 20);
+
+    // Collecting every token into a growing vector, which copies the tokens on every reallocation
+    template <typename ScannerType>
+    void runCollect(benchmark::State &state)
+    {
+        const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+        size_t tokenCount = 0;
+
+        for (auto _ : state)
+        {
+            ScannerType scanner(source);
+            std::vector<decltype(scanner.getNextToken())> tokens;
+            while (scanner.hasMoreTokens())
+            {
+                tokens.push_back(scanner.getNextToken());
+            }
+            benchmark::DoNotOptimize(tokens.data());
+            tokenCount += tokens.size();
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+        state.SetItemsProcessed(static_cast<int64_t>(tokenCount));
+    }
+
+    // Legacy tokens own their values in const members, growing the vector copies every string
+    void BM_CollectLegacyTokens(benchmark::State &state)
+    {
+        runCollect<LegacyScanner>(state);
+    }
+    BENCHMARK(BM_CollectLegacyTokens)->Arg(1 << 20);
+
+    // Tokens are trivially copyable records viewing the source
+    void BM_CollectTokens(benchmark::State &state)
+    {
+        runCollect<Scanner>(state);
+    }
+    BENCHMARK(BM_CollectTokens)->Arg(1 << 20);
+
+    // One scanner instantiation of the policy matrix
+    template <class PositionPolicy, class ValuePolicy>
+    void BM_ScannerPolicy(benchmark::State &state)
+    {
+        const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+        size_t tokenCount = 0;
+
+        for (auto _ : state)
+        {
+            BasicScanner<PositionPolicy, ValuePolicy> scanner(source);
+            while (true)
+            {
+                const auto token = scanner.getNextToken();
+                if (token.getType() == TokenType::END_OF_INPUT)
+                {
+                    break;
+                }
+                benchmark::DoNotOptimize(token);
+                ++tokenCount;
+            }
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+        state.SetItemsProcessed(static_cast<int64_t>(tokenCount));
+    }
+    BENCHMARK_TEMPLATE(BM_ScannerPolicy, TrackPositions, ViewValues)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_ScannerPolicy, TrackPositions, NoValues)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_ScannerPolicy, NoPositions, ViewValues)->Arg(1 << 20);
+    BENCHMARK_TEMPLATE(BM_ScannerPolicy, NoPositions, NoValues)->Arg(1 << 20);
+
+} // namespace TINY::SCANNER::BENCH
@@ -0,0 +1,53 @@
+/**
+ * @file simd_scan_bench.cpp
+ * @brief Throughput of the Scanner on comment- and indentation-heavy input, for every SIMD kernel.
+ *
+ * Each benchmark forces one kernel (scalar, SSE2, AVX2) and tokenizes the same source,
+ * which is mostly long nested comments and deep indentation. Kernels the CPU does not
+ * support are skipped.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "bench_sources.hpp"
+#include "scanner.hpp"
+#include "simd_scan.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    // Scanner on comment-heavy input, with the kernel given by the first argument
+    void BM_CommentHeavyScanner(benchmark::State &state)
+    {
+        SIMD::Kernel detected = SIMD::activeKernel();
+        SIMD::Kernel kernel = static_cast<SIMD::Kernel>(state.range(0));
+        if (!SIMD::selectKernel(kernel))
+        {
+            state.SkipWithError("kernel not supported on this CPU");
+            return;
+        }
+        state.SetLabel(std::string(SIMD::kernelName(kernel)));
+
+        const std::string source = makeCommentHeavySource(static_cast<size_t>(state.range(1)));
+        for (auto _ : state)
+        {
+            Scanner scanner(source);
+            while (scanner.hasMoreTokens())
+            {
+                const Token token = scanner.getNextToken();
+                benchmark::DoNotOptimize(token);
+            }
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+        SIMD::selectKernel(detected);
+    }
+    BENCHMARK(BM_CommentHeavyScanner)
+        ->ArgsProduct({{static_cast<int64_t>(SIMD::Kernel::SCALAR),
+                        static_cast<int64_t>(SIMD::Kernel::SSE2),
+                        static_cast<int64_t>(SIMD::Kernel::AVX2)},
+                       {1 << 20}});
+
+} // namespace TINY::SCANNER::BENCH
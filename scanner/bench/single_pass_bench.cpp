@@ -0,0 +1,99 @@
+/**
+ * @file single_pass_bench.cpp
+ * @brief Work saved by single-pass token iteration on comment-heavy input.
+ *
+ * The two-pass loop calls `hasMoreTokens()` before every `getNextToken()`, so the
+ * whitespace and comments in front of each token are skipped twice. The single-pass
+ * loop stops at the `END_OF_INPUT` token instead, and `TokenStreamBuilder::build()`
+ * skips them once without creating `Token` objects. The "skipped_bytes" counter is the
+ * number of bytes each loop walks over outside of tokens, per iteration.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "bench_sources.hpp"
+#include "scanner.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    namespace
+    {
+        // Bytes of the source that are not part of any token
+        double skippedBytes(const std::string &source)
+        {
+            Scanner scanner(source);
+            size_t tokenBytes = 0;
+            while (true)
+            {
+                const Token token = scanner.getNextToken();
+                if (token.getType() == TokenType::END_OF_INPUT)
+                {
+                    break;
+                }
+                tokenBytes += token.getValue().size();
+            }
+            return static_cast<double>(source.size() - tokenBytes);
+        }
+    } // namespace
+
+    // hasMoreTokens() / getNextToken() loop, every comment is skipped twice
+    void BM_TwoPassLoop(benchmark::State &state)
+    {
+        const std::string source = makeCommentHeavySource(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            Scanner scanner(source);
+            while (scanner.hasMoreTokens())
+            {
+                const Token token = scanner.getNextToken();
+                benchmark::DoNotOptimize(token);
+            }
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+        state.counters["skipped_bytes"] = 2 * skippedBytes(source);
+    }
+    BENCHMARK(BM_TwoPassLoop)->RangeMultiplier(16)->Range(64 << 10, 16 << 20);
+
+    // getNextToken() until END_OF_INPUT, every comment is skipped once
+    void BM_SinglePassLoop(benchmark::State &state)
+    {
+        const std::string source = makeCommentHeavySource(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            Scanner scanner(source);
+            while (true)
+            {
+                const Token token = scanner.getNextToken();
+                if (token.getType() == TokenType::END_OF_INPUT)
+                {
+                    break;
+                }
+                benchmark::DoNotOptimize(token);
+            }
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+        state.counters["skipped_bytes"] = skippedBytes(source);
+    }
+    BENCHMARK(BM_SinglePassLoop)->RangeMultiplier(16)->Range(64 << 10, 16 << 20);
+
+    // TokenStreamBuilder::build(), single pass into a TokenStream
+    void BM_SinglePassBuild(benchmark::State &state)
+    {
+        const std::string source = makeCommentHeavySource(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            Scanner scanner(source);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            benchmark::DoNotOptimize(builder.getTokens().getTypes().data());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+        state.counters["skipped_bytes"] = skippedBytes(source);
+    }
+    BENCHMARK(BM_SinglePassBuild)->RangeMultiplier(16)->Range(64 << 10, 16 << 20);
+
+} // namespace TINY::SCANNER::BENCH
@@ -0,0 +1,67 @@
+/**
+ * @file token_range_bench.cpp
+ * @brief Counting tokens through the lazy `Scanner::tokens()` range against a materialized vector.
+ *
+ * Both benchmarks count the identifiers of the same generated source. The vector version
+ * stores every token before counting, the range version scans them on demand and keeps
+ * only the current one. The "peak_tokens" counter is the number of tokens held at once.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "bench_sources.hpp"
+#include "scanner.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    namespace
+    {
+        // Whether a token is an identifier
+        bool isIdentifier(const Token &token)
+        {
+            return token.getType() == TokenType::IDENTIFIER;
+        }
+    } // namespace
+
+    // Materialize every token, then count
+    void BM_CountMaterialized(benchmark::State &state)
+    {
+        const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+        size_t peakTokens = 0;
+        for (auto _ : state)
+        {
+            Scanner scanner(source);
+            std::vector<Token> tokens;
+            for (const Token &token : scanner.tokens())
+            {
+                tokens.push_back(token);
+            }
+            peakTokens = tokens.size();
+            benchmark::DoNotOptimize(std::count_if(tokens.begin(), tokens.end(), isIdentifier));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+        state.counters["peak_tokens"] = static_cast<double>(peakTokens);
+    }
+    BENCHMARK(BM_CountMaterialized)->RangeMultiplier(16)->Range(64 << 10, 16 << 20);
+
+    // Count while scanning through the lazy range
+    void BM_CountTokenRange(benchmark::State &state)
+    {
+        const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            Scanner scanner(source);
+            Scanner::TokenRange range = scanner.tokens();
+            benchmark::DoNotOptimize(std::count_if(range.begin(), range.end(), isIdentifier));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+        state.counters["peak_tokens"] = 1;
+    }
+    BENCHMARK(BM_CountTokenRange)->RangeMultiplier(16)->Range(64 << 10, 16 << 20);
+
+} // namespace TINY::SCANNER::BENCH
@@ -0,0 +1,105 @@
+/**
+ * @file token_stream_bench.cpp
+ * @brief Benchmarks of building and scanning tokens as `Token` objects and as a `TokenStream`.
+ *
+ * The "build" benchmarks tokenize the same generated source into a `std::vector<Token>`
+ * (one object with its own string per token) and into a `TokenStream` (parallel arrays
+ * and views into the source). The "type scan" benchmarks count the unknown tokens, the
+ * pass `App` runs on every token stream, over both containers.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "bench_sources.hpp"
+#include "scanner.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    namespace
+    {
+        // Tokenizes the source into Token objects, as TokenStreamBuilder::build() did before the TokenStream
+        std::vector<Token> buildTokenVector(const std::string &source)
+        {
+            std::vector<Token> tokens;
+            Scanner scanner(source);
+            while (scanner.hasMoreTokens())
+            {
+                tokens.push_back(scanner.getNextToken());
+            }
+            return tokens;
+        }
+    } // namespace
+
+    // Tokenize into a vector of Token objects
+    void BM_BuildTokenVector(benchmark::State &state)
+    {
+        const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            std::vector<Token> tokens = buildTokenVector(source);
+            benchmark::DoNotOptimize(tokens.data());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+    }
+    BENCHMARK(BM_BuildTokenVector)->RangeMultiplier(16)->Range(64 << 10, 16 << 20);
+
+    // Tokenize into a TokenStream
+    void BM_BuildTokenStream(benchmark::State &state)
+    {
+        const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            Scanner scanner(source);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            benchmark::DoNotOptimize(builder.getTokens().getTypes().data());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+    }
+    BENCHMARK(BM_BuildTokenStream)->RangeMultiplier(16)->Range(64 << 10, 16 << 20);
+
+    // Count unknown tokens in a vector of Token objects
+    void BM_TypeScanTokenVector(benchmark::State &state)
+    {
+        const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+        const std::vector<Token> tokens = buildTokenVector(source);
+        for (auto _ : state)
+        {
+            size_t unknown = 0;
+            for (const Token &token : tokens)
+            {
+                unknown += token.getType() == TokenType::UNKNOWN;
+            }
+            benchmark::DoNotOptimize(unknown);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(tokens.size()));
+    }
+    BENCHMARK(BM_TypeScanTokenVector)->RangeMultiplier(16)->Range(64 << 10, 16 << 20);
+
+    // Count unknown tokens in the type array of a TokenStream
+    void BM_TypeScanTokenStream(benchmark::State &state)
+    {
+        const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+        Scanner scanner(source);
+        TokenStreamBuilder builder(scanner);
+        builder.build();
+        const std::vector<TokenType> &types = builder.getTokens().getTypes();
+        for (auto _ : state)
+        {
+            size_t unknown = 0;
+            for (TokenType type : types)
+            {
+                unknown += type == TokenType::UNKNOWN;
+            }
+            benchmark::DoNotOptimize(unknown);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(types.size()));
+    }
+    BENCHMARK(BM_TypeScanTokenStream)->RangeMultiplier(16)->Range(64 << 10, 16 << 20);
+
+} // namespace TINY::SCANNER::BENCH
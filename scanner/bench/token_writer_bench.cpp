@@ -0,0 +1,99 @@
+/**
+ * @file token_writer_bench.cpp
+ * @brief Formatting the text output of a token stream with `TokenWriter` against per-token string streams.
+ *
+ * Both benchmarks write the position-annotated lines of the same token stream into a
+ * discarding stream, so only formatting and buffering are measured. The string stream
+ * version is what `writeTokens` did before: a fresh `std::ostringstream` per token inside
+ * `toString()`, appended to a second string stream holding the whole file.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+#include "bench_sources.hpp"
+#include "scanner.hpp"
+#include "token_stream_builder.hpp"
+#include "token_writer.hpp"
+
+namespace TINY::SCANNER::BENCH
+{
+
+    namespace
+    {
+        // A stream buffer that discards everything written to it
+        class NullBuffer : public std::streambuf
+        {
+        protected:
+            std::streamsize xsputn(const char *, std::streamsize count) override
+            {
+                return count;
+            }
+
+            int_type overflow(int_type c) override
+            {
+                return traits_type::not_eof(c);
+            }
+        };
+
+        // The text line of a token, built the way Token::toString used to build it
+        std::string streamToString(const TokenStream::Row &token)
+        {
+            std::ostringstream oss;
+            oss << token.getValue() << ", " << static_cast<int>(token.getType());
+            oss << " [Line: " << token.getLine() << ", Column: " << token.getColumn() << "]";
+            return oss.str();
+        }
+
+        // Builds the token stream written by both benchmarks
+        template <typename Write>
+        void runWriter(benchmark::State &state, Write write)
+        {
+            const std::string source = makeSource(static_cast<size_t>(state.range(0)));
+            Scanner scanner(source);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            const TokenStream &tokens = builder.getTokens();
+
+            NullBuffer sink;
+            std::ostream output(&sink);
+            for (auto _ : state)
+            {
+                write(output, tokens);
+            }
+
+            state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(source.size()));
+            state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(tokens.size()));
+        }
+    } // namespace
+
+    // One ostringstream per token, collected in another ostringstream
+    void BM_WriteStringStreams(benchmark::State &state)
+    {
+        runWriter(state, [](std::ostream &output, const TokenStream &tokens)
+                  {
+            std::ostringstream content;
+            for (TokenStream::Row token : tokens)
+            {
+                content << streamToString(token) << "\n";
+            }
+            output << content.str(); });
+    }
+    BENCHMARK(BM_WriteStringStreams)->RangeMultiplier(16)->Range(4 << 10, 1 << 20);
+
+    // Lines formatted with to_chars into one reusable buffer
+    void BM_WriteTokenWriter(benchmark::State &state)
+    {
+        runWriter(state, [](std::ostream &output, const TokenStream &tokens)
+                  {
+            TokenWriter writer(output);
+            writer.write(tokens, true);
+            writer.flush(); });
+    }
+    BENCHMARK(BM_WriteTokenWriter)->RangeMultiplier(16)->Range(4 << 10, 1 << 20);
+
+} // namespace TINY::SCANNER::BENCH
@@ -11,16 +11,27 @@
 #define APP_HPP
 
 #include <getopt.h>
+#include <csignal>
 
 #include <iostream>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "batch_scanner.hpp"
+#include "diagnostics.hpp"
 #include "file_handler.hpp"
+#include "run_stats.hpp"
+#include "scan_server.hpp"
 #include "scanner.hpp"
+#include "stream_scanner.hpp"
 #include "token.hpp"
+#include "token_pipe.hpp"
+#include "token_stream.hpp"
 #include "token_stream_builder.hpp"
+#include "token_writer.hpp"
 
 /**
  * @namespace TINY::SCANNER
@@ -33,7 +44,8 @@
 namespace TINY::SCANNER
 {
 
-    static const std::string DEFAULT_OUTPUT_FILE = "output/output.txt"; /**< Default output file path */
+    static const std::string DEFAULT_OUTPUT_FILE = "output/output.txt";        /**< Default output file path */
+    static const std::string DEFAULT_BATCH_OUTPUT_DIRECTORY = "output/batch"; /**< Default output directory in batch mode */
 
     /**
      * @class App
@@ -75,35 +87,87 @@ namespace TINY::SCANNER
          *
          * - If `showHelp` is true, the function does nothing.
          * - If `interactiveMode` is true, it runs the application in interactive mode.
+         * - If `serveSocketPath` is set, it runs the application as a scan server.
+         * - If `readStdin` or `writeStdout` is true, it runs the application in pipe mode.
          * - Otherwise, it runs the application in file mode.
+         *
+         * However the mode ends, the unknown tokens not yet reported and their count are then
+         * written to the standard error stream.
          */
         void run();
 
     private:
-        bool showHelp = false;                /**< Flag to show help message */
-        bool showOutput = false;              /**< Flag to show output in the console */
-        bool includeTokenPosition = false;    /**< Flag to include token position in output */
-        std::string inputFilePath;            /**< Path to the input file */
-        std::string outputFilePath;           /**< Path to the output file */
-        bool interactiveMode = false;         /**< Flag to run the application in interactive mode */
-        std::string terminateKeyword = "END"; /**< Keyword to terminate interactive mode */
-        bool hasOutputFile = false;           /**< Flag to indicate if an output file is specified */
+        /**
+         * @struct TokenOutputs
+         * @brief The writers the streaming modes hand every token to as soon as it is scanned.
+         *
+         * At most one of the pipe and text writers carries the token output; the console writer
+         * is set if the tokens are shown. Binary output uses the token pipe format, never the
+         * token file format: a token file holds every distinct value in its pool until the end,
+         * so its memory would grow with the input instead of staying bounded by the buffers.
+         */
+        struct TokenOutputs
+        {
+            std::optional<TokenPipeWriter> pipeWriter; /**< Token pipe format, for binary output */
+            std::optional<TokenWriter> textWriter;     /**< Text output */
+            std::optional<TokenWriter> consoleWriter;  /**< Tokens shown on the console */
+
+            /**
+             * @brief Writes a token to every writer that is set.
+             * @param token The token; its value is only read during the call.
+             * @param includePosition Whether text lines include the token position.
+             */
+            void write(const Token &token, bool includePosition);
+
+            /**
+             * @brief Hands the buffered tokens on.
+             */
+            void flush();
+
+            /**
+             * @brief Writes out everything still buffered and completes the token pipe.
+             */
+            void finish();
+        };
+
+        bool showHelp = false;                                        /**< Flag to show help message */
+        bool showOutput = false;                                      /**< Flag to show output in the console */
+        bool includeTokenPosition = false;                            /**< Flag to include token position in output */
+        std::string inputFilePath;                                    /**< Path to the input file */
+        std::string outputFilePath;                                   /**< Path to the output file */
+        bool interactiveMode = false;                                 /**< Flag to run the application in interactive mode */
+        std::string terminateKeyword = "END";                         /**< Keyword to terminate interactive mode */
+        bool hasOutputFile = false;                                   /**< Flag to indicate if an output file is specified */
+        bool streamMode = false;                                      /**< Flag to scan the input file in fixed-size buffers */
+        size_t streamBufferSize = StreamScanner::DEFAULT_BUFFER_SIZE; /**< Read buffer size in stream mode */
+        size_t jobs = 1;                                              /**< Number of threads used to tokenize, 0 for all cores */
+        bool binaryOutput = false;                                    /**< Flag to write the output file in the binary token format */
+        std::string batchPattern;                                     /**< Directory or glob pattern of the input files in batch mode */
+        bool showStats = false;                                       /**< Flag to report phase timings after the run */
+        bool statsJson = false;                                       /**< Flag to report the stats as JSON instead of a table */
+        RunStats stats;                                               /**< Phase timings of the run */
+        bool readStdin = false;                                       /**< Flag to read the source from the standard input */
+        bool writeStdout = false;                                     /**< Flag to write the tokens to the standard output */
+        std::string serveSocketPath;                                  /**< Socket path of the scan server, empty if not serving */
+        bool jobsSet = false;                                         /**< Flag to indicate if -j was given */
+        size_t maxErrors = 0;                                         /**< Unexpected tokens after which the run stops, 0 for no limit */
+        size_t maxTokenLength = StreamScanner::DEFAULT_MAX_TOKEN_LENGTH; /**< Longest token the streaming modes accept */
+        Diagnostics diagnostics;                                      /**< Unexpected tokens of the run, written in batches */
 
         /**
          * @brief Runs the application in interactive mode.
          *
-         * This function continuously reads TINY code input from the user until the
-         * terminate keyword is entered. It then initializes the scanner and token
-         * stream builder, builds the token stream, and optionally prints the tokens
-         * to the console and writes them to an output file.
+         * This function reads TINY code from the user one line at a time until the terminate
+         * keyword is entered or the input ends. Each line is fed to a `StreamScanner` as soon as
+         * it arrives, and its tokens are printed to the console (if showOutput is true) and
+         * written to the output file (if hasOutputFile is true) before the next line is read.
+         *
+         * The scanner keeps its state between lines, so a comment may span several lines; only
+         * the token cut by the end of the last line is held back, and memory does not grow with
+         * the length of the session. Unknown tokens are reported after the tokens of their line.
          *
-         * The function performs the following steps:
-         * 1. Reads input from the user until the terminate keyword is entered.
-         * 2. Initializes the scanner with the input content.
-         * 3. Initializes the token stream builder with the scanner.
-         * 4. Builds the token stream.
-         * 5. If showOutput is true, prints the tokens to the console.
-         * 6. If hasOutputFile is false, writes the tokens to the specified output file.
+         * @throws std::invalid_argument If the input is empty.
+         * @throws std::runtime_error If no tokens are generated, or after `--max-errors` unknown tokens.
          */
         void runInteractiveMode();
 
@@ -115,7 +179,7 @@ namespace TINY::SCANNER
          * them to an output file.
          *
          * @details
-         * - Reads the content of the input file specified by `inputFilePath`.
+         * - Memory-maps the input file specified by `inputFilePath`, so the file is scanned in place.
          * - Initializes the `Scanner` with the input file content.
          * - Initializes the `TokenStreamBuilder` with the scanner.
          * - Builds the token stream using the `TokenStreamBuilder`.
@@ -124,18 +188,117 @@ namespace TINY::SCANNER
          */
         void runFileMode();
 
+        /**
+         * @brief Runs the application in stream mode.
+         *
+         * This function scans the input file one fixed-size buffer at a time with a `StreamScanner`,
+         * so memory use does not grow with the file size. Each token is written to the output file
+         * and printed to the console as soon as it is scanned, and unknown tokens are reported in
+         * batches of `Diagnostics::BATCH_SIZE`.
+         *
+         * @throws std::invalid_argument If the input file is empty.
+         * @throws std::runtime_error If no tokens are generated, or after `--max-errors` unknown tokens.
+         */
+        void runStreamMode();
+
+        /**
+         * @brief Runs the application in pipe mode.
+         *
+         * This function reads the source from the standard input (or the input file) with a
+         * `StreamScanner` and writes the tokens to the standard output (or the output file) as
+         * each chunk is scanned, so it can sit in the middle of a shell pipeline. Reads return
+         * whatever the pipe holds, up to `streamBufferSize` bytes, and the tokens of every chunk
+         * are flushed before the next read, so memory stays bounded and latency low.
+         *
+         * Text output has the format of the output file. Binary output to the standard output
+         * uses the token pipe format, which unlike the token file needs no seeking; a binary
+         * output file is a regular token file. Nothing but tokens is printed to the standard
+         * output, and unknown tokens are reported on the standard error stream after each chunk.
+         *
+         * @throws std::invalid_argument If the input is empty.
+         * @throws std::runtime_error If no tokens are generated, or after `--max-errors` unknown tokens.
+         *
+         * @see TokenPipeWriter
+         */
+        void runPipeMode();
+
+        /**
+         * @brief Runs the application as a scan server until interrupted.
+         *
+         * This function listens on the Unix socket `serveSocketPath` and answers scan requests
+         * on `jobs` worker threads (all hardware threads unless -j is given). SIGINT and SIGTERM
+         * stop the server, which finishes the requests in progress and removes the socket file.
+         *
+         * @throws std::invalid_argument If the socket path is invalid.
+         * @throws std::runtime_error If another server listens on the socket or it cannot be created.
+         *
+         * @see ScanServer
+         */
+        void runServeMode();
+
+        /**
+         * @brief Runs the application in batch mode.
+         *
+         * This function tokenizes every file matching `batchPattern` on a thread pool of `jobs`
+         * threads, writes the tokens of each file below the output directory, and prints one
+         * report with the totals, the failed files and the slowest files.
+         *
+         * @throws std::invalid_argument If no file matches the pattern.
+         * @throws std::runtime_error If any of the files failed.
+         *
+         * @see BatchScanner
+         */
+        void runBatchMode();
+
+        /**
+         * @brief Prints the stats of the run to the standard error stream.
+         *
+         * The report goes to standard error so it never mixes with tokens printed to the
+         * standard output. It is a table, or one line of JSON if `statsJson` is set.
+         *
+         * @see RunStats
+         */
+        void printStats();
+
         /**
          * @brief Prints the list of tokens to the standard output.
          *
-         * This function iterates through the provided vector of tokens and prints
+         * This function iterates through the provided token stream and prints
          * each token's string representation. If the includePosition flag is set to true,
          * the position information of each token will also be included in the output.
          *
-         * @param tokens A vector containing the tokens to be printed.
+         * @param tokens The token stream to be printed.
          * @param includePosition A boolean flag indicating whether to include position
          *                        information in the token's string representation.
          */
-        void printTokens(const std::vector<Token> &tokens, bool includePosition = false);
+        void printTokens(const TokenStream &tokens, bool includePosition = false);
+
+        /**
+         * @brief Prints the green header above the tokens shown on the console.
+         */
+        void printTokensHeader();
+
+        /**
+         * @brief Sets up the writers of a streaming mode from the output options.
+         *
+         * @param outputs The writers to set up, all unset.
+         * @param output The stream the tokens are written to, or null for none.
+         * @param bufferSize Buffer size of the text and console writers.
+         */
+        void openOutputs(TokenOutputs &outputs, std::ostream *output, size_t bufferSize = TokenWriter::DEFAULT_BUFFER_SIZE);
+
+        /**
+         * @brief Makes the callback a `StreamScanner` of a streaming mode hands its tokens to.
+         *
+         * The callback counts the tokens, records the unknown ones in `diagnostics`, writing them
+         * out after the shown tokens when a batch is full, and writes every token to the outputs.
+         *
+         * @param outputs The writers of the mode; they must outlive the callback.
+         * @param tokenCount The token counter; it must outlive the callback.
+         * @return The callback.
+         * @throws std::runtime_error From the callback, if the limit set by `--max-errors` is reached.
+         */
+        StreamScanner::TokenHandler makeTokenHandler(TokenOutputs &outputs, size_t &tokenCount);
 
         /**
          * @brief Processes the tokens from the input file content.
@@ -143,22 +306,42 @@ namespace TINY::SCANNER
          * This function initializes the scanner and token stream builder, builds the token stream,
          * and optionally prints the tokens to the console or writes them to an output file.
          *
-         * @param inputFileContent The content of the input file to be processed.
+         * @param inputFileContent The content of the input file to be processed. It is borrowed
+         *                         and must stay alive until the function returns.
          * @throws std::invalid_argument If the input file content is empty.
          */
-        void processTokens(std::string &inputFileContent);
+        void processTokens(std::string_view inputFileContent);
 
         /**
          * @brief Checks for unknown tokens in the provided list of tokens and prints an error message if any are found.
          *
-         * This function iterates through the given vector of tokens and checks if any token has a type of TokenType::UNKNOWN.
-         * If an unknown token is found, it sets the console text color to red and prints an error message indicating that
-         * the input contains unexpected tokens. It also lists each unknown token along with its value, line, and column.
-         * After processing, it resets the console text color to default.
+         * This function scans the type array of the given token stream for tokens of type TokenType::UNKNOWN.
+         * Every unknown token is recorded in `diagnostics`, and the recorded errors, each with its
+         * value, line and column, are written to the error stream in red, in batches.
+         *
+         * @param tokens The token stream to be checked for unknown tokens.
+         * @throws std::runtime_error If the limit set by `--max-errors` is reached.
+         */
+        void catchUnkonwnTokens(const TokenStream &tokens);
+
+        /**
+         * @brief Records a single unknown token in `diagnostics`.
+         *
+         * Nothing is written here; the caller writes the pending errors when a batch is full,
+         * after the tokens it printed before them.
          *
-         * @param tokens A reference to a vector of TINY::SCANNER::Token objects to be checked for unknown tokens.
+         * @param value The value of the unknown token.
+         * @param line The line number of the unknown token.
+         * @param column The column number of the unknown token.
+         * @return True if a full batch of errors is pending.
+         * @throws std::runtime_error If the limit set by `--max-errors` is reached.
+         */
+        bool reportUnknownToken(std::string_view value, int line, int column);
+
+        /**
+         * @brief Writes the pending errors and the number of unknown tokens of the run.
          */
-        void catchUnkonwnTokens(std::vector<TINY::SCANNER::Token> &tokens);
+        void reportDiagnostics();
 
         /**
          * @brief Prints the help message for the scanner application.
@@ -201,6 +384,35 @@ namespace TINY::SCANNER
          * -t, --terminate-keyword <keyword>
          *     Specify a keyword that will terminate the processing.
          *
+         * -j, --jobs <n>
+         *     Tokenize the input file on n threads (0 uses all hardware threads).
+         *
+         * --stream[=<bytes>]
+         *     Scan the input file in fixed-size buffers of the given size.
+         *
+         * --format=<format>
+         *     Set the format of the output file. Valid values are 'text' and 'binary'.
+         *
+         * --batch <dir|glob>
+         *     Tokenize every matching file; -o names the output directory and -j the thread count.
+         *
+         * --stats[=<format>]
+         *     Report phase timings, throughput and peak memory. Valid formats are 'text' and 'json'.
+         *
+         * --stdin, --stdout
+         *     Read the source from the standard input or write the tokens to the standard output;
+         *     '-' as the input or output file does the same.
+         *
+         * --serve <socket>
+         *     Run as a scan server on the given Unix socket; -j sets the number of worker threads.
+         *
+         * --max-errors <n>
+         *     Stop the run after n unknown tokens (0, the default, for no limit).
+         *
+         * --max-token-length <bytes>
+         *     Reject tokens longer than this in the streaming modes (0 for no limit). The file,
+         *     -j and batch modes hold the whole input and accept tokens of any length.
+         *
          * @param argc The number of command-line arguments.
          * @param argv The array of command-line arguments.
          *
@@ -210,6 +422,60 @@ namespace TINY::SCANNER
          */
         void parseArgs(int argc, char *argv[]);
 
+        /**
+         * @brief Parses a buffer size given on the command line.
+         *
+         * @param value The option value, a positive number of bytes.
+         * @return The buffer size in bytes.
+         * @throws std::invalid_argument If the value is not a positive number.
+         */
+        static size_t parseBufferSize(const std::string &value);
+
+        /**
+         * @brief Parses a job (thread) count given on the command line.
+         *
+         * @param value The option value, a non-negative number; 0 means all hardware threads.
+         * @return The job count.
+         * @throws std::invalid_argument If the value is not a non-negative number.
+         */
+        static size_t parseJobCount(const std::string &value);
+
+        /**
+         * @brief Parses an output file format given on the command line.
+         *
+         * @param value The option value, 'text' or 'binary'.
+         * @return True for the binary token format, false for text.
+         * @throws std::invalid_argument If the value is not a known format.
+         */
+        static bool parseOutputFormat(const std::string &value);
+
+        /**
+         * @brief Parses a limit on the number of errors given on the command line.
+         *
+         * @param value The option value, a non-negative number; 0 means no limit.
+         * @return The limit.
+         * @throws std::invalid_argument If the value is not a non-negative number.
+         */
+        static size_t parseErrorLimit(const std::string &value);
+
+        /**
+         * @brief Parses a limit on the length of a token given on the command line.
+         *
+         * @param value The option value, a non-negative number of bytes; 0 means no limit.
+         * @return The limit, the largest `size_t` for none.
+         * @throws std::invalid_argument If the value is not a non-negative number.
+         */
+        static size_t parseTokenLengthLimit(const std::string &value);
+
+        /**
+         * @brief Parses a stats format given on the command line.
+         *
+         * @param value The option value, 'text' or 'json'.
+         * @return True for JSON, false for a table.
+         * @throws std::invalid_argument If the value is not a known format.
+         */
+        static bool parseStatsFormat(const std::string &value);
+
         /**
          * @brief Handles positional arguments passed to the application.
          *
@@ -234,8 +500,13 @@ namespace TINY::SCANNER
          * - If file mode is enabled, and no input file is specified, it throws an `std::invalid_argument` exception.
          * - If file mode is enabled, an input file is specified, no output file is specified, and output is not shown,
          *   it sets the output file path to "output.txt" and marks that an output file is specified.
+         * - If batch mode is enabled and no output directory is specified, it uses "output/batch".
+         * - If the input is the standard input and no output file is specified, the tokens are written
+         *   to the standard output.
          *
-         * @throws std::invalid_argument if file mode is enabled and no input file is specified.
+         * @throws std::invalid_argument if file mode is enabled and no input file is specified, or if
+         *         batch mode is combined with an input file or interactive mode, or if a standard stream
+         *         is combined with a file in its place or with batch or interactive mode.
          */
         void defaultActions();
     };
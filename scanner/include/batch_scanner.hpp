@@ -0,0 +1,168 @@
+/**
+ * @file batch_scanner.hpp
+ * @brief Defines the BatchScanner class, which tokenizes many input files in one process.
+ *
+ * The input files are given by a directory, scanned recursively, or by a glob pattern. Every
+ * file is tokenized on a work-stealing `ThreadPool` and its tokens are written to a file of
+ * its own; a `BatchReport` collects the totals, the errors and the time spent on every file.
+ */
+
+#ifndef BATCH_SCANNER_HPP
+#define BATCH_SCANNER_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @struct BatchFileResult
+     * @brief The outcome of tokenizing one file of a batch.
+     */
+    struct BatchFileResult
+    {
+        std::string inputPath;         /**< Path of the input file */
+        std::string outputPath;        /**< Path of the output file */
+        std::size_t bytes = 0;         /**< Size of the input file */
+        std::size_t tokens = 0;        /**< Number of tokens */
+        std::size_t unknownTokens = 0; /**< Number of unknown tokens */
+        double seconds = 0;            /**< Time spent on the file */
+        std::string error;             /**< Why the file failed, empty if it succeeded */
+    };
+
+    /**
+     * @struct BatchReport
+     * @brief The aggregated outcome of a batch.
+     */
+    struct BatchReport
+    {
+        std::vector<BatchFileResult> files; /**< One result per input file, in input order */
+        std::size_t threads = 0;            /**< Number of worker threads used */
+        double seconds = 0;                 /**< Wall-clock time of the whole batch */
+
+        /**
+         * @brief Gets the number of files that failed.
+         * @return The failed file count.
+         */
+        std::size_t failedFiles() const;
+
+        /**
+         * @brief Gets the total size of the input files.
+         * @return The byte count.
+         */
+        std::size_t totalBytes() const;
+
+        /**
+         * @brief Gets the total number of tokens.
+         * @return The token count.
+         */
+        std::size_t totalTokens() const;
+
+        /**
+         * @brief Gets the total number of unknown tokens.
+         * @return The unknown token count.
+         */
+        std::size_t totalUnknownTokens() const;
+
+        /**
+         * @brief Prints the totals, the errors and the slowest files.
+         *
+         * @param out The stream to print to.
+         * @param slowestCount How many of the slowest files to list.
+         */
+        void print(std::ostream &out, std::size_t slowestCount = 5) const;
+    };
+
+    /**
+     * @class BatchScanner
+     * @brief Tokenizes every file matching a directory or glob pattern.
+     *
+     * A pattern naming a directory selects every regular file below it. Otherwise the pattern
+     * is split into a base directory, its leading components without wildcards, and a relative
+     * pattern in which `*` and `?` match within one path component and `**` matches any number
+     * of components. Output files mirror the input paths relative to the base directory.
+     *
+     * Example usage:
+     * @code
+     * BatchScanner batch("examples");
+     * BatchReport report = batch.run("output/batch", 8);
+     * report.print(std::cout);
+     * @endcode
+     */
+    class BatchScanner
+    {
+    public:
+        /**
+         * @brief Collects the input files matching a pattern, sorted by path.
+         *
+         * @param pattern A directory or a glob pattern.
+         * @throws std::invalid_argument if no file matches the pattern.
+         */
+        explicit BatchScanner(const std::string &pattern);
+
+        /**
+         * @brief Gets the paths of the input files.
+         * @return The input paths, relative to the base directory.
+         */
+        const std::vector<std::filesystem::path> &getInputs() const;
+
+        /**
+         * @brief Gets the directory the input paths are relative to.
+         * @return The base directory.
+         */
+        const std::filesystem::path &getBaseDirectory() const;
+
+        /**
+         * @brief Tokenizes every input file and writes its tokens to the output directory.
+         *
+         * The output file of `dir/a.tny` is `<outputDirectory>/dir/a.tny.tokens`, or
+         * `a.tny.tokens.bin` in the binary token format. A failing file is recorded in the
+         * report and does not stop the others.
+         *
+         * @param outputDirectory The directory to write the output files to.
+         * @param jobs Number of worker threads, 0 for one per hardware thread.
+         * @param includePosition Whether to include token positions in text output.
+         * @param binaryOutput Whether to write the binary token format.
+         * @return The report of the batch.
+         */
+        BatchReport run(const std::string &outputDirectory, std::size_t jobs, bool includePosition = false,
+                        bool binaryOutput = false) const;
+
+        /**
+         * @brief Checks whether a relative path matches a glob pattern.
+         *
+         * @param pattern The pattern, with `/` separating components.
+         * @param path The path, with `/` separating components.
+         * @return True if the whole path matches.
+         */
+        static bool matchPattern(std::string_view pattern, std::string_view path);
+
+    private:
+        std::filesystem::path baseDirectory;       /**< Directory the inputs are relative to */
+        std::vector<std::filesystem::path> inputs; /**< Input paths relative to the base directory */
+
+        /**
+         * @brief Tokenizes one file and writes its output.
+         *
+         * @param result The result to fill in; `inputPath` and `outputPath` must be set.
+         * @param includePosition Whether to include token positions in text output.
+         * @param binaryOutput Whether to write the binary token format.
+         */
+        static void scanFile(BatchFileResult &result, bool includePosition, bool binaryOutput);
+    };
+} // namespace TINY::SCANNER
+
+#endif // BATCH_SCANNER_HPP
@@ -0,0 +1,135 @@
+/**
+ * @file diagnostics.hpp
+ * @brief Defines the Diagnostics class, which collects the unexpected tokens of a run and reports them in batches.
+ *
+ * Reporting every unexpected token with its own formatted, flushed line makes a malformed
+ * input cost one system call per error. Instead, errors are recorded as small fixed-size
+ * records (their values copied into one shared pool, since a streamed token's value does not
+ * outlive its callback), and are formatted together into one buffer that is handed to the
+ * error stream in a single write. An optional limit stops the collection after a number of
+ * errors, so a run over garbage can be abandoned early.
+ */
+
+#ifndef DIAGNOSTICS_HPP
+#define DIAGNOSTICS_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @class Diagnostics
+     * @brief Records unexpected tokens and prints them in buffered batches, up to an optional limit.
+     *
+     * The first batch starts with a header line, every error is one line, and the summary
+     * gives the number of errors and whether the limit stopped the run.
+     *
+     * Example usage:
+     * @code
+     * Diagnostics diagnostics(100);
+     * while (...)
+     * {
+     *     if (diagnostics.report(value, line, column))
+     *         break; // the limit is reached
+     * }
+     * diagnostics.flush(std::cerr);
+     * diagnostics.printSummary(std::cerr);
+     * @endcode
+     */
+    class Diagnostics
+    {
+    public:
+        /**
+         * @brief Number of pending errors at which `isBatchFull()` asks for a flush.
+         */
+        static constexpr std::size_t BATCH_SIZE = 4096;
+
+        /**
+         * @brief Constructs an empty collector.
+         * @param maxErrors Number of errors after which the collection stops, 0 for no limit.
+         */
+        explicit Diagnostics(std::size_t maxErrors = 0);
+
+        /**
+         * @brief Records an unexpected token.
+         *
+         * Once the limit is reached further errors are not recorded.
+         *
+         * @param value The value of the token; it is copied, so it may be a transient view.
+         * @param line The line number of the token.
+         * @param column The column number of the token.
+         * @return True if the limit is reached, so the caller should stop scanning.
+         */
+        bool report(std::string_view value, int line, int column);
+
+        /**
+         * @brief Formats the pending errors into one block and writes it to a stream.
+         *
+         * The first block written starts with the header of the error list. Pending errors are
+         * dropped afterwards; the count is kept for the summary. Nothing is written if no error
+         * is pending.
+         *
+         * @param out The stream to write to.
+         */
+        void flush(std::ostream &out);
+
+        /**
+         * @brief Writes the number of errors, and whether the limit was reached, if there were any.
+         * @param out The stream to write to.
+         */
+        void printSummary(std::ostream &out) const;
+
+        /**
+         * @brief Gets the number of errors recorded so far, written or not.
+         * @return The error count.
+         */
+        std::size_t count() const;
+
+        /**
+         * @brief Checks whether enough errors are pending to be worth a write.
+         * @return True if at least `BATCH_SIZE` errors are pending.
+         */
+        bool isBatchFull() const;
+
+        /**
+         * @brief Checks whether the limit on the number of errors is reached.
+         * @return True if a limit is set and that many errors were recorded.
+         */
+        bool limitReached() const;
+
+    private:
+        /**
+         * @struct Record
+         * @brief One pending error, its value is a slice of the pool.
+         */
+        struct Record
+        {
+            std::size_t valueOffset; /**< Start of the value in the pool */
+            std::size_t valueLength; /**< Length of the value */
+            int line;                /**< Line number of the token */
+            int column;              /**< Column number of the token */
+        };
+
+        std::size_t maxErrors;       /**< Limit on the number of errors, 0 for none */
+        std::size_t errorCount = 0;  /**< Errors recorded so far */
+        bool headerWritten = false;  /**< Whether the header of the list was written */
+        std::vector<Record> pending; /**< Errors not written yet */
+        std::string values;          /**< The values of the pending errors, back to back */
+        std::string text;            /**< Reused buffer the batch is formatted into */
+    };
+} // namespace TINY::SCANNER
+
+#endif // DIAGNOSTICS_HPP
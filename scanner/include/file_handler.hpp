@@ -17,7 +17,11 @@
 #include <string>
 #include <vector>
 
+#include "mapped_file.hpp"
 #include "token.hpp"
+#include "token_file.hpp"
+#include "token_stream.hpp"
+#include "token_writer.hpp"
 
 /**
  * @namespace TINY::SCANNER
@@ -52,6 +56,20 @@ namespace TINY::SCANNER
          */
         static std::string readFile(const std::string &filePath);
 
+        /**
+         * @brief Maps the content of a file into memory without copying it.
+         *
+         * This method performs the same validation as `readFile`, but instead of reading the file
+         * into a string it returns a read-only memory mapping of it. The scanner can tokenize the
+         * mapped content in place, which avoids holding a second copy of large input files.
+         *
+         * @param filePath Path to the file to be mapped.
+         * @return A `MappedFile` owning the mapping; its `view()` stays valid while it is alive.
+         * @throws std::invalid_argument if the path is empty or the file does not exist.
+         * @throws std::runtime_error if the file cannot be opened or mapped.
+         */
+        static MappedFile mapFile(const std::string &filePath);
+
         /**
          * @brief Writes a vector of tokens to a file, each token on a new line.
          *
@@ -61,10 +79,33 @@ namespace TINY::SCANNER
          * @param filePath Path to the file to be written.
          * @param tokens A vector of `Token` objects to write to the file.
          * @param includePosition Whether to include token position in the output (default is false).
-         * @throws std::runtime_error if the file cannot be opened.
+         * @throws std::runtime_error if the file cannot be opened or written.
          */
         static void writeTokens(const std::string &filePath, const std::vector<Token> &tokens, bool includePosition = false);
 
+        /**
+         * @brief Writes a token stream to a file, each token on a new line.
+         *
+         * The output is the same as for a vector holding the same tokens.
+         *
+         * @param filePath Path to the file to be written.
+         * @param tokens The token stream to write to the file; its source must still be alive.
+         * @param includePosition Whether to include token position in the output (default is false).
+         * @throws std::runtime_error if the file cannot be opened or written.
+         */
+        static void writeTokens(const std::string &filePath, const TokenStream &tokens, bool includePosition = false);
+
+        /**
+         * @brief Writes a token stream to a file in the binary token format.
+         *
+         * @param filePath Path to the file to be written.
+         * @param tokens The token stream to write to the file; its source must still be alive.
+         * @throws std::runtime_error if the file cannot be opened or written.
+         *
+         * @see TokenFileWriter
+         */
+        static void writeBinaryTokens(const std::string &filePath, const TokenStream &tokens);
+
         /**
          * @brief Writes a string to a file.
          *
@@ -76,6 +117,47 @@ namespace TINY::SCANNER
          * @throws std::runtime_error if the file cannot be opened.
          */
         static void writeFile(const std::string &filePath, const std::string &content);
+
+        /**
+         * @brief Opens a file for reading in binary mode.
+         *
+         * This method performs the same validation as `readFile`, but returns the open stream so
+         * the caller can read the file incrementally instead of loading it whole.
+         *
+         * @param filePath Path to the file to be read.
+         * @return The open input stream.
+         * @throws std::invalid_argument if the path is empty or the file does not exist.
+         * @throws std::runtime_error if the file cannot be opened.
+         */
+        static std::ifstream openInputFile(const std::string &filePath);
+
+        /**
+         * @brief Opens a file for writing, creating its parent directories if needed.
+         *
+         * This method performs the same validation as `writeFile`, but returns the open stream so
+         * the caller can write the content incrementally.
+         *
+         * @param filePath Path to the file to be written.
+         * @param binary Whether to open the file in binary mode (no newline translation).
+         * @return The open output stream.
+         * @throws std::invalid_argument if the path is empty or is a directory.
+         * @throws std::runtime_error if the file cannot be opened.
+         */
+        static std::ofstream openOutputFile(const std::string &filePath, bool binary = false);
+
+        /**
+         * @brief Reads the next bytes of the standard input, without waiting for the buffer to fill.
+         *
+         * On POSIX systems the call returns as soon as any bytes are available, so a program
+         * at the end of a pipe sees each write of the program before it right away. Elsewhere
+         * it falls back to `std::cin`, which waits for a full buffer or the end of input.
+         *
+         * @param buffer The buffer to read into.
+         * @param size The size of the buffer in bytes.
+         * @return The number of bytes read, 0 at the end of input.
+         * @throws std::runtime_error if reading fails.
+         */
+        static std::size_t readStandardInput(char *buffer, std::size_t size);
     };
 } // namespace TINY::SCANNER
 
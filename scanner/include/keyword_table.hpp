@@ -0,0 +1,193 @@
+/**
+ * @file keyword_table.hpp
+ * @brief Defines the compile-time perfect hash used to recognize TINY keywords.
+ *
+ * A word is hashed from its length and its first and last characters. The hash seed
+ * is searched for at compile time so that the seven keywords land in distinct slots,
+ * which lets the scanner classify any word with one table probe and one comparison.
+ */
+
+#ifndef KEYWORD_TABLE_HPP
+#define KEYWORD_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include "token.hpp"
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @namespace TINY::SCANNER::KEYWORDS
+     * @brief The keyword list and its perfect hash table.
+     */
+    namespace KEYWORDS
+    {
+
+        /**
+         * @struct Keyword
+         * @brief A reserved word and the token type it produces.
+         */
+        struct Keyword
+        {
+            std::string_view spelling; /**< The keyword as written in the source */
+            TokenType type;            /**< The token type of the keyword */
+        };
+
+        /**
+         * @brief The reserved words of the TINY language.
+         */
+        inline constexpr std::array<Keyword, 7> keywords = {{
+            {"if", TokenType::IF},
+            {"then", TokenType::THEN},
+            {"end", TokenType::END},
+            {"repeat", TokenType::REPEAT},
+            {"until", TokenType::UNTIL},
+            {"read", TokenType::READ},
+            {"write", TokenType::WRITE},
+        }};
+
+        /**
+         * @brief Number of slots in the hash table, a power of two.
+         */
+        inline constexpr std::size_t TABLE_SIZE = 16;
+
+        /**
+         * @brief Hashes a non-empty word from its length and its first and last characters.
+         *
+         * @param word The word to hash.
+         * @param seed The multiplier applied to the length.
+         * @return The slot of the word in the hash table.
+         */
+        constexpr std::size_t hash(std::string_view word, std::size_t seed)
+        {
+            return (static_cast<unsigned char>(word.front()) +
+                    static_cast<unsigned char>(word.back()) +
+                    seed * word.size()) &
+                   (TABLE_SIZE - 1);
+        }
+
+        /**
+         * @brief Checks whether a seed maps every keyword to its own slot.
+         * @param seed The seed to check.
+         * @return True if no two keywords share a slot, false otherwise.
+         */
+        constexpr bool isPerfect(std::size_t seed)
+        {
+            std::array<bool, TABLE_SIZE> used{};
+            for (const Keyword &keyword : keywords)
+            {
+                std::size_t slot = hash(keyword.spelling, seed);
+                if (used[slot])
+                {
+                    return false;
+                }
+                used[slot] = true;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Searches for the smallest seed that makes the hash perfect.
+         * @return The seed, or TABLE_SIZE if there is none.
+         */
+        constexpr std::size_t findSeed()
+        {
+            for (std::size_t seed = 0; seed < TABLE_SIZE; ++seed)
+            {
+                if (isPerfect(seed))
+                {
+                    return seed;
+                }
+            }
+            return TABLE_SIZE;
+        }
+
+        /**
+         * @brief The seed of the perfect hash, found at compile time.
+         */
+        inline constexpr std::size_t SEED = findSeed();
+        static_assert(SEED < TABLE_SIZE, "no perfect hash seed for the keyword list, grow TABLE_SIZE");
+
+        /**
+         * @brief Builds the hash table, with an empty spelling in the unused slots.
+         * @return The hash table.
+         */
+        constexpr std::array<Keyword, TABLE_SIZE> makeTable()
+        {
+            std::array<Keyword, TABLE_SIZE> table{};
+            for (Keyword &slot : table)
+            {
+                slot = {std::string_view(), TokenType::IDENTIFIER};
+            }
+            for (const Keyword &keyword : keywords)
+            {
+                table[hash(keyword.spelling, SEED)] = keyword;
+            }
+            return table;
+        }
+
+        /**
+         * @brief The keywords placed at their hash slots.
+         */
+        inline constexpr std::array<Keyword, TABLE_SIZE> table = makeTable();
+
+        /**
+         * @brief Gets the length of the shortest or the longest keyword.
+         * @param longest True for the longest keyword, false for the shortest.
+         * @return The keyword length.
+         */
+        constexpr std::size_t keywordLength(bool longest)
+        {
+            std::size_t length = keywords[0].spelling.size();
+            for (const Keyword &keyword : keywords)
+            {
+                std::size_t size = keyword.spelling.size();
+                length = (longest ? size > length : size < length) ? size : length;
+            }
+            return length;
+        }
+
+        /**
+         * @brief Length of the shortest keyword, shorter words are never keywords.
+         */
+        inline constexpr std::size_t MIN_LENGTH = keywordLength(false);
+
+        /**
+         * @brief Length of the longest keyword, longer words are never keywords.
+         */
+        inline constexpr std::size_t MAX_LENGTH = keywordLength(true);
+
+        /**
+         * @brief Classifies a word as a keyword or an identifier.
+         *
+         * @param word The word to classify, a run of letters taken straight from the input.
+         * @return The keyword's token type, or `TokenType::IDENTIFIER` if the word is not a keyword.
+         */
+        constexpr TokenType lookup(std::string_view word)
+        {
+            if (word.size() < MIN_LENGTH || word.size() > MAX_LENGTH)
+            {
+                return TokenType::IDENTIFIER;
+            }
+            const Keyword &slot = table[hash(word, SEED)];
+            return slot.spelling == word ? slot.type : TokenType::IDENTIFIER;
+        }
+
+        static_assert(lookup("repeat") == TokenType::REPEAT && lookup("x") == TokenType::IDENTIFIER &&
+                          lookup("End") == TokenType::IDENTIFIER,
+                      "keyword lookup is broken");
+    } // namespace KEYWORDS
+} // namespace TINY::SCANNER
+
+#endif // KEYWORD_TABLE_HPP
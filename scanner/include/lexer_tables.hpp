@@ -0,0 +1,248 @@
+/**
+ * @file lexer_tables.hpp
+ * @brief Defines the compile-time tables that drive the Scanner's DFA.
+ *
+ * The scanner classifies every input byte through a 256-entry character-class table
+ * and recognizes tokens with a small transition table over those classes. Both tables
+ * are generated at compile time and do not depend on the C locale.
+ */
+
+#ifndef LEXER_TABLES_HPP
+#define LEXER_TABLES_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "keyword_table.hpp"
+#include "token.hpp"
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @namespace TINY::SCANNER::LEXER
+     * @brief Character classes, DFA states and the tables connecting them.
+     */
+    namespace LEXER
+    {
+
+        /**
+         * @enum CharClass
+         * @brief Classes of input bytes the DFA distinguishes between.
+         */
+        enum CharClass : std::uint8_t
+        {
+            LETTER,      /**< 'a'-'z' and 'A'-'Z' */
+            DIGIT,       /**< '0'-'9' */
+            COLON,       /**< ':' */
+            EQUALS,      /**< '=' */
+            OPERATOR,    /**< Single-character tokens: + - * / ( ) ; < */
+            SPACE,       /**< ' ', '\t', '\v', '\f', '\r' */
+            NEWLINE,     /**< '\n' */
+            OPEN_BRACE,  /**< '{', starts a comment */
+            OTHER,       /**< Anything else, including '}' and bytes >= 0x80 */
+            END_OF_DATA, /**< Virtual class used past the end of the input */
+            CLASS_COUNT  /**< Number of character classes */
+        };
+
+        /**
+         * @enum State
+         * @brief DFA states. States from `FIRST_FINAL` on end the token.
+         *
+         * A final state tells the scanner which token was recognized and whether the
+         * byte that led to it belongs to the token (see `consumesLastByte`).
+         */
+        enum State : std::uint8_t
+        {
+            START,       /**< No byte of the token consumed yet */
+            IN_IDENT,    /**< Inside an identifier or keyword */
+            IN_NUMBER,   /**< Inside a number literal */
+            AFTER_COLON, /**< After ':', waiting for '=' */
+            FIRST_FINAL, /**< Marker, not a state */
+            EMIT_IDENT = FIRST_FINAL, /**< Identifier or keyword ended before the current byte */
+            EMIT_NUMBER,              /**< Number ended before the current byte */
+            EMIT_ASSIGN,              /**< ":=" ended with the current byte */
+            EMIT_COLON,               /**< Lone ':' ended before the current byte */
+            EMIT_OPERATOR,            /**< Single-character token is the current byte */
+            EMIT_UNKNOWN,             /**< Unknown single character is the current byte */
+            STATE_COUNT               /**< Number of states */
+        };
+
+        /**
+         * @brief Builds the 256-entry character-class table.
+         * @return The class of every byte value.
+         */
+        constexpr std::array<CharClass, 256> makeCharClasses()
+        {
+            std::array<CharClass, 256> classes{};
+            for (std::size_t c = 0; c < classes.size(); ++c)
+            {
+                classes[c] = OTHER;
+            }
+            for (std::size_t c = 'a'; c <= 'z'; ++c)
+            {
+                classes[c] = LETTER;
+                classes[c - 'a' + 'A'] = LETTER;
+            }
+            for (std::size_t c = '0'; c <= '9'; ++c)
+            {
+                classes[c] = DIGIT;
+            }
+            for (unsigned char c : {'+', '-', '*', '/', '(', ')', ';', '<'})
+            {
+                classes[c] = OPERATOR;
+            }
+            for (unsigned char c : {' ', '\t', '\v', '\f', '\r'})
+            {
+                classes[c] = SPACE;
+            }
+            classes[static_cast<unsigned char>('\n')] = NEWLINE;
+            classes[static_cast<unsigned char>(':')] = COLON;
+            classes[static_cast<unsigned char>('=')] = EQUALS;
+            classes[static_cast<unsigned char>('{')] = OPEN_BRACE;
+            return classes;
+        }
+
+        /**
+         * @brief Builds the DFA transition table, indexed by [state][character class].
+         * @return The transition table for the non-final states.
+         */
+        constexpr std::array<std::array<State, CLASS_COUNT>, FIRST_FINAL> makeTransitions()
+        {
+            std::array<std::array<State, CLASS_COUNT>, FIRST_FINAL> table{};
+
+            // START: the first byte decides the kind of token
+            for (std::size_t c = 0; c < CLASS_COUNT; ++c)
+            {
+                table[START][c] = EMIT_UNKNOWN;
+            }
+            table[START][LETTER] = IN_IDENT;
+            table[START][DIGIT] = IN_NUMBER;
+            table[START][COLON] = AFTER_COLON;
+            table[START][EQUALS] = EMIT_OPERATOR;
+            table[START][OPERATOR] = EMIT_OPERATOR;
+
+            // Identifiers, numbers and ':' end at the first byte that cannot extend them
+            for (std::size_t c = 0; c < CLASS_COUNT; ++c)
+            {
+                table[IN_IDENT][c] = EMIT_IDENT;
+                table[IN_NUMBER][c] = EMIT_NUMBER;
+                table[AFTER_COLON][c] = EMIT_COLON;
+            }
+            table[IN_IDENT][LETTER] = IN_IDENT;
+            table[IN_NUMBER][DIGIT] = IN_NUMBER;
+            table[AFTER_COLON][EQUALS] = EMIT_ASSIGN;
+
+            return table;
+        }
+
+        /**
+         * @brief Builds the token types of the single-character operator bytes.
+         * @return The token type of every byte, `UNKNOWN` for bytes that are not operators.
+         */
+        constexpr std::array<TokenType, 256> makeOperatorTypes()
+        {
+            std::array<TokenType, 256> types{};
+            for (std::size_t c = 0; c < types.size(); ++c)
+            {
+                types[c] = TokenType::UNKNOWN;
+            }
+            types[static_cast<unsigned char>('+')] = TokenType::PLUS;
+            types[static_cast<unsigned char>('-')] = TokenType::MINUS;
+            types[static_cast<unsigned char>('*')] = TokenType::MULT;
+            types[static_cast<unsigned char>('/')] = TokenType::DIV;
+            types[static_cast<unsigned char>('(')] = TokenType::OPENBRACKET;
+            types[static_cast<unsigned char>(')')] = TokenType::CLOSEDBRACKET;
+            types[static_cast<unsigned char>(';')] = TokenType::SEMICOLON;
+            types[static_cast<unsigned char>('<')] = TokenType::LESSTHAN;
+            types[static_cast<unsigned char>('=')] = TokenType::EQUAL;
+            return types;
+        }
+
+        /**
+         * @brief Character class of every byte value.
+         */
+        inline constexpr std::array<CharClass, 256> charClasses = makeCharClasses();
+
+        /**
+         * @brief DFA transitions of the non-final states.
+         */
+        inline constexpr std::array<std::array<State, CLASS_COUNT>, FIRST_FINAL> transitions = makeTransitions();
+
+        /**
+         * @brief Token type of every single-character operator byte.
+         */
+        inline constexpr std::array<TokenType, 256> operatorTypes = makeOperatorTypes();
+
+        /**
+         * @brief Whether the byte that led to a final state is part of the token.
+         */
+        inline constexpr std::array<bool, STATE_COUNT> consumesLastByte = {
+            false, false, false, false, // non-final states
+            false,                      // EMIT_IDENT
+            false,                      // EMIT_NUMBER
+            true,                       // EMIT_ASSIGN
+            false,                      // EMIT_COLON
+            true,                       // EMIT_OPERATOR
+            true                        // EMIT_UNKNOWN
+        };
+
+        /**
+         * @brief Gets the character class of a byte.
+         * @param c The byte to classify.
+         * @return The character class of the byte.
+         */
+        constexpr CharClass classOf(char c)
+        {
+            return charClasses[static_cast<unsigned char>(c)];
+        }
+
+        /**
+         * @brief Checks whether a byte is whitespace, matching `std::isspace` in the "C" locale.
+         * @param c The byte to check.
+         * @return True if the byte is whitespace, false otherwise.
+         */
+        constexpr bool isSpace(char c)
+        {
+            CharClass charClass = classOf(c);
+            return charClass == SPACE || charClass == NEWLINE;
+        }
+
+        /**
+         * @brief Gets the type of the token recognized in a final DFA state.
+         *
+         * @param finalState The final state the DFA stopped in.
+         * @param lexeme The bytes of the token.
+         * @return The token type; keywords are told apart from identifiers with the perfect hash.
+         */
+        constexpr TokenType tokenTypeOf(State finalState, std::string_view lexeme)
+        {
+            switch (finalState)
+            {
+            case EMIT_IDENT:
+                return KEYWORDS::lookup(lexeme);
+            case EMIT_NUMBER:
+                return TokenType::NUMBER;
+            case EMIT_ASSIGN:
+                return TokenType::ASSIGN;
+            case EMIT_OPERATOR:
+                return operatorTypes[static_cast<unsigned char>(lexeme[0])];
+            default:
+                // A lone ':' or a character that doesn't match any known token pattern
+                return TokenType::UNKNOWN;
+            }
+        }
+    } // namespace LEXER
+} // namespace TINY::SCANNER
+
+#endif // LEXER_TABLES_HPP
@@ -0,0 +1,105 @@
+/**
+ * @file line_index.hpp
+ * @brief Defines the LineIndex class, which maps source offsets to line and column numbers.
+ *
+ * Token containers only store byte offsets. The index records the offset at which every line
+ * of the source starts, once, so a position is resolved by a binary search when it is asked
+ * for instead of being counted for every token while scanning.
+ */
+
+#ifndef LINE_INDEX_HPP
+#define LINE_INDEX_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @struct SourcePosition
+     * @brief A source offset together with its line and column numbers.
+     */
+    struct SourcePosition
+    {
+        std::size_t offset = 0; /**< Offset in the source, in bytes */
+        int line = 1;           /**< Line number at the offset, from 1 */
+        int column = 1;         /**< Column number at the offset, from 1 */
+    };
+
+    /**
+     * @class LineIndex
+     * @brief The start offsets of the lines of a source, for resolving offsets to positions.
+     *
+     * The index covers the source from an origin on; positions before the origin are not
+     * defined. The newlines are counted with `SIMD::countNewlines` to size the table, which
+     * is then filled in one pass.
+     *
+     * Example usage:
+     * @code
+     * LineIndex index(source);
+     * SourcePosition position = index.locate(offset);
+     * @endcode
+     */
+    class LineIndex
+    {
+    public:
+        /**
+         * @brief Indexes the lines of a source.
+         *
+         * @param source The source to index; only its newlines are read, it is not kept.
+         * @param origin The first offset covered and its line and column, the start of the source by default.
+         */
+        explicit LineIndex(std::string_view source, SourcePosition origin = SourcePosition());
+
+        /**
+         * @brief Resolves an offset with a binary search over the line starts.
+         *
+         * @param offset An offset at or after the origin, at most the size of the source.
+         * @return The offset with its line and column numbers.
+         */
+        SourcePosition locate(std::size_t offset) const;
+
+        /**
+         * @brief Resolves an offset, starting from the line found by the previous call.
+         *
+         * Walking the lines forward from `hint` is cheaper than a binary search when the offsets
+         * are resolved in increasing order, as when every token of a stream is written out.
+         *
+         * @param offset An offset at or after the origin, at most the size of the source.
+         * @param hint The line found by the previous call, 0 before the first call; it is updated.
+         * @return The offset with its line and column numbers.
+         */
+        SourcePosition locate(std::size_t offset, std::size_t &hint) const;
+
+        /**
+         * @brief Gets the number of newlines after the origin.
+         * @return The newline count.
+         */
+        std::size_t newlineCount() const;
+
+    private:
+        SourcePosition origin;               /**< The first offset covered and its position */
+        std::vector<std::size_t> lineStarts; /**< Offset just after every newline at or after the origin */
+
+        /**
+         * @brief Builds the position of an offset on a known line.
+         *
+         * @param offset The offset.
+         * @param line The number of line starts at or before the offset.
+         * @return The offset with its line and column numbers.
+         */
+        SourcePosition positionOn(std::size_t offset, std::size_t line) const;
+    };
+} // namespace TINY::SCANNER
+
+#endif // LINE_INDEX_HPP
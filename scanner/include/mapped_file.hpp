@@ -0,0 +1,99 @@
+/**
+ * @file mapped_file.hpp
+ * @brief Defines the MappedFile class, a read-only memory-mapped view of a file.
+ *
+ * Mapping the input file lets the scanner tokenize it in place, without copying
+ * the file content into a `std::string` first.
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @class MappedFile
+     * @brief Owns a read-only memory mapping of a file.
+     *
+     * The mapping is released when the object is destroyed. The object is movable but
+     * not copyable, so exactly one owner unmaps the file. Empty files are represented
+     * by an empty view and do not create a mapping.
+     *
+     * @note Any `std::string_view` obtained from `view()` is only valid while the
+     *       `MappedFile` that produced it is alive.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @brief Maps the file at the given path into memory.
+         *
+         * @param filePath Path to the file to be mapped.
+         * @throws std::runtime_error if the file cannot be opened or mapped.
+         */
+        explicit MappedFile(const std::string &filePath);
+
+        /**
+         * @brief Unmaps the file.
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /**
+         * @brief Takes over the mapping of another MappedFile, leaving it empty.
+         * @param other The MappedFile to move from.
+         */
+        MappedFile(MappedFile &&other) noexcept;
+
+        /**
+         * @brief Releases the current mapping and takes over the mapping of another MappedFile.
+         * @param other The MappedFile to move from.
+         * @return A reference to this object.
+         */
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        /**
+         * @brief Gets a view over the mapped file content.
+         * @return A view over the whole file, empty if the file is empty.
+         */
+        std::string_view view() const;
+
+        /**
+         * @brief Gets the size of the mapped file in bytes.
+         * @return The file size.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Checks whether the mapped file is empty.
+         * @return True if the file has no content, false otherwise.
+         */
+        bool empty() const;
+
+    private:
+        const char *data = nullptr; /**< Start of the mapping, or nullptr for an empty file. */
+        std::size_t length = 0;     /**< Length of the mapping in bytes. */
+
+        /**
+         * @brief Unmaps the current mapping, if any, and resets the object to empty.
+         */
+        void release() noexcept;
+    };
+} // namespace TINY::SCANNER
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,172 @@
+/**
+ * @file program_generator.hpp
+ * @brief Defines the ProgramGenerator class, which writes random but syntactically valid TINY programs.
+ *
+ * The generated programs are meant as scalable workloads for benchmarks and stress tests: their
+ * size, control-flow nesting, expression length, comment density, nested-comment depth and
+ * identifier vocabulary are all set by `GeneratorOptions`, and the same seed always gives the
+ * same program.
+ */
+
+#ifndef PROGRAM_GENERATOR_HPP
+#define PROGRAM_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @struct GeneratorOptions
+     * @brief The knobs of a generated program.
+     */
+    struct GeneratorOptions
+    {
+        std::size_t size = 64 * 1024;        /**< Minimum size of the program in bytes */
+        std::size_t maxNestingDepth = 3;     /**< Maximum nesting of `if` and `repeat` statements */
+        std::size_t maxExpressionLength = 4; /**< Maximum number of operators in an expression */
+        double commentDensity = 0.1;         /**< Probability of a comment before a statement, from 0 to 1 */
+        std::size_t maxCommentDepth = 1;     /**< Maximum nesting of comments, 0 for no comments */
+        std::size_t vocabularySize = 26;     /**< Number of distinct identifiers */
+        std::uint64_t seed = 1;              /**< Seed of the random number generator */
+    };
+
+    /**
+     * @class ProgramGenerator
+     * @brief Writes TINY programs following the grammar of the language.
+     *
+     * A program is a sequence of top-level statements, separated by semicolons and indented by
+     * nesting depth, that is cut off at the first statement boundary after `size` bytes. The
+     * random numbers come from `std::mt19937_64`, whose output the standard fixes, so a seed
+     * gives the same program with every compiler.
+     *
+     * Example usage:
+     * @code
+     * GeneratorOptions options;
+     * options.size = 1 << 20;
+     * options.seed = 42;
+     * std::string program = ProgramGenerator(options).generate();
+     * @endcode
+     */
+    class ProgramGenerator
+    {
+    public:
+        /**
+         * @brief Constructs a generator.
+         *
+         * @param options The knobs of the generated programs.
+         * @throws std::invalid_argument if the comment density is outside [0, 1] or the vocabulary is empty.
+         */
+        explicit ProgramGenerator(const GeneratorOptions &options);
+
+        /**
+         * @brief Generates a program.
+         * @return The program, at least `size` bytes long.
+         */
+        std::string generate();
+
+        /**
+         * @brief Generates a program into a stream, in chunks, without holding it in memory.
+         *
+         * @param out The stream to write to.
+         * @throws std::runtime_error if writing to the stream fails.
+         */
+        void generate(std::ostream &out);
+
+        /**
+         * @brief Gets the identifiers the programs are written with.
+         * @return The vocabulary, `vocabularySize` names that are not keywords.
+         */
+        const std::vector<std::string> &getVocabulary() const;
+
+    private:
+        GeneratorOptions options;            /**< The knobs of the generated programs */
+        std::mt19937_64 random;              /**< Source of all random choices */
+        std::vector<std::string> vocabulary; /**< The identifiers */
+
+        /**
+         * @brief Appends one top-level statement with the separator before it, if any.
+         *
+         * @param out The text to append to.
+         * @param first Whether this is the first statement of the program.
+         */
+        void appendTopLevelStatement(std::string &out, bool first);
+
+        /**
+         * @brief Appends a sequence of one or more statements, separated by semicolons.
+         *
+         * @param out The text to append to.
+         * @param depth The nesting depth of the sequence.
+         */
+        void appendStatementSequence(std::string &out, std::size_t depth);
+
+        /**
+         * @brief Appends one statement, possibly preceded by a comment, without a separator.
+         *
+         * @param out The text to append to.
+         * @param depth The nesting depth of the statement.
+         */
+        void appendStatement(std::string &out, std::size_t depth);
+
+        /**
+         * @brief Appends a comparison, the condition of an `if` or `until`.
+         * @param out The text to append to.
+         */
+        void appendCondition(std::string &out);
+
+        /**
+         * @brief Appends an arithmetic expression with exactly the given number of operators.
+         *
+         * @param out The text to append to.
+         * @param operators The number of operators.
+         */
+        void appendExpression(std::string &out, std::size_t operators);
+
+        /**
+         * @brief Appends a comment, nested to at most the given depth.
+         *
+         * @param out The text to append to.
+         * @param depth The maximum nesting depth, at least 1.
+         */
+        void appendComment(std::string &out, std::size_t depth);
+
+        /**
+         * @brief Appends the indentation of a nesting depth.
+         *
+         * @param out The text to append to.
+         * @param depth The nesting depth.
+         */
+        static void appendIndentation(std::string &out, std::size_t depth);
+
+        /**
+         * @brief Draws a number below a bound.
+         *
+         * @param bound The exclusive upper bound, at least 1.
+         * @return A number in [0, bound).
+         */
+        std::size_t below(std::size_t bound);
+
+        /**
+         * @brief Draws a yes-or-no decision.
+         *
+         * @param probability The probability of yes, from 0 to 1.
+         * @return True with the given probability.
+         */
+        bool chance(double probability);
+    };
+} // namespace TINY::SCANNER
+
+#endif // PROGRAM_GENERATOR_HPP
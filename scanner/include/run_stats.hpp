@@ -0,0 +1,129 @@
+/**
+ * @file run_stats.hpp
+ * @brief Defines the RunStats class, which collects the phase timings of a scanner run.
+ *
+ * A run is split into phases (reading the input, scanning it, checking for unknown tokens,
+ * writing the output). Every phase records its wall time together with the bytes and tokens
+ * it handled, so the report can give the throughput of each phase, and the process's peak
+ * resident set size is read when the report is printed.
+ */
+
+#ifndef RUN_STATS_HPP
+#define RUN_STATS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @struct PhaseStats
+     * @brief The wall time and the work of one phase of a run.
+     */
+    struct PhaseStats
+    {
+        std::string name;       /**< Name of the phase */
+        double seconds = 0;     /**< Wall time of the phase */
+        std::size_t bytes = 0;  /**< Input bytes handled by the phase, 0 if it does not apply */
+        std::size_t tokens = 0; /**< Tokens handled by the phase, 0 if it does not apply */
+    };
+
+    /**
+     * @class RunStats
+     * @brief Collects the phases of a run and prints them as a table or as JSON.
+     *
+     * Example usage:
+     * @code
+     * RunStats stats;
+     * auto start = RunStats::Clock::now();
+     * builder.build();
+     * stats.addPhase("scan", start, input.size(), builder.getTokens().size());
+     * stats.printJson(std::cerr);
+     * @endcode
+     */
+    class RunStats
+    {
+    public:
+        /** The clock all phases are measured with. */
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Starts the wall clock of the whole run.
+         */
+        RunStats();
+
+        /**
+         * @brief Records a phase that started at `start` and ends now.
+         *
+         * @param name The name of the phase.
+         * @param start When the phase started.
+         * @param bytes The input bytes the phase handled, 0 if it does not apply.
+         * @param tokens The tokens the phase handled, 0 if it does not apply.
+         */
+        void addPhase(const std::string &name, Clock::time_point start, std::size_t bytes, std::size_t tokens);
+
+        /**
+         * @brief Sets the size of the input and the number of tokens of the run.
+         *
+         * @param bytes The input size in bytes.
+         * @param tokens The token count.
+         */
+        void setTotals(std::size_t bytes, std::size_t tokens);
+
+        /**
+         * @brief Gets the recorded phases.
+         * @return The phases, in the order they were recorded.
+         */
+        const std::vector<PhaseStats> &getPhases() const;
+
+        /**
+         * @brief Gets the wall time since the run started.
+         * @return The elapsed time in seconds.
+         */
+        double elapsedSeconds() const;
+
+        /**
+         * @brief Prints the phases, the totals and the peak resident set size as a table.
+         * @param out The stream to print to.
+         */
+        void print(std::ostream &out) const;
+
+        /**
+         * @brief Prints the same report as one JSON object on one line.
+         *
+         * The object has the keys `input_bytes`, `tokens`, `wall_seconds`, `peak_rss_bytes`
+         * (null where it cannot be measured) and `phases`, an array of objects with `name`,
+         * `seconds`, `bytes`, `tokens`, `bytes_per_second` and `tokens_per_second`.
+         *
+         * @param out The stream to print to.
+         */
+        void printJson(std::ostream &out) const;
+
+        /**
+         * @brief Gets the peak resident set size of the process so far.
+         * @return The size in bytes, or nothing where `getrusage` is not available.
+         */
+        static std::optional<std::size_t> peakResidentBytes();
+
+    private:
+        Clock::time_point start;        /**< When the run started */
+        std::vector<PhaseStats> phases; /**< The phases, in order */
+        std::size_t inputBytes = 0;     /**< Size of the input */
+        std::size_t tokenCount = 0;     /**< Number of tokens */
+    };
+} // namespace TINY::SCANNER
+
+#endif // RUN_STATS_HPP
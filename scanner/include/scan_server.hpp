@@ -0,0 +1,346 @@
+/**
+ * @file scan_server.hpp
+ * @brief Defines the ScanServer, a long-running scanner that answers requests on a Unix socket, and its client.
+ *
+ * Starting a process and opening a file can cost more than scanning a small file. The server
+ * is started once (`scanner --serve /path/to.sock`) and then tokenizes any number of sources
+ * sent to it over a Unix domain socket. Every message is length-prefixed. The headers are sent
+ * as they are laid out in memory, integers in host byte order: a Unix domain socket only
+ * connects processes of one host, so client and server always agree on it.
+ *
+ * | Message  | Content                                                                  |
+ * |----------|--------------------------------------------------------------------------|
+ * | Request  | `ScanRequestHeader`, then `length` bytes: the source, or a file path       |
+ * | Response | `ScanResponseHeader`, then `length` bytes: the tokens, or an error message |
+ *
+ * The tokens are in the text output format (with or without positions) or in the token pipe
+ * format (token_pipe.hpp). A client may send any number of requests on one connection; they
+ * are answered in order, and the connection ends when the client closes it.
+ *
+ * Unix domain sockets are only available on POSIX systems; elsewhere starting a server or a
+ * client throws `std::runtime_error`.
+ */
+
+#ifndef SCAN_SERVER_HPP
+#define SCAN_SERVER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @enum ScanRequestKind
+     * @brief What the payload of a request is.
+     */
+    enum class ScanRequestKind : std::uint8_t
+    {
+        SOURCE = 0, /**< The payload is the source code itself */
+        PATH = 1    /**< The payload is the path of a file the server reads */
+    };
+
+    /**
+     * @enum ScanFormat
+     * @brief The format of the tokens in a response.
+     */
+    enum class ScanFormat : std::uint8_t
+    {
+        TEXT = 0,                /**< One "value, TYPE" line per token */
+        TEXT_WITH_POSITIONS = 1, /**< Lines with the line and column of every token */
+        BINARY = 2               /**< The token pipe format */
+    };
+
+    /**
+     * @struct ScanRequestHeader
+     * @brief The fixed-size start of a request.
+     */
+    struct ScanRequestHeader
+    {
+        ScanRequestKind kind;   /**< What the payload is */
+        ScanFormat format;      /**< The format of the tokens to return */
+        std::uint16_t reserved; /**< Always zero */
+        std::uint32_t length;   /**< Length of the payload in bytes */
+    };
+
+    /**
+     * @struct ScanResponseHeader
+     * @brief The fixed-size start of a response.
+     */
+    struct ScanResponseHeader
+    {
+        std::uint8_t ok;          /**< 1 if the body holds tokens, 0 if it holds an error message */
+        std::uint8_t reserved[7]; /**< Always zero */
+        std::uint64_t tokenCount; /**< Number of tokens in the body, 0 on error */
+        std::uint64_t length;     /**< Length of the body in bytes */
+    };
+
+    static_assert(sizeof(ScanRequestHeader) == 8, "unexpected scan request header layout");
+    static_assert(sizeof(ScanResponseHeader) == 24, "unexpected scan response header layout");
+
+    /**
+     * @struct ScanResponse
+     * @brief A response as received by a `ScanClient`.
+     */
+    struct ScanResponse
+    {
+        bool ok = false;              /**< True if `body` holds tokens, false if it holds an error message */
+        std::uint64_t tokenCount = 0; /**< Number of tokens in the body */
+        std::string body;             /**< The tokens in the requested format, or the error message */
+    };
+
+    /**
+     * @class ScanServer
+     * @brief Answers scan requests on a Unix domain socket, tokenizing them on a thread pool.
+     *
+     * The thread running `run()` polls the listening socket and every open connection. It reads
+     * requests and writes responses without blocking, and each complete request is submitted to
+     * the pool as its own task, so a connected client holds no worker while it is idle and any
+     * number of clients share the workers. A request is tokenized with a session taken from a
+     * free list: the session's `Scanner`, `TokenStreamBuilder`, token arrays and request and
+     * response buffers are reused by every request it serves, so a steady stream of small
+     * requests allocates almost nothing. A connection's requests are answered one at a time,
+     * in order.
+     *
+     * A request's payload buffer grows as its bytes arrive, so a header alone costs nothing.
+     * The payload bytes held by all requests not yet answered are limited: a request that
+     * would go over the limit is answered with an error and its connection is closed.
+     *
+     * Example usage:
+     * @code
+     * ScanServer server("/tmp/scanner.sock", 8);
+     * server.run(); // until stop() is called
+     * @endcode
+     */
+    class ScanServer
+    {
+    public:
+        /**
+         * @brief Largest payload a request may carry, in bytes.
+         */
+        static constexpr std::uint32_t MAX_REQUEST_SIZE = 1u << 30;
+
+        /**
+         * @brief Default limit on the payload bytes held by all requests not yet answered.
+         */
+        static constexpr std::uint64_t DEFAULT_MAX_PENDING_BYTES = std::uint64_t{2} << 30;
+
+        /**
+         * @brief Creates the socket and starts listening on it.
+         *
+         * A socket file left behind by a server that is no longer running is replaced.
+         *
+         * @param socketPath The path of the socket file to create.
+         * @param threadCount Number of worker threads, 0 for one per hardware thread.
+         * @param maxPendingBytes Limit on the payload bytes held by all requests not yet answered.
+         * @throws std::invalid_argument if the path is too long or names something other than a socket.
+         * @throws std::runtime_error if another server listens on the path or the socket cannot be created.
+         */
+        ScanServer(const std::string &socketPath, std::size_t threadCount = 0,
+                   std::uint64_t maxPendingBytes = DEFAULT_MAX_PENDING_BYTES);
+
+        ScanServer(const ScanServer &) = delete;
+        ScanServer &operator=(const ScanServer &) = delete;
+
+        /**
+         * @brief Stops listening and removes the socket file.
+         */
+        ~ScanServer();
+
+        /**
+         * @brief Accepts and serves connections until `stop()` is called.
+         *
+         * Once stopped, no connection is accepted and no further request is read: connections
+         * waiting for a request are closed, the others after answering the request they are on,
+         * and the call returns when all have ended.
+         *
+         * @throws std::runtime_error if polling or accepting a connection fails.
+         */
+        void run();
+
+        /**
+         * @brief Makes `run()` return.
+         *
+         * Only an atomic store and a `write()` to the wake-up pipe, so it may be called from
+         * another thread or from a signal handler.
+         */
+        void stop();
+
+        /**
+         * @brief Gets the path of the socket file.
+         * @return The socket path.
+         */
+        const std::string &getSocketPath() const;
+
+        /**
+         * @brief Gets the number of worker threads.
+         * @return The thread count.
+         */
+        std::size_t threadCount() const;
+
+    private:
+        struct Session;
+        struct Connection;
+        using ConnectionMap = std::map<int, Connection>;
+
+        std::string socketPath;                             /**< Path of the socket file */
+        int listener = -1;                                  /**< The listening socket */
+        int wakeRead = -1;                                  /**< Read end of the pipe that wakes up `run()` */
+        int wakeWrite = -1;                                 /**< Write end of that pipe */
+        std::atomic<bool> stopping{false};                  /**< Set by `stop()` */
+        std::uint64_t maxPendingBytes;                      /**< Limit on `pendingBytes` */
+        std::uint64_t pendingBytes = 0;                     /**< Payload bytes held by requests not yet answered, event loop only */
+        ThreadPool pool;                                    /**< Tokenizes the requests */
+        std::mutex sessionMutex;                            /**< Guards the idle sessions */
+        std::vector<std::unique_ptr<Session>> idleSessions; /**< Sessions not holding a request */
+        std::mutex finishedMutex;                           /**< Guards the finished connections */
+        std::vector<int> finished;                          /**< Sockets whose response a worker has formatted */
+
+        /**
+         * @brief Accepts every pending connection.
+         * @param connections The open connections, the new ones are added.
+         * @throws std::runtime_error if accepting fails for another reason than a lack of pending connections.
+         */
+        void acceptConnections(ConnectionMap &connections);
+
+        /**
+         * @brief Reads what has arrived of a request, and submits the request once it is complete.
+         * @param connection The connection, waiting for a request.
+         * @return False if the connection ended or failed and must be closed.
+         */
+        bool receiveRequest(Connection &connection);
+
+        /**
+         * @brief Writes what the socket takes of a response; once all is written, waits for the next request.
+         * @param connection The connection, holding a formatted response.
+         * @return False if the connection failed, or must be closed after its response.
+         */
+        bool sendResponse(Connection &connection);
+
+        /**
+         * @brief Submits the complete request of a connection to the pool.
+         * @param connection The connection.
+         */
+        void dispatch(Connection &connection);
+
+        /**
+         * @brief Puts back the session of a connection whose request is done, and its payload bytes.
+         * @param connection The connection.
+         */
+        void releaseRequest(Connection &connection);
+
+        /**
+         * @brief Closes a connection and puts its session back on the free list.
+         * @param connections The open connections.
+         * @param socket The socket of the connection to close.
+         */
+        void closeConnection(ConnectionMap &connections, int socket);
+
+        /**
+         * @brief Wakes up the thread running `run()`.
+         */
+        void wake();
+
+        /**
+         * @brief Tokenizes the request held by a session into its response buffer.
+         * @param session The session holding the request.
+         * @param header The header of the request.
+         */
+        static void handleRequest(Session &session, const ScanRequestHeader &header);
+
+        /**
+         * @brief Takes an idle session, or creates one.
+         * @return The session.
+         */
+        std::unique_ptr<Session> acquireSession();
+
+        /**
+         * @brief Puts a session back on the free list.
+         * @param session The session.
+         */
+        void releaseSession(std::unique_ptr<Session> session);
+    };
+
+    /**
+     * @class ScanClient
+     * @brief Sends scan requests to a `ScanServer` over one connection.
+     *
+     * Example usage:
+     * @code
+     * ScanClient client("/tmp/scanner.sock");
+     * ScanResponse response = client.scanFile("input.tny", ScanFormat::TEXT_WITH_POSITIONS);
+     * @endcode
+     */
+    class ScanClient
+    {
+    public:
+        /**
+         * @brief Connects to a server.
+         *
+         * @param socketPath The path of the server's socket file.
+         * @throws std::runtime_error if the connection fails.
+         */
+        explicit ScanClient(const std::string &socketPath);
+
+        ScanClient(const ScanClient &) = delete;
+        ScanClient &operator=(const ScanClient &) = delete;
+
+        /**
+         * @brief Closes the connection.
+         */
+        ~ScanClient();
+
+        /**
+         * @brief Tokenizes source code sent with the request.
+         *
+         * @param source The source code.
+         * @param format The format of the tokens to return.
+         * @return The response.
+         * @throws std::runtime_error if the connection fails.
+         */
+        ScanResponse scanSource(std::string_view source, ScanFormat format = ScanFormat::TEXT);
+
+        /**
+         * @brief Tokenizes a file the server reads itself.
+         *
+         * @param path The path of the file, as seen by the server.
+         * @param format The format of the tokens to return.
+         * @return The response.
+         * @throws std::runtime_error if the connection fails.
+         */
+        ScanResponse scanFile(const std::string &path, ScanFormat format = ScanFormat::TEXT);
+
+    private:
+        int connection = -1; /**< The connected socket */
+
+        /**
+         * @brief Sends one request and reads its response.
+         *
+         * @param kind What the payload is.
+         * @param format The format of the tokens to return.
+         * @param payload The source or the path.
+         * @return The response.
+         * @throws std::runtime_error if the connection fails.
+         */
+        ScanResponse request(ScanRequestKind kind, ScanFormat format, std::string_view payload);
+    };
+} // namespace TINY::SCANNER
+
+#endif // SCAN_SERVER_HPP
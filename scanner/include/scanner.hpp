@@ -4,14 +4,23 @@
  *
  * The Scanner is responsible for reading the source code, identifying tokens,
  * and handling special cases such as invalid characters.
+ *
+ * The scanner is a template over a position policy and a value policy (scanner_policies.hpp),
+ * compiled in scanner.cpp for every combination of them; `Scanner` is the instantiation that
+ * tracks positions and keeps token values.
  */
 
 #ifndef SCANNER_HPP
 #define SCANNER_HPP
 
+#include <cstddef>
+#include <iterator>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "scanner_policies.hpp"
 #include "token.hpp"
 
 /**
@@ -26,50 +35,312 @@ namespace TINY::SCANNER
 {
 
     /**
-     * @class Scanner
+     * @class BasicScanner
      * @brief Performs lexical analysis on TINY language source code.
      *
-     * The `Scanner` processes input source code to produce a sequence of tokens.
+     * The `BasicScanner` processes input source code to produce a sequence of tokens.
      * It identifies keywords, operators, delimiters, and literals, and it reports
      * invalid characters as necessary.
+     *
+     * The input is always a borrowed view, so a `std::string`, a string literal and a
+     * memory-mapped file are scanned by the same code; input arriving in chunks is scanned
+     * by the `StreamScanner` instead.
+     *
+     * @tparam PositionPolicy `TrackPositions` or `NoPositions`.
+     * @tparam ValuePolicy `ViewValues` or `NoValues`.
      */
-    class Scanner
+    template <class PositionPolicy, class ValuePolicy>
+    class BasicScanner
     {
     public:
         /**
-         * @brief Constructs a `Scanner` object with the given input string.
+         * @brief The token type returned by `getNextToken()`.
+         */
+        using Result = typename ValuePolicy::Result;
+
+        /**
+         * @brief Constructs a scanner over the given input.
          *
          * This constructor initializes the `Scanner` with the source code that
-         * needs to be tokenized.
+         * needs to be tokenized. The input is borrowed, not copied, so it can be
+         * a `std::string`, a string literal or a memory-mapped file.
          *
          * @param input The source code to be tokenized.
+         *
+         * @note The `Scanner` does not take ownership of the input. The underlying
+         *       characters must stay alive and unchanged while the `Scanner` is used.
          */
-        Scanner(const std::string &input);
+        BasicScanner(std::string_view input);
+
+        /**
+         * @brief Constructs a scanner that resumes scanning at a given point of the input.
+         *
+         * This constructor is used to scan a part of a larger input, for example one
+         * segment of a file tokenized in parallel. Token positions continue from the
+         * given line and column, and if `startCommentDepth` is positive the scanner
+         * first skips the rest of the enclosing (possibly nested) comment.
+         *
+         * @param input The source code to be tokenized; scanning stops at its end.
+         * @param startPos The position in `input` where scanning starts.
+         * @param startLine The line number at `startPos`.
+         * @param startColumn The column number at `startPos`.
+         * @param startCommentDepth The comment nesting level at `startPos`, 0 outside comments.
+         *
+         * @note As with the other constructor, the input is borrowed, not copied.
+         */
+        BasicScanner(std::string_view input, size_t startPos, int startLine, int startColumn, int startCommentDepth);
+
+        /**
+         * @brief Restarts the scanner at the beginning of a new input.
+         *
+         * Nothing of the previous input is kept, so one `Scanner` (and a `TokenStreamBuilder`
+         * holding it) can be reused for many inputs, as the scan server does for its requests.
+         * Checkpoints saved before the reset can no longer be restored.
+         *
+         * @param newInput The source code to be tokenized (borrowed, not copied).
+         */
+        void reset(std::string_view newInput);
 
         /**
          * @brief Extracts the next token from the input source code.
          *
          * This method processes the source code and returns the next token
-         * identified by the `Scanner`.
+         * identified by the scanner. Once the input is exhausted it returns a
+         * `TokenType::END_OF_INPUT` token with an empty value, on every call, so
+         * the tokens can be read in a single pass without `hasMoreTokens()`:
+         *
+         * @code
+         * while (true)
+         * {
+         *     Token token = scanner.getNextToken();
+         *     if (token.getType() == TokenType::END_OF_INPUT)
+         *         break;
+         *     ...
+         * }
+         * @endcode
+         *
+         * A comment that is never closed is reported once as a `TokenType::UNKNOWN`
+         * token with the value "Unclosed comment", followed by `END_OF_INPUT`.
+         *
+         * With `NoPositions` the line and column of every token are 0, and with `NoValues`
+         * every value is empty (the "Unclosed comment" message included).
          *
          * @return The next token.
          */
-        Token getNextToken();
+        Result getNextToken();
 
         /**
          * @brief Checks if there are more tokens to be extracted.
          *
          * This method determines if the end of the source code has been reached.
+         * It skips the whitespace and comments ahead and then restores the scanner
+         * state from a checkpoint, so a following `getNextToken()` skips them again; loops that call
+         * both scan every comment twice and should test for `END_OF_INPUT` instead.
          *
          * @return True if there are more tokens, false otherwise.
          */
         bool hasMoreTokens();
 
+        /**
+         * @class Checkpoint
+         * @brief A saved scanning state, to return to with `restore()`.
+         *
+         * A checkpoint is a few integers: the position, the comment nesting level and the cached
+         * line and column. Saving and restoring one costs a copy of them, so a consumer can read
+         * tokens ahead speculatively and rewind without creating a new scanner. A default-constructed
+         * checkpoint is the start of the input.
+         *
+         * A saved checkpoint also records the scanner's input generation, which `reset()` bumps, so
+         * restoring it on a later input is rejected instead of resuming at a meaningless offset.
+         */
+        class Checkpoint
+        {
+        public:
+            /**
+             * @brief Gets the input offset the scanner resumes at.
+             * @return The offset.
+             */
+            size_t offset() const
+            {
+                return pos;
+            }
+
+        private:
+            size_t pos = 0;            /**< Position in the input */
+            int commentDepth = 0;      /**< Comment nesting level at `pos` */
+            size_t positionOffset = 0; /**< Offset that `line` and `column` describe */
+            int line = 1;              /**< Line number at `positionOffset` */
+            int column = 1;            /**< Column number at `positionOffset` */
+            size_t generation = ANY_INPUT; /**< Input generation it was saved on, `ANY_INPUT` for the start of any input */
+
+            static constexpr size_t ANY_INPUT = static_cast<size_t>(-1); /**< Generation of a default-constructed checkpoint */
+
+            friend class BasicScanner;
+        };
+
+        /**
+         * @brief Saves the current scanning state.
+         *
+         * @code
+         * Scanner::Checkpoint start = scanner.save();
+         * Token first = scanner.getNextToken();
+         * Token second = scanner.getNextToken();
+         * scanner.restore(start); // the next token is `first` again
+         * @endcode
+         *
+         * @return A checkpoint of the state.
+         */
+        Checkpoint save() const;
+
+        /**
+         * @brief Returns to a saved scanning state.
+         *
+         * The tokens after the checkpoint are scanned again, with the same values and positions.
+         * The checkpoint must have been saved by this scanner on its current input.
+         *
+         * @param checkpoint The checkpoint to return to.
+         * @throws std::invalid_argument if the checkpoint was saved before the last `reset()`.
+         * @throws std::out_of_range if the checkpoint lies past the end of the input.
+         */
+        void restore(const Checkpoint &checkpoint);
+
+        /**
+         * @class TokenRange
+         * @brief A single-pass range over the remaining tokens of a scanner.
+         *
+         * Tokens are scanned one at a time as the range is iterated, so only the current
+         * token is held in memory. Iteration yields what `getNextToken()` returns up to,
+         * but not including, the `END_OF_INPUT` token.
+         */
+        class TokenRange
+        {
+        public:
+            /**
+             * @class iterator
+             * @brief Input iterator that scans the next token when incremented.
+             */
+            class iterator
+            {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = Result;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const Result *;
+                using reference = const Result &;
+
+                /**
+                 * @brief Constructs the end iterator.
+                 */
+                iterator() = default;
+
+                /**
+                 * @brief Constructs an iterator at the next token of a scanner.
+                 * @param scanner The scanner to read tokens from.
+                 */
+                explicit iterator(BasicScanner &scanner);
+
+                /**
+                 * @brief Gets the current token.
+                 * @return The current token.
+                 */
+                const Result &operator*() const;
+
+                /**
+                 * @brief Accesses a member of the current token.
+                 * @return A pointer to the current token.
+                 */
+                const Result *operator->() const;
+
+                /**
+                 * @brief Scans the next token.
+                 * @return A reference to this iterator.
+                 */
+                iterator &operator++();
+
+                /**
+                 * @brief Scans the next token (the previous token is not kept).
+                 */
+                void operator++(int);
+
+                /**
+                 * @brief Checks whether two iterators are both at the end or both not at the end.
+                 * @param other The iterator to compare with.
+                 * @return True if both iterators are at the end or both are not.
+                 */
+                bool operator==(const iterator &other) const;
+
+                /**
+                 * @brief Checks whether exactly one of two iterators is at the end.
+                 * @param other The iterator to compare with.
+                 * @return True if exactly one iterator is at the end.
+                 */
+                bool operator!=(const iterator &other) const;
+
+            private:
+                BasicScanner *scanner = nullptr; /**< The scanner read from, null at the end */
+                std::optional<Result> current;   /**< The current token */
+            };
+
+            /**
+             * @brief Constructs a range over the remaining tokens of a scanner.
+             * @param scanner The scanner to read tokens from.
+             */
+            explicit TokenRange(BasicScanner &scanner);
+
+            /**
+             * @brief Scans the first remaining token.
+             * @return An iterator at that token, or the end iterator if there is none.
+             */
+            iterator begin();
+
+            /**
+             * @brief Gets the end iterator.
+             * @return The end iterator.
+             */
+            iterator end();
+
+        private:
+            BasicScanner &scanner; /**< The scanner read from */
+        };
+
+        /**
+         * @brief Gets a lazy range over the remaining tokens.
+         *
+         * Tokens are scanned on demand as the range is iterated, so filtering or counting
+         * tokens uses constant memory:
+         *
+         * @code
+         * for (const Token &token : scanner.tokens())
+         * @endcode
+         *
+         * The range consumes the scanner; it can be iterated once.
+         *
+         * @return The range.
+         */
+        TokenRange tokens();
+
     private:
-        std::string input; /**< The source code to be tokenized. */
-        size_t pos = 0;    /**< Current position in the input string. */
-        int line = 1;      /**< Current line number in the source code. */
-        int column = 1;    /**< Current column number in the source code. */
+        std::string_view input;    /**< The source code to be tokenized (borrowed). */
+        size_t pos = 0;            /**< Current position in the input string. */
+        int commentDepth = 0;      /**< Nesting level of the comment being skipped, 0 outside comments. */
+        size_t positionOffset = 0; /**< Offset that `line` and `column` describe, at or before `pos`. */
+        int line = 1;              /**< Line number at `positionOffset`. */
+        int column = 1;            /**< Column number at `positionOffset`. */
+        size_t generation = 0;     /**< Number of times the input was replaced, stored in every checkpoint. */
+        static constexpr size_t SHORT_RUN = 16; /**< Longest byte run skipped without calling a SIMD kernel. */
+
+        friend class TokenStreamBuilder; /**< Scans tokens into a TokenStream and hands over the scanning state. */
+
+        /**
+         * @brief Recognizes the token starting at the current position and advances past it.
+         *
+         * The current position must be at the first byte of a token, i.e. whitespace and
+         * comments have already been skipped and the end of input has not been reached.
+         * The token's value is the input between the old and the new position.
+         *
+         * @return The type of the recognized token.
+         */
+        TokenType scanLexeme();
 
         /**
          * @brief Peeks at the next character in the input without advancing the position.
@@ -82,14 +353,26 @@ namespace TINY::SCANNER
         char peek() const;
 
         /**
-         * @brief Gets the next character in the input and advances the position.
+         * @brief Brings the line and column numbers up to the current position.
          *
-         * This method reads the next character from the source code and moves
-         * the cursor forward.
-         *
-         * @return The next character in the input, or '\0' if end of input.
+         * Skipping and scanning only move `pos`; the line and column are counted here, over the
+         * bytes between `positionOffset` and `pos`, when a `Token` needs them. Builders that store
+         * offsets never call it, their positions are resolved later through a `LineIndex`, and
+         * neither does `getNextToken()` with `NoPositions`.
          */
-        char get();
+        void syncPosition();
+
+        /**
+         * @brief Gets the line number given to tokens.
+         * @return The line number at `positionOffset`, or 0 with `NoPositions`.
+         */
+        int tokenLine() const;
+
+        /**
+         * @brief Gets the column number given to tokens.
+         * @return The column number at `positionOffset`, or 0 with `NoPositions`.
+         */
+        int tokenColumn() const;
 
         /**
          * @brief Skips over whitespace characters in the input.
@@ -102,14 +385,16 @@ namespace TINY::SCANNER
         /**
          * @brief Skips over nested comments in the input source code.
          *
-         * This method checks if the current position is at the start of a comment (indicated by a '{' character).
+         * This method checks if the scanner is inside a comment (`commentDepth` is positive)
+         * or if the current position is at the start of a comment (indicated by a '{' character).
          * If it is, the method skips over all characters until it finds the corresponding closing '}'.
          * It correctly handles **nested comments** by keeping track of the nesting levels.
          * For each opening '{', it increases the nesting level, and for each closing '}', it decreases the nesting level.
          * The comment is considered closed when the nesting level returns to zero.
          * After successfully skipping a comment, it also skips any whitespace characters that follow the comment.
          * If the end of the input is reached before all comments are closed (i.e., nesting level does not return to zero),
-         * the method returns `true` to indicate that an unclosed comment was detected.
+         * the method returns `true` to indicate that an unclosed comment was detected, and the
+         * comment is forgotten (`commentDepth` is reset to zero).
          *
          * @return True if an unclosed comment was detected, false otherwise.
          */
@@ -138,6 +423,17 @@ namespace TINY::SCANNER
          */
         bool isOperatorOrDelimiter(char c) const;
     };
+
+    /**
+     * @brief The scanner tracking positions and returning tokens with their values.
+     */
+    using Scanner = BasicScanner<TrackPositions, ViewValues>;
+
+    // Every combination of policies is compiled once, in scanner.cpp
+    extern template class BasicScanner<TrackPositions, ViewValues>;
+    extern template class BasicScanner<TrackPositions, NoValues>;
+    extern template class BasicScanner<NoPositions, ViewValues>;
+    extern template class BasicScanner<NoPositions, NoValues>;
 } // namespace TINY::SCANNER
 
 #endif // SCANNER_HPP
@@ -0,0 +1,104 @@
+/**
+ * @file scanner_policies.hpp
+ * @brief Defines the policies a `BasicScanner` is specialized with at compile time.
+ *
+ * A scanner is instantiated with one policy of each kind:
+ *
+ * | Kind      | Policies                                      | Decides                                   |
+ * |-----------|-----------------------------------------------|-------------------------------------------|
+ * | Positions | `TrackPositions`, `NoPositions`               | whether line and column numbers are kept  |
+ * | Values    | `ViewValues`, `NoValues`                      | whether tokens carry their value          |
+ *
+ * Work a policy turns off is removed by the compiler, not skipped by a branch at run time.
+ * `Scanner` is the instantiation that tracks positions and keeps values; the other
+ * combinations are listed in scanner.hpp.
+ */
+
+#ifndef SCANNER_POLICIES_HPP
+#define SCANNER_POLICIES_HPP
+
+#include <string_view>
+
+#include "token.hpp"
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @struct TrackPositions
+     * @brief Position policy: every token carries the line and column where it ends.
+     */
+    struct TrackPositions
+    {
+        static constexpr bool enabled = true; /**< Line and column numbers are counted */
+    };
+
+    /**
+     * @struct NoPositions
+     * @brief Position policy: no line or column numbers are counted, tokens carry 0 for both.
+     *
+     * For consumers that never report positions, or that resolve them later from offsets
+     * through a `LineIndex`.
+     */
+    struct NoPositions
+    {
+        static constexpr bool enabled = false; /**< Line and column numbers are not counted */
+    };
+
+    /**
+     * @struct ViewValues
+     * @brief Value policy: every token's value views its lexeme in the input.
+     */
+    struct ViewValues
+    {
+        using Result = Token; /**< The token type returned by the scanner */
+
+        /**
+         * @brief Builds a token from the scanned lexeme.
+         *
+         * @param type The type of the token.
+         * @param value The lexeme, a view into the input.
+         * @param line The line number, 0 if not tracked.
+         * @param column The column number, 0 if not tracked.
+         * @return The token.
+         */
+        static Result make(TokenType type, std::string_view value, int line, int column)
+        {
+            return Token(type, value, line, column);
+        }
+    };
+
+    /**
+     * @struct NoValues
+     * @brief Value policy: every token's value is empty, only the type is kept.
+     *
+     * For consumers that only look at token types, such as counters or type filters.
+     */
+    struct NoValues
+    {
+        using Result = Token; /**< The token type returned by the scanner */
+
+        /**
+         * @brief Builds a token from the scanned lexeme, dropping the lexeme.
+         *
+         * @param type The type of the token.
+         * @param line The line number, 0 if not tracked.
+         * @param column The column number, 0 if not tracked.
+         * @return The token.
+         */
+        static Result make(TokenType type, std::string_view, int line, int column)
+        {
+            return Token(type, std::string_view(), line, column);
+        }
+    };
+} // namespace TINY::SCANNER
+
+#endif // SCANNER_POLICIES_HPP
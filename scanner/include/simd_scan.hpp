@@ -0,0 +1,97 @@
+/**
+ * @file simd_scan.hpp
+ * @brief Declares the vectorized byte-search kernels used to skip whitespace and comments.
+ *
+ * Each search is implemented three times (AVX2, SSE2 and portable scalar code). The fastest
+ * kernel supported by the running CPU is selected once, at first use, from the CPUID feature
+ * bits; the scalar kernel is used on CPUs and compilers without x86 SIMD support.
+ */
+
+#ifndef SIMD_SCAN_HPP
+#define SIMD_SCAN_HPP
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @namespace TINY::SCANNER::SIMD
+     * @brief Vectorized searches over raw input bytes, with runtime CPU dispatch.
+     */
+    namespace SIMD
+    {
+
+        /**
+         * @enum Kernel
+         * @brief The available kernel implementations, from slowest to fastest.
+         */
+        enum class Kernel
+        {
+            SCALAR, /**< Portable one-byte-at-a-time code */
+            SSE2,   /**< 16 bytes per step */
+            AVX2    /**< 32 bytes per step */
+        };
+
+        /**
+         * @brief Finds the first byte that is not whitespace (as `std::isspace` in the "C" locale).
+         *
+         * @param begin Start of the range to search.
+         * @param end End of the range to search.
+         * @return A pointer to the first non-whitespace byte, or `end` if there is none.
+         */
+        const char *findNonSpace(const char *begin, const char *end);
+
+        /**
+         * @brief Finds the first byte that matters inside a comment: '{', '}' or '\0'.
+         *
+         * @param begin Start of the range to search.
+         * @param end End of the range to search.
+         * @return A pointer to the first '{', '}' or '\0' byte, or `end` if there is none.
+         */
+        const char *findCommentDelimiter(const char *begin, const char *end);
+
+        /**
+         * @brief Counts the newline ('\n') bytes in a range.
+         *
+         * @param begin Start of the range to count in.
+         * @param end End of the range to count in.
+         * @return The number of newline bytes.
+         */
+        std::size_t countNewlines(const char *begin, const char *end);
+
+        /**
+         * @brief Gets the kernel currently used by the search functions.
+         * @return The active kernel.
+         */
+        Kernel activeKernel();
+
+        /**
+         * @brief Forces the search functions to use the given kernel.
+         *
+         * Intended for tests and benchmarks that compare the kernels on the same input.
+         *
+         * @param kernel The kernel to use.
+         * @return True if the kernel is supported by this CPU and build and is now active, false otherwise.
+         */
+        bool selectKernel(Kernel kernel);
+
+        /**
+         * @brief Gets the name of a kernel ("scalar", "sse2" or "avx2").
+         * @param kernel The kernel to name.
+         * @return The name of the kernel.
+         */
+        std::string_view kernelName(Kernel kernel);
+    } // namespace SIMD
+} // namespace TINY::SCANNER
+
+#endif // SIMD_SCAN_HPP
@@ -0,0 +1,167 @@
+/**
+ * @file stream_scanner.hpp
+ * @brief Defines the StreamScanner class for tokenizing input that arrives in chunks.
+ *
+ * Unlike the Scanner, which needs the whole source in memory, the StreamScanner is fed
+ * the source one buffer at a time and hands every token to a callback as soon as it is
+ * complete. Tokens, ":=" pairs and nested comments may be split across chunk boundaries.
+ */
+
+#ifndef STREAM_SCANNER_HPP
+#define STREAM_SCANNER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+
+#include "lexer_tables.hpp"
+#include "token.hpp"
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @class StreamScanner
+     * @brief Performs lexical analysis on TINY source code delivered in chunks.
+     *
+     * The `StreamScanner` keeps only the state needed to resume between chunks: the DFA
+     * state and text of a token cut by the chunk boundary, the comment nesting depth, and
+     * the current line and column. Its memory use is therefore bounded by the chunk size
+     * plus the length of the longest token, however large the input is; a token longer than
+     * the scanner's limit is rejected instead of being buffered without end.
+     *
+     * The emitted tokens, including their positions, are the same as those produced by
+     * `TokenStreamBuilder::build()` for the whole input: scanning stops at an unclosed
+     * comment without emitting a token for it.
+     */
+    class StreamScanner
+    {
+    public:
+        /**
+         * @brief Callback receiving each token as soon as it is complete.
+         *
+         * The token's value views the chunk being fed, or an internal buffer for a token cut
+         * by a chunk boundary, so it is only valid during the call; copy it to keep it.
+         */
+        using TokenHandler = std::function<void(const Token &)>;
+
+        /**
+         * @brief Default size of the buffers read by `scan()`, in bytes.
+         */
+        static constexpr std::size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+        /**
+         * @brief Default limit on the length of a token, in bytes.
+         */
+        static constexpr std::size_t DEFAULT_MAX_TOKEN_LENGTH = 1024 * 1024;
+
+        /**
+         * @brief Constructs a `StreamScanner` that passes tokens to the given callback.
+         *
+         * @param onToken The callback receiving each token.
+         * @param maxTokenLength The length in bytes above which a token is rejected.
+         */
+        explicit StreamScanner(TokenHandler onToken, std::size_t maxTokenLength = DEFAULT_MAX_TOKEN_LENGTH);
+
+        /**
+         * @brief Scans the next chunk of the input.
+         *
+         * Every token that is complete within the chunk is passed to the callback. A token
+         * that may continue in the next chunk is kept until more input or `finish()` arrives.
+         * The chunk is not referenced after the call returns.
+         *
+         * @param chunk The next bytes of the input.
+         * @throws std::runtime_error if a token grows longer than the limit, wherever the chunks end.
+         */
+        void feed(std::string_view chunk);
+
+        /**
+         * @brief Signals the end of the input and emits the last pending token, if any.
+         *
+         * After `finish()`, further calls to `feed()` are ignored.
+         */
+        void finish();
+
+        /**
+         * @brief Reads a stream in fixed-size buffers and scans it to the end.
+         *
+         * @param input The stream to read the source code from.
+         * @param bufferSize The size of the read buffer in bytes.
+         * @return The number of bytes read from the stream.
+         */
+        std::size_t scan(std::istream &input, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+        /**
+         * @brief Checks whether scanning stopped at a comment that was never closed.
+         *
+         * @return True if an unclosed comment was detected, false otherwise.
+         */
+        bool hasUnclosedComment() const;
+
+    private:
+        TokenHandler onToken;              /**< Callback receiving the tokens. */
+        std::size_t maxTokenLength;        /**< Length above which a token is rejected. */
+        LEXER::State state = LEXER::START; /**< DFA state of the token cut by the last chunk boundary. */
+        std::string pending;               /**< Text of the token cut by the last chunk boundary. */
+        int commentDepth = 0;              /**< Nesting level of the comment being skipped, 0 outside comments. */
+        bool stopped = false;              /**< True once scanning stopped (unclosed comment or finish). */
+        bool unclosedComment = false;      /**< True if scanning stopped at an unclosed comment. */
+        int line = 1;                      /**< Current line number in the source code. */
+        int column = 1;                    /**< Current column number in the source code. */
+
+        /**
+         * @brief Skips comment bytes until the comment is closed or the chunk ends.
+         *
+         * @param cursor The first byte to examine.
+         * @param end The end of the chunk.
+         * @return A pointer to the first byte after the comment, or `end`.
+         */
+        const char *skipComment(const char *cursor, const char *end);
+
+        /**
+         * @brief Runs the DFA from the saved state over the chunk until a token ends or the chunk ends.
+         *
+         * @param cursor The first byte to examine.
+         * @param end The end of the chunk.
+         * @return A pointer to the first byte after the token, or `end` if the token may continue.
+         * @throws std::runtime_error if the token is longer than `maxTokenLength`.
+         */
+        const char *scanToken(const char *cursor, const char *end);
+
+        /**
+         * @brief Rejects a token that is longer than the limit.
+         *
+         * @param length The length of the token so far.
+         * @throws std::runtime_error if `length` exceeds `maxTokenLength`.
+         */
+        void checkTokenLength(std::size_t length) const;
+
+        /**
+         * @brief Emits the token ending in the given final DFA state and resets the DFA.
+         *
+         * @param finalState The final state reached by the DFA.
+         * @param value The token's text, in the current chunk or in `pending`.
+         */
+        void emit(LEXER::State finalState, std::string_view value);
+
+        /**
+         * @brief Updates the line and column numbers for bytes skipped outside of tokens.
+         *
+         * @param begin Start of the skipped bytes.
+         * @param end End of the skipped bytes.
+         */
+        void advance(const char *begin, const char *end);
+    };
+} // namespace TINY::SCANNER
+
+#endif // STREAM_SCANNER_HPP
@@ -0,0 +1,160 @@
+/**
+ * @file symbol_table.hpp
+ * @brief Defines the SymbolTable class, which interns identifier spellings.
+ *
+ * Every distinct identifier spelling is copied once into an arena and given a dense
+ * 32-bit symbol ID, assigned in order of first appearance. Later stages can compare and
+ * hash identifiers as integers and look up the spelling only when they need the text.
+ */
+
+#ifndef SYMBOL_TABLE_HPP
+#define SYMBOL_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @class SymbolTable
+     * @brief Maps identifier spellings to dense symbol IDs and back.
+     *
+     * Spellings are stored in fixed-size arena blocks that never move, so the views returned
+     * by `spelling()` stay valid until the table is cleared or destroyed, independently of the
+     * source the identifiers were scanned from. Copying a table re-interns its spellings, so the
+     * copy has the same IDs and its own arena.
+     *
+     * Lookups go through an open-addressing hash table of symbol IDs with linear probing,
+     * kept at most half full; the hash of every symbol is stored so growing the table
+     * never rehashes the spellings.
+     */
+    class SymbolTable
+    {
+    public:
+        /**
+         * @brief The symbol ID of tokens that are not identifiers.
+         */
+        static constexpr std::uint32_t NO_SYMBOL = std::numeric_limits<std::uint32_t>::max();
+
+        /**
+         * @brief Size of an arena block in bytes; longer spellings get a block of their own.
+         */
+        static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+        /**
+         * @brief Constructs an empty symbol table.
+         */
+        SymbolTable() = default;
+
+        /**
+         * @brief Constructs a copy of another table with the same symbol IDs.
+         * @param other The table to copy.
+         */
+        SymbolTable(const SymbolTable &other);
+
+        /**
+         * @brief Replaces the content of this table with a copy of another table.
+         * @param other The table to copy.
+         * @return A reference to this table.
+         */
+        SymbolTable &operator=(const SymbolTable &other);
+
+        /**
+         * @brief Takes over the symbols and the arena of another table, leaving it empty.
+         * @param other The table to move from.
+         */
+        SymbolTable(SymbolTable &&other) noexcept;
+
+        /**
+         * @brief Releases this table's symbols and takes over those of another table, leaving it empty.
+         * @param other The table to move from.
+         * @return A reference to this table.
+         */
+        SymbolTable &operator=(SymbolTable &&other) noexcept;
+
+        /**
+         * @brief Gets the symbol ID of a spelling, adding the spelling if it is new.
+         *
+         * @param spelling The identifier spelling; it is copied into the arena if new.
+         * @return The symbol ID, `size() - 1` for a new spelling.
+         */
+        std::uint32_t intern(std::string_view spelling);
+
+        /**
+         * @brief Gets the symbol ID of a spelling without adding it.
+         *
+         * @param spelling The identifier spelling.
+         * @return The symbol ID, or `NO_SYMBOL` if the spelling was never interned.
+         */
+        std::uint32_t find(std::string_view spelling) const;
+
+        /**
+         * @brief Gets the spelling of a symbol.
+         *
+         * @param symbol A symbol ID less than `size()`.
+         * @return The spelling, a view into the table's arena.
+         */
+        std::string_view spelling(std::uint32_t symbol) const;
+
+        /**
+         * @brief Gets the number of distinct symbols.
+         * @return The symbol count.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Removes all symbols and releases the arena.
+         */
+        void clear();
+
+    private:
+        std::vector<std::unique_ptr<char[]>> blocks;             /**< Arena blocks holding the spellings */
+        char *currentBlock = nullptr;                            /**< The block new spellings are appended to */
+        std::size_t blockUsed = 0;                               /**< Bytes used in the current block */
+        std::vector<std::string_view> spellings;                 /**< Spelling of every symbol, indexed by ID */
+        std::vector<std::uint32_t> hashes;                       /**< Hash of every symbol's spelling, indexed by ID */
+        std::vector<std::uint32_t> slots;                        /**< Hash table of symbol IDs, NO_SYMBOL in empty slots */
+
+        /**
+         * @brief Hashes a spelling (32-bit FNV-1a).
+         * @param text The spelling to hash.
+         * @return The hash.
+         */
+        static std::uint32_t hash(std::string_view text);
+
+        /**
+         * @brief Finds the slot holding a spelling, or the empty slot where it would go.
+         * @param text The spelling to look for.
+         * @param textHash The hash of the spelling.
+         * @return The slot index; `slots` must not be empty.
+         */
+        std::size_t findSlot(std::string_view text, std::uint32_t textHash) const;
+
+        /**
+         * @brief Doubles the hash table and re-inserts every symbol.
+         */
+        void grow();
+
+        /**
+         * @brief Copies a spelling into the arena.
+         * @param text The spelling to copy.
+         * @return A view of the copy.
+         */
+        std::string_view store(std::string_view text);
+    };
+} // namespace TINY::SCANNER
+
+#endif // SYMBOL_TABLE_HPP
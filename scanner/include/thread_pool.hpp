@@ -0,0 +1,131 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Defines the ThreadPool class, a fixed set of worker threads that steal work from each other.
+ *
+ * Every worker owns a task queue. Tasks are handed to the queues in turn; a worker takes the
+ * newest task of its own queue and, when that is empty, steals the oldest task of another
+ * worker's queue. Long tasks therefore do not hold up the short ones queued behind them.
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @class ThreadPool
+     * @brief Runs submitted tasks on a fixed number of work-stealing worker threads.
+     *
+     * Example usage:
+     * @code
+     * ThreadPool pool(4);
+     * for (const std::string &path : paths)
+     * {
+     *     pool.submit([path] { scanFile(path); });
+     * }
+     * pool.wait();
+     * @endcode
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @brief A unit of work.
+         */
+        using Task = std::function<void()>;
+
+        /**
+         * @brief Starts the worker threads.
+         *
+         * @param threadCount Number of worker threads, 0 for one per hardware thread.
+         */
+        explicit ThreadPool(std::size_t threadCount = 0);
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /**
+         * @brief Finishes the queued tasks and joins the worker threads.
+         */
+        ~ThreadPool();
+
+        /**
+         * @brief Queues a task.
+         *
+         * @param task The task to run on one of the workers.
+         */
+        void submit(Task task);
+
+        /**
+         * @brief Blocks until every submitted task has finished.
+         *
+         * @throws The first exception thrown by a task since the last call, after all tasks finished.
+         */
+        void wait();
+
+        /**
+         * @brief Gets the number of worker threads.
+         * @return The thread count.
+         */
+        std::size_t size() const;
+
+    private:
+        /**
+         * @struct Queue
+         * @brief The task queue of one worker.
+         */
+        struct Queue
+        {
+            std::mutex mutex;       /**< Guards the tasks */
+            std::deque<Task> tasks; /**< Queued tasks, the newest at the back */
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues; /**< One queue per worker */
+        std::vector<std::thread> workers;           /**< The worker threads */
+        std::atomic<std::size_t> nextQueue{0};      /**< Queue the next submitted task goes to */
+
+        std::mutex stateMutex;               /**< Guards the counters below and the first error */
+        std::condition_variable taskQueued;  /**< Signalled when a task is queued or the pool stops */
+        std::condition_variable allFinished; /**< Signalled when the last pending task finishes */
+        std::size_t queuedTasks = 0;         /**< Tasks waiting in the queues */
+        std::size_t pendingTasks = 0;        /**< Tasks submitted and not finished */
+        bool stopping = false;               /**< Set when the workers should exit */
+        std::exception_ptr firstError;       /**< First exception thrown by a task */
+
+        /**
+         * @brief Runs tasks until the pool stops.
+         * @param index The index of the worker and of its queue.
+         */
+        void workerLoop(std::size_t index);
+
+        /**
+         * @brief Takes a task from the worker's own queue, or steals one from another queue.
+         * @param index The index of the worker.
+         * @return The task, or nothing if every queue is empty.
+         */
+        std::optional<Task> takeTask(std::size_t index);
+    };
+} // namespace TINY::SCANNER
+
+#endif // THREAD_POOL_HPP
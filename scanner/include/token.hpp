@@ -10,9 +10,11 @@
 #define TOKEN_HPP
 
 #include <array>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
 
 /**
  * @namespace TINY::SCANNER
@@ -28,8 +30,10 @@ namespace TINY::SCANNER
     /**
      * @enum TokenType
      * @brief Enumerates the types of tokens in the TINY language.
+     *
+     * The underlying type is a single byte, so arrays of token types stay compact.
      */
-    enum class TokenType
+    enum class TokenType : std::uint8_t
     {
         IF,            /**< "if" keyword */
         THEN,          /**< "then" keyword */
@@ -50,7 +54,8 @@ namespace TINY::SCANNER
         SEMICOLON,     /**< Semicolon ";" */
         IDENTIFIER,    /**< Identifier (e.g., variable names) */
         NUMBER,        /**< Numeric literal */
-        UNKNOWN        /**< Unknown or invalid token */
+        UNKNOWN,       /**< Unknown or invalid token */
+        END_OF_INPUT   /**< End of the input, returned once all tokens have been read */
     };
 
     /**
@@ -58,6 +63,11 @@ namespace TINY::SCANNER
      * @brief Represents a single token in the TINY language.
      *
      * Each token consists of a type, value, and its position in the source code.
+     *
+     * A token is a small, trivially copyable record: its value is a view of characters owned
+     * by someone else (the scanned source, a reader's buffer, or a string literal), so tokens
+     * can be copied, assigned, moved and sorted as plain bytes. The characters must stay
+     * alive while the value is used; `std::string(token.getValue())` keeps a copy.
      */
     class Token
     {
@@ -66,7 +76,7 @@ namespace TINY::SCANNER
          * @brief Constructs a Token object.
          *
          * @param type The type of the token.
-         * @param value The string representation of the token.
+         * @param value The string representation of the token, borrowed, not copied.
          * @param line The line number where the token appears.
          * @param column The column number where the token appears.
          */
@@ -80,9 +90,9 @@ namespace TINY::SCANNER
 
         /**
          * @brief Gets the value of the token.
-         * @return The token's value.
+         * @return A view of the token's value.
          */
-        std::string getValue() const;
+        std::string_view getValue() const;
 
         /**
          * @brief Gets the line number of the token.
@@ -103,19 +113,13 @@ namespace TINY::SCANNER
         std::string toString(bool includePosition = false) const;
 
     private:
-        const TokenType type;    /**< The type of the token */
-        const std::string value; /**< The value of the token */
-        const int line;          /**< The line number of the token */
-        const int column;        /**< The column number of the token */
+        const char *data;     /**< The first character of the value */
+        std::uint32_t length; /**< The length of the value in bytes */
+        int line;             /**< The line number of the token */
+        int column;           /**< The column number of the token */
+        TokenType type;       /**< The type of the token */
 
-        /**
-         * @brief Converts the token type to a string representation.
-         *
-         * @return A string representing the token type.
-         *
-         * @throws std::out_of_range if the token type is invalid.
-         */
-        std::string_view getTokenTypeString() const;
+        friend class TokenWriter; /**< Formats tokens with the type name table. */
 
         /**
          * @brief Static constexpr lookup table for token type string representations.
@@ -123,7 +127,7 @@ namespace TINY::SCANNER
          * This table maps each TokenType enum value to its corresponding string
          * representation for use in debugging and output.
          */
-        static constexpr std::array<std::string_view, 20> tokenTypeStrings = {
+        static constexpr std::array<std::string_view, 21> tokenTypeStrings = {
             "IF",            /**< "if" keyword */
             "THEN",          /**< "then" keyword */
             "END",           /**< "end" keyword */
@@ -143,9 +147,13 @@ namespace TINY::SCANNER
             "SEMICOLON",     /**< Semicolon ";" */
             "IDENTIFIER",    /**< Identifier (e.g., variable names) */
             "NUMBER",        /**< Numeric literal */
-            "UNKNOWN"        /**< Unknown or invalid token */
+            "UNKNOWN",       /**< Unknown or invalid token */
+            "END_OF_INPUT"   /**< End of the input */
         };
     };
+
+    static_assert(std::is_trivially_copyable_v<Token>, "tokens must stay copyable as plain bytes");
+    static_assert(sizeof(Token) <= 3 * sizeof(void *), "tokens must stay three words at most");
 } // namespace TINY::SCANNER
 
 #endif // TOKEN_HPP
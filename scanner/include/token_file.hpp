@@ -0,0 +1,193 @@
+/**
+ * @file token_file.hpp
+ * @brief Defines the binary token file format, its writer and its memory-mapped reader.
+ *
+ * A token file holds the same information as the text output (type, value, line and
+ * column of every token) in a form other tools can use without parsing text:
+ *
+ * | Part    | Content                                                           |
+ * |---------|-------------------------------------------------------------------|
+ * | Header  | `TokenFileHeader`: magic "TNYT", version, record size, counts      |
+ * | Records | `tokenCount` fixed-width `TokenRecord`s, one per token, in order   |
+ * | Pool    | `poolSize` bytes holding every distinct token value once           |
+ *
+ * A record refers to its value by offset and length in the pool. All integers are stored in
+ * the byte order of the host that wrote the file, so the reader can serve records straight
+ * from the mapping without converting them; on the usual little-endian hosts that is
+ * little-endian. The reader recognizes a file from a host of the other byte order by its
+ * byte-swapped version and rejects it.
+ */
+
+#ifndef TOKEN_FILE_HPP
+#define TOKEN_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.hpp"
+#include "symbol_table.hpp"
+#include "token.hpp"
+#include "token_stream.hpp"
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @struct TokenFileHeader
+     * @brief The fixed-size header at the start of a token file.
+     */
+    struct TokenFileHeader
+    {
+        char magic[4];            /**< Always "TNYT" */
+        std::uint16_t version;    /**< Format version, `TokenFileHeader::VERSION` */
+        std::uint16_t recordSize; /**< Size of a record in bytes, `sizeof(TokenRecord)` */
+        std::uint64_t tokenCount; /**< Number of records */
+        std::uint64_t poolSize;   /**< Size of the string pool in bytes */
+
+        /**
+         * @brief The format version written by this implementation.
+         */
+        static constexpr std::uint16_t VERSION = 1;
+    };
+
+    /**
+     * @struct TokenRecord
+     * @brief The fixed-width record of one token in a token file.
+     */
+    struct TokenRecord
+    {
+        std::uint32_t offset;     /**< Offset of the token's value in the string pool */
+        std::uint32_t length;     /**< Length of the token's value in bytes */
+        std::uint32_t line;       /**< Line number of the token */
+        std::uint32_t column;     /**< Column number of the token */
+        TokenType type;           /**< Type of the token */
+        std::uint8_t reserved[3]; /**< Always zero */
+    };
+
+    static_assert(sizeof(TokenFileHeader) == 24, "unexpected token file header layout");
+    static_assert(sizeof(TokenRecord) == 20, "unexpected token record layout");
+
+    /**
+     * @class TokenFileWriter
+     * @brief Writes tokens to a binary token file one at a time.
+     *
+     * Records are written as tokens arrive; the distinct values are collected in memory and
+     * written as the string pool by `finish()`, which then fills in the header. The output
+     * stream must therefore be seekable (a file, not a pipe).
+     *
+     * @note Memory grows with the total size of the distinct values until `finish()`, however
+     *       often the records are flushed. Output that must stay within bounded memory, as in
+     *       the streaming modes, uses the token pipe format (token_pipe.hpp) instead.
+     */
+    class TokenFileWriter
+    {
+    public:
+        /**
+         * @brief Starts a token file, writing a placeholder header.
+         *
+         * @param output The seekable binary stream to write to, positioned where the file starts.
+         */
+        explicit TokenFileWriter(std::ostream &output);
+
+        /**
+         * @brief Writes the record of one token.
+         *
+         * @param type The type of the token.
+         * @param value The value of the token.
+         * @param line The line number of the token.
+         * @param column The column number of the token.
+         * @throws std::runtime_error if the string pool would exceed 4 GiB.
+         */
+        void write(TokenType type, std::string_view value, int line, int column);
+
+        /**
+         * @brief Writes the string pool and the final header.
+         *
+         * @throws std::runtime_error if the stream fails.
+         */
+        void finish();
+
+        /**
+         * @brief Writes a whole token stream to a token file.
+         *
+         * @param output The seekable binary stream to write to.
+         * @param tokens The tokens to write; their source must still be alive.
+         */
+        static void write(std::ostream &output, const TokenStream &tokens);
+
+    private:
+        std::ostream &output;                    /**< The stream written to */
+        std::streampos start;                    /**< Position of the header in the stream */
+        std::uint64_t tokenCount = 0;            /**< Number of records written */
+        SymbolTable values;                      /**< The distinct values; pool order is symbol order */
+        std::vector<std::uint32_t> valueOffsets; /**< Pool offset of every distinct value */
+        std::uint64_t poolSize = 0;              /**< Size of the pool written by `finish()` */
+    };
+
+    /**
+     * @class TokenFile
+     * @brief Read-only access to a binary token file through a memory mapping.
+     *
+     * The file is validated when it is opened, down to the value bounds and the type of every
+     * record; after that, tokens are read straight from the mapping, and values are views
+     * into its string pool, without any deserialization.
+     */
+    class TokenFile
+    {
+    public:
+        /**
+         * @brief Maps and validates a token file.
+         *
+         * @param filePath Path to the token file.
+         * @throws std::runtime_error if the file cannot be mapped or is not a valid token file.
+         */
+        explicit TokenFile(const std::string &filePath);
+
+        /**
+         * @brief Gets the number of tokens.
+         * @return The token count.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Gets the record of a token.
+         * @param index The index of the token, less than `size()`.
+         * @return The record, inside the mapping.
+         */
+        const TokenRecord &record(std::size_t index) const;
+
+        /**
+         * @brief Gets the value of a token.
+         * @param index The index of the token, less than `size()`.
+         * @return The value, a view into the mapped string pool.
+         */
+        std::string_view valueAt(std::size_t index) const;
+
+        /**
+         * @brief Converts a token to a standalone `Token`.
+         * @param index The index of the token, less than `size()`.
+         * @return The token.
+         */
+        Token toToken(std::size_t index) const;
+
+    private:
+        MappedFile file;                      /**< The mapped token file */
+        const TokenRecord *records = nullptr; /**< The records, inside the mapping */
+        std::size_t count = 0;                /**< Number of records */
+        std::string_view pool;                /**< The string pool, inside the mapping */
+    };
+} // namespace TINY::SCANNER
+
+#endif // TOKEN_FILE_HPP
@@ -0,0 +1,198 @@
+/**
+ * @file token_pipe.hpp
+ * @brief Defines the binary token pipe format, its writer and its reader.
+ *
+ * The token file format (token_file.hpp) puts the counts in its header and every value in a
+ * pool after the records, so it can only be written to a seekable file once scanning ends.
+ * The pipe format carries the same fields but can be written and read one token at a time,
+ * so it can sit between two processes of a shell pipeline:
+ *
+ * | Part    | Content                                                              |
+ * |---------|----------------------------------------------------------------------|
+ * | Header  | `TokenPipeHeader`: magic "TNYS", version, record size                 |
+ * | Tokens  | per token, a `TokenPipeRecord` followed by `length` bytes of its value |
+ * | End     | a record of type `END_OF_INPUT` with an empty value                   |
+ *
+ * The end record tells a reader that the writer finished, as opposed to a stream cut
+ * short. As in the token file format, all integers are stored in the byte order of the
+ * writing host, and a reader rejects a pipe whose header shows the other byte order.
+ */
+
+#ifndef TOKEN_PIPE_HPP
+#define TOKEN_PIPE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "token.hpp"
+#include "token_stream.hpp"
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @struct TokenPipeHeader
+     * @brief The fixed-size header at the start of a token pipe.
+     */
+    struct TokenPipeHeader
+    {
+        char magic[4];            /**< Always "TNYS" */
+        std::uint16_t version;    /**< Format version, `TokenPipeHeader::VERSION` */
+        std::uint16_t recordSize; /**< Size of a record in bytes, `sizeof(TokenPipeRecord)` */
+
+        /**
+         * @brief The format version written by this implementation.
+         */
+        static constexpr std::uint16_t VERSION = 1;
+    };
+
+    /**
+     * @struct TokenPipeRecord
+     * @brief The fixed-width part of one token in a token pipe, followed by the token's value.
+     */
+    struct TokenPipeRecord
+    {
+        std::uint32_t length;     /**< Length of the value that follows, in bytes */
+        std::uint32_t line;       /**< Line number of the token */
+        std::uint32_t column;     /**< Column number of the token */
+        TokenType type;           /**< Type of the token */
+        std::uint8_t reserved[3]; /**< Always zero */
+    };
+
+    static_assert(sizeof(TokenPipeHeader) == 8, "unexpected token pipe header layout");
+    static_assert(sizeof(TokenPipeRecord) == 16, "unexpected token pipe record layout");
+
+    /**
+     * @class TokenPipeWriter
+     * @brief Writes tokens in the pipe format to a stream that need not be seekable.
+     *
+     * Records are collected in a bounded buffer, which is handed to the stream when it is full
+     * and on every `flush()`, so a reader on the other end of a pipe sees the tokens of a chunk
+     * of input as soon as the writer flushes after scanning it.
+     *
+     * Example usage:
+     * @code
+     * TokenPipeWriter writer(std::cout);
+     * writer.write(token);
+     * writer.finish();
+     * @endcode
+     */
+    class TokenPipeWriter
+    {
+    public:
+        /**
+         * @brief Default size of the output buffer in bytes.
+         */
+        static constexpr std::size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+        /**
+         * @brief Starts a token pipe, buffering its header.
+         *
+         * @param output The binary stream to write to; it must outlive the writer.
+         * @param bufferSize Size of the output buffer in bytes.
+         */
+        explicit TokenPipeWriter(std::ostream &output, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+        TokenPipeWriter(const TokenPipeWriter &) = delete;
+        TokenPipeWriter &operator=(const TokenPipeWriter &) = delete;
+
+        /**
+         * @brief Writes out the buffered records; errors are ignored, call `flush()` to see them.
+         */
+        ~TokenPipeWriter();
+
+        /**
+         * @brief Writes the record and the value of one token.
+         *
+         * @param type The type of the token.
+         * @param value The value of the token.
+         * @param line The line number of the token.
+         * @param column The column number of the token.
+         */
+        void write(TokenType type, std::string_view value, int line, int column);
+
+        /**
+         * @brief Writes the record and the value of one token.
+         * @param token The token to write.
+         */
+        void write(const Token &token);
+
+        /**
+         * @brief Writes the records and values of every token in a stream.
+         * @param tokens The tokens to write; their source must still be alive.
+         */
+        void write(const TokenStream &tokens);
+
+        /**
+         * @brief Writes out the buffered records and flushes the output stream.
+         *
+         * @throws std::runtime_error if the output stream fails.
+         */
+        void flush();
+
+        /**
+         * @brief Writes the end record and flushes; nothing may be written after it.
+         *
+         * @throws std::runtime_error if the output stream fails.
+         */
+        void finish();
+
+    private:
+        std::ostream &output;           /**< The stream written to */
+        std::unique_ptr<char[]> buffer; /**< The output buffer */
+        std::size_t capacity;           /**< Size of the output buffer */
+        std::size_t used = 0;           /**< Bytes of the buffer holding unwritten records */
+
+        /**
+         * @brief Hands the buffered records to the output stream and empties the buffer.
+         */
+        void drain();
+    };
+
+    /**
+     * @class TokenPipeReader
+     * @brief Reads tokens in the pipe format from a stream, one at a time.
+     */
+    class TokenPipeReader
+    {
+    public:
+        /**
+         * @brief Reads and checks the header of a token pipe.
+         *
+         * @param input The binary stream to read from; it must outlive the reader.
+         * @throws std::runtime_error if the stream does not start with a token pipe header of a known version.
+         */
+        explicit TokenPipeReader(std::istream &input);
+
+        /**
+         * @brief Reads the next token.
+         *
+         * The token's value views a buffer of the reader, valid until the next call.
+         *
+         * @return The token, or nothing once the end record has been read.
+         * @throws std::runtime_error if the stream ends before the end record or holds an invalid record.
+         */
+        std::optional<Token> next();
+
+    private:
+        std::istream &input;   /**< The stream read from */
+        std::string value;     /**< The value of the last token read */
+        bool finished = false; /**< True once the end record has been read */
+    };
+} // namespace TINY::SCANNER
+
+#endif // TOKEN_PIPE_HPP
@@ -0,0 +1,392 @@
+/**
+ * @file token_stream.hpp
+ * @brief Defines the TokenStream class, a structure-of-arrays container of scanned tokens.
+ *
+ * Instead of one `Token` object per token, the TokenStream keeps one array per field:
+ * types, source offsets and lengths. Token values are not copied, they are views into the
+ * scanned source. Passes that only look at one field, such as searching for unknown tokens,
+ * read a single compact array.
+ *
+ * Line and column numbers are not stored: they are resolved from the token's offset through
+ * a LineIndex of the source, which is built the first time a position is asked for.
+ *
+ * Identifier tokens also carry a dense symbol ID from the stream's SymbolTable, so later
+ * stages can compare and hash names as integers.
+ */
+
+#ifndef TOKEN_STREAM_HPP
+#define TOKEN_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "line_index.hpp"
+#include "symbol_table.hpp"
+#include "token.hpp"
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @class TokenStream
+     * @brief Stores a sequence of tokens as parallel arrays.
+     *
+     * Token `i` is described by `getTypes()[i]`, `getOffsets()[i]` and `getLengths()[i]`; its
+     * value is the `getLengths()[i]` bytes of the source starting at `getOffsets()[i]`. For code
+     * written against `Token`, `operator[]` and the iterators return a lightweight `Row` with the
+     * same accessors.
+     *
+     * A token's line and column are those of the end of its value, as `Scanner` reports them.
+     * They are looked up in the stream's `LineIndex`, which is built from the source on the first
+     * lookup and dropped when the source changes.
+     *
+     * `getSymbols()[i]` is the symbol ID of token `i` if it is an identifier, and
+     * `SymbolTable::NO_SYMBOL` otherwise. Identifiers are interned as they are appended,
+     * and IDs are dense, in order of first appearance.
+     *
+     * @note The TokenStream does not own the source. The source must stay alive and unchanged
+     *       while the values of the tokens are used.
+     *
+     * @note The first position lookup builds the index. Threads may look up positions of a
+     *       shared stream concurrently: the index is published atomically, and threads that race
+     *       to build it all get the one that was published first. Modifying or copying the
+     *       stream while other threads read it is not safe.
+     */
+    class TokenStream
+    {
+    public:
+        /**
+         * @class Row
+         * @brief A read-only view of one token of a TokenStream, with the accessors of `Token`.
+         */
+        class Row
+        {
+        public:
+            /**
+             * @brief Constructs a view of the token at the given index.
+             *
+             * @param stream The stream holding the token.
+             * @param index The index of the token in the stream.
+             */
+            Row(const TokenStream &stream, std::size_t index);
+
+            /**
+             * @brief Gets the type of the token.
+             * @return The token's type.
+             */
+            TokenType getType() const;
+
+            /**
+             * @brief Gets the value of the token, a view into the source.
+             * @return The token's value.
+             */
+            std::string_view getValue() const;
+
+            /**
+             * @brief Gets the line number of the token, from the stream's line index.
+             * @return The line number.
+             */
+            int getLine() const;
+
+            /**
+             * @brief Gets the column number of the token, from the stream's line index.
+             * @return The column number.
+             */
+            int getColumn() const;
+
+            /**
+             * @brief Gets the line and column numbers of the token with a single lookup.
+             * @return The position of the end of the token's value.
+             */
+            SourcePosition getPosition() const;
+
+            /**
+             * @brief Gets the offset of the token's first byte in the source.
+             * @return The source offset.
+             */
+            std::size_t getOffset() const;
+
+            /**
+             * @brief Gets the symbol ID of the token.
+             * @return The symbol ID if the token is an identifier, `SymbolTable::NO_SYMBOL` otherwise.
+             */
+            std::uint32_t getSymbol() const;
+
+            /**
+             * @brief Converts the row to a standalone `Token` that owns a copy of its value.
+             * @return The token.
+             */
+            Token toToken() const;
+
+            /**
+             * @brief Converts the token to a string representation, as `Token::toString()` does.
+             * @param includePosition Whether to include the token position.
+             * @return A string representing the token type and value and optionally its position.
+             */
+            std::string toString(bool includePosition = false) const;
+
+        private:
+            const TokenStream *stream; /**< The stream holding the token */
+            std::size_t index;         /**< The index of the token in the stream */
+        };
+
+        /**
+         * @class const_iterator
+         * @brief Iterates over the tokens of a TokenStream, yielding a `Row` for each.
+         */
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Row;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Row;
+
+            /**
+             * @brief Constructs an iterator at the given index of a stream.
+             *
+             * @param stream The stream to iterate over.
+             * @param index The index of the token the iterator points to.
+             */
+            const_iterator(const TokenStream &stream, std::size_t index);
+
+            /**
+             * @brief Gets the token the iterator points to.
+             * @return A view of the token.
+             */
+            Row operator*() const;
+
+            /**
+             * @brief Moves to the next token.
+             * @return A reference to this iterator.
+             */
+            const_iterator &operator++();
+
+            /**
+             * @brief Moves to the next token.
+             * @return The iterator before the move.
+             */
+            const_iterator operator++(int);
+
+            /**
+             * @brief Checks whether two iterators point to the same token.
+             * @param other The iterator to compare with.
+             * @return True if both point to the same index of the same stream.
+             */
+            bool operator==(const const_iterator &other) const;
+
+            /**
+             * @brief Checks whether two iterators point to different tokens.
+             * @param other The iterator to compare with.
+             * @return True if the iterators differ.
+             */
+            bool operator!=(const const_iterator &other) const;
+
+        private:
+            const TokenStream *stream; /**< The stream iterated over */
+            std::size_t index;         /**< The index of the current token */
+        };
+
+        /**
+         * @brief Constructs an empty TokenStream without a source.
+         */
+        TokenStream() = default;
+
+        /**
+         * @brief Constructs an empty TokenStream over the given source.
+         *
+         * @param source The source the token offsets refer to (borrowed, not copied).
+         */
+        explicit TokenStream(std::string_view source);
+
+        /**
+         * @brief Removes all tokens and sets the source the token offsets refer to.
+         *
+         * @param newSource The new source (borrowed, not copied).
+         * @param newOrigin The offset the tokens start after and its position, the start of the source by default.
+         */
+        void reset(std::string_view newSource, SourcePosition newOrigin = SourcePosition());
+
+        /**
+         * @brief Reserves room for the given number of tokens in every array.
+         * @param count The number of tokens.
+         */
+        void reserve(std::size_t count);
+
+        /**
+         * @brief Appends a token, interning its value if it is an identifier.
+         *
+         * @param type The type of the token.
+         * @param offset The offset of the token's first byte in the source.
+         * @param length The length of the token in bytes.
+         */
+        void push_back(TokenType type, std::size_t offset, std::size_t length);
+
+        /**
+         * @brief Appends all tokens of another stream over the same source.
+         *
+         * The symbols of the other stream are interned into this stream's table and the symbol
+         * IDs of the appended identifiers are translated, so IDs stay dense and ordered by first
+         * appearance, as if the tokens had been appended one by one.
+         *
+         * @param other The stream to append.
+         */
+        void append(const TokenStream &other);
+
+        /**
+         * @brief Replaces a range of tokens with all tokens of another stream over the same source.
+         *
+         * The symbols of the other stream are interned into this stream's table, as in `append()`.
+         * Symbol IDs already handed out do not change; spellings that no longer occur keep their IDs.
+         *
+         * @param first The index of the first token to replace.
+         * @param count The number of tokens to replace; `first + count` must not exceed `size()`.
+         * @param replacement The tokens to put in their place.
+         */
+        void replace(std::size_t first, std::size_t count, const TokenStream &replacement);
+
+        /**
+         * @brief Moves the tokens from an index on by an edit of the source before them.
+         *
+         * Only the offsets change, in one pass over the tokens from `first` on; the positions
+         * follow from the edited source, which is set with `rebind()`.
+         *
+         * @param first The index of the first token to move.
+         * @param offsetDelta The change of the offsets.
+         */
+        void shift(std::size_t first, std::ptrdiff_t offsetDelta);
+
+        /**
+         * @brief Sets the source the token offsets refer to, keeping the tokens.
+         *
+         * The LineIndex of the old source is dropped and rebuilt over the whole new source on
+         * the next position lookup.
+         *
+         * @param newSource The new source (borrowed, not copied); it must hold the value of every
+         *                  token at the token's offset.
+         */
+        void rebind(std::string_view newSource);
+
+        /**
+         * @brief Gets the offset the tokens start after and its line and column numbers.
+         * @return The origin of the positions.
+         */
+        SourcePosition getOrigin() const;
+
+        /**
+         * @brief Gets the line index of the source, building it on the first call.
+         *
+         * Safe to call from several threads at once; the index stays valid until the stream is
+         * modified.
+         *
+         * @return The line index.
+         */
+        const LineIndex &getLineIndex() const;
+
+        /**
+         * @brief Gets the number of tokens.
+         * @return The token count.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Checks whether the stream has no tokens.
+         * @return True if there are no tokens, false otherwise.
+         */
+        bool empty() const;
+
+        /**
+         * @brief Gets a view of the token at the given index.
+         * @param index The index of the token, less than `size()`.
+         * @return A view of the token.
+         */
+        Row operator[](std::size_t index) const;
+
+        /**
+         * @brief Gets an iterator to the first token.
+         * @return The iterator.
+         */
+        const_iterator begin() const;
+
+        /**
+         * @brief Gets an iterator past the last token.
+         * @return The iterator.
+         */
+        const_iterator end() const;
+
+        /**
+         * @brief Gets the source the token offsets refer to.
+         * @return The source.
+         */
+        std::string_view getSource() const;
+
+        /**
+         * @brief Gets the value of the token at the given index, a view into the source.
+         * @param index The index of the token, less than `size()`.
+         * @return The token's value.
+         */
+        std::string_view valueAt(std::size_t index) const;
+
+        /**
+         * @brief Gets the types of all tokens.
+         * @return The type array.
+         */
+        const std::vector<TokenType> &getTypes() const;
+
+        /**
+         * @brief Gets the source offsets of all tokens.
+         * @return The offset array.
+         */
+        const std::vector<std::size_t> &getOffsets() const;
+
+        /**
+         * @brief Gets the lengths of all tokens.
+         * @return The length array.
+         */
+        const std::vector<std::uint32_t> &getLengths() const;
+
+        /**
+         * @brief Gets the symbol IDs of all tokens.
+         * @return The symbol array, `SymbolTable::NO_SYMBOL` for tokens that are not identifiers.
+         */
+        const std::vector<std::uint32_t> &getSymbols() const;
+
+        /**
+         * @brief Gets the table of the identifier spellings.
+         * @return The symbol table.
+         */
+        const SymbolTable &getSymbolTable() const;
+
+        /**
+         * @brief Converts the stream to standalone `Token` objects that own copies of their values.
+         * @return The tokens, in order.
+         */
+        std::vector<Token> toTokens() const;
+
+    private:
+        std::string_view source;                             /**< The scanned source (borrowed) */
+        SourcePosition origin;                               /**< Where scanning started, and its position */
+        std::vector<TokenType> types;                        /**< Type of every token */
+        std::vector<std::size_t> offsets;                    /**< Source offset of every token's first byte */
+        std::vector<std::uint32_t> lengths;                  /**< Length of every token in bytes */
+        std::vector<std::uint32_t> symbols;                  /**< Symbol ID of every token, NO_SYMBOL for non-identifiers */
+        SymbolTable symbolTable;                             /**< The interned identifier spellings */
+        mutable std::shared_ptr<const LineIndex> lineIndex; /**< Line starts of the source, built on first use; read and set atomically */
+    };
+} // namespace TINY::SCANNER
+
+#endif // TOKEN_STREAM_HPP
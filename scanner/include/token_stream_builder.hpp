@@ -8,11 +8,14 @@
 #ifndef TOKEN_STREAM_BUILDER_HPP
 #define TOKEN_STREAM_BUILDER_HPP
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "scanner.hpp"
 #include "token.hpp"
+#include "token_stream.hpp"
 
 /**
  * @namespace TINY::SCANNER
@@ -25,16 +28,38 @@
 namespace TINY::SCANNER
 {
 
+    /**
+     * @struct TokenStreamUpdate
+     * @brief Describes how an incremental update changed a token stream.
+     *
+     * The tokens `[firstToken, firstToken + removedTokens)` of the old stream were replaced by
+     * the tokens `[firstToken, firstToken + insertedTokens)` of the new one; the tokens after
+     * them are the old tokens with shifted positions.
+     */
+    struct TokenStreamUpdate
+    {
+        size_t firstToken = 0;     /**< Index of the first token that was rescanned */
+        size_t removedTokens = 0;  /**< Number of old tokens that were replaced */
+        size_t insertedTokens = 0; /**< Number of new tokens put in their place */
+        size_t rescannedBytes = 0; /**< Number of source bytes scanned again */
+    };
+
     /**
      * @class TokenStreamBuilder
      * @brief Manages the scanning process for TINY language source code.
      *
      * The `TokenStreamBuilder` class orchestrates the tokenization process. It uses the `Scanner`
-     * class to generate tokens and appends them to a vector of tokens for further processing.
+     * class to recognize tokens and appends them to a `TokenStream` for further processing.
+     * The token values are views into the scanner's input, which must outlive the stream.
      */
     class TokenStreamBuilder
     {
     public:
+        /**
+         * @brief Default minimum segment size of `buildParallel()`, in bytes.
+         */
+        static constexpr size_t DEFAULT_MIN_SEGMENT_SIZE = 256 * 1024;
+
         /**
          * @brief Constructs a TokenStreamBuilder object with the given Scanner object.
          *
@@ -51,25 +76,104 @@ namespace TINY::SCANNER
         TokenStreamBuilder(Scanner &scanner);
 
         /**
-         * @brief Tokenizes the input source code and stores the tokens in a vector.
+         * @brief Tokenizes the input source code and stores the tokens in a token stream.
          *
-         * This method processes the input source code using the `Scanner` object to generate tokens.
-         * It appends the generated tokens to an internal vector for further use.
+         * This method processes the input source code using the `Scanner` object to recognize tokens.
+         * It appends the type, source offset and length of each token to an internal `TokenStream`
+         * for further use; line and column numbers are resolved by the stream when asked for. Whitespace and comments are skipped once per token,
+         * without the look-ahead of `Scanner::hasMoreTokens()`.
          */
         void build();
 
         /**
-         * @brief Retrieves the vector of tokens generated from the input source code.
+         * @brief Tokenizes the input source code on several threads.
          *
-         * This method provides access to the vector of tokens generated by the `Scanner`.
+         * The remaining input is split into up to `segmentCount` segments, each ending just after a
+         * newline so no token straddles two segments. A first parallel pass summarizes every segment
+         * by its unmatched '}' and '{' bytes; from these summaries the comment nesting depth at the
+         * start of each segment is resolved in order.
+         * Each segment is then scanned on its own thread, and the per-segment tokens are appended
+         * in order. The result, positions included, is identical to `build()`.
          *
-         * @return A constant reference to the vector of tokens.
+         * Inputs that are too small to give every segment `minSegmentSize` bytes are split into
+         * fewer segments, and inputs containing a '\0' byte (which ends scanning inside a comment)
+         * are tokenized sequentially.
+         *
+         * @param segmentCount The maximum number of segments (and threads); 0 uses the number of hardware threads.
+         * @param minSegmentSize The minimum size of a segment in bytes.
          */
-        const std::vector<Token> &getTokens() const;
+        void buildParallel(size_t segmentCount = 0, size_t minSegmentSize = DEFAULT_MIN_SEGMENT_SIZE);
+
+        /**
+         * @brief Updates the token stream after an edit of the source, rescanning only near the edit.
+         *
+         * The stream must have been built from the start of the old source. Scanning restarts at
+         * the end of the last token that ends before the edit (a token boundary is always outside
+         * comments, and the token's one byte of look-ahead lies before the edit too), and stops at
+         * the first new token that starts at the shifted offset of an old token after the edit:
+         * from there on, the old tokens are still valid and only their positions are shifted.
+         * If no such token is found, the rest of the source is rescanned. The result, positions
+         * and symbol spellings included, is the same as rebuilding the stream from scratch.
+         *
+         * Only the rescan is proportional to the edit. An edit that changes the length of the
+         * source also shifts the offsets of every later token and moves the token arrays after
+         * the replaced tokens, both linear in the number of tokens after the edit (though far
+         * cheaper per token than scanning). Every update drops the stream's LineIndex, so the
+         * next position lookup indexes the whole new source again.
+         *
+         * The scanner is moved to the new source, in the state a `build()` of it would leave.
+         *
+         * @param newSource The source after the edit; it replaces the old source, which is no longer read.
+         * @param offset The offset of the edit.
+         * @param removedLength The number of bytes the edit removed at `offset`.
+         * @param insertedLength The number of bytes the edit inserted at `offset`.
+         * @return Which tokens were replaced.
+         * @throws std::out_of_range if the edit does not fit in the old or the new source.
+         */
+        TokenStreamUpdate update(std::string_view newSource, size_t offset, size_t removedLength, size_t insertedLength);
+
+        /**
+         * @brief Applies an edit to a source string and updates the token stream accordingly.
+         *
+         * Editing the string moves the bytes after the edit unless its length is unchanged.
+         *
+         * @param source The source the stream was built from; the edit is applied to it in place.
+         * @param offset The offset of the edit.
+         * @param removedLength The number of bytes to remove at `offset`.
+         * @param insertedText The text to insert at `offset`.
+         * @return Which tokens were replaced.
+         * @throws std::out_of_range if the edit does not fit in the source.
+         *
+         * @see update
+         */
+        TokenStreamUpdate applyEdit(std::string &source, size_t offset, size_t removedLength, std::string_view insertedText);
+
+        /**
+         * @brief Retrieves the tokens generated from the input source code.
+         *
+         * This method provides access to the token stream generated by the `Scanner`.
+         *
+         * @return A constant reference to the token stream.
+         */
+        const TokenStream &getTokens() const;
 
     private:
-        Scanner &scanner;          /**< The `Scanner` object used for tokenization. */
-        std::vector<Token> tokens; /**< A vector storing the tokens generated from the input source code. */
+        Scanner &scanner;   /**< The `Scanner` object used for tokenization. */
+        TokenStream tokens; /**< The tokens generated from the input source code. */
+
+        /**
+         * @brief Scans the remaining tokens of a scanner into a token stream.
+         *
+         * @param source The scanner to read tokens from.
+         * @param stream The stream to append the tokens to.
+         */
+        static void scanInto(Scanner &source, TokenStream &stream);
+
+        /**
+         * @brief Gets the scanner's current offset with its line and column numbers.
+         * @return The position the stream's tokens are resolved from.
+         */
+        SourcePosition startPosition();
     };
 } // namespace TINY::SCANNER
 
@@ -0,0 +1,146 @@
+/**
+ * @file token_writer.hpp
+ * @brief Defines the TokenWriter class, which writes tokens in the text output format.
+ *
+ * Tokens are formatted straight into a large reusable buffer, with integers converted by
+ * `std::to_chars`, and the buffer is handed to the output stream in one block when it is
+ * full. No temporary strings are created per token and the stream is not flushed per line.
+ */
+
+#ifndef TOKEN_WRITER_HPP
+#define TOKEN_WRITER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string_view>
+
+#include "token.hpp"
+#include "token_stream.hpp"
+
+/**
+ * @namespace TINY::SCANNER
+ * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
+ *
+ * The `TINY::SCANNER` namespace organizes all classes, functions, and utilities
+ * that are specifically responsible for the lexical analysis phase of the TINY programming language.
+ * This includes tokenization, character stream management, and other related components.
+ */
+namespace TINY::SCANNER
+{
+
+    /**
+     * @class TokenWriter
+     * @brief Buffers token lines and writes them to an output stream in large blocks.
+     *
+     * Each token is written as the line `Token::toString()` returns for it, followed by a newline.
+     * The buffered lines reach the stream when the buffer is full, when `flush()` is called and
+     * when the writer is destroyed.
+     *
+     * Example usage:
+     * @code
+     * TokenWriter writer(std::cout);
+     * writer.write(tokens, true);
+     * writer.flush();
+     * @endcode
+     */
+    class TokenWriter
+    {
+    public:
+        /**
+         * @brief Default size of the output buffer in bytes.
+         */
+        static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+        /**
+         * @brief Constructs a writer over an output stream.
+         *
+         * @param output The stream to write to; it must outlive the writer.
+         * @param bufferSize Size of the output buffer in bytes.
+         */
+        explicit TokenWriter(std::ostream &output, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+        TokenWriter(const TokenWriter &) = delete;
+        TokenWriter &operator=(const TokenWriter &) = delete;
+
+        /**
+         * @brief Writes out the buffered lines; errors are ignored, call `flush()` to see them.
+         */
+        ~TokenWriter();
+
+        /**
+         * @brief Writes the line of one token.
+         *
+         * @param type The type of the token.
+         * @param value The value of the token.
+         * @param line The line number of the token.
+         * @param column The column number of the token.
+         * @param includePosition Whether to include the line and column in the line.
+         * @throws std::out_of_range if the token type is invalid.
+         */
+        void write(TokenType type, std::string_view value, int line, int column, bool includePosition = false);
+
+        /**
+         * @brief Writes the line of one token.
+         *
+         * @param token The token to write.
+         * @param includePosition Whether to include the line and column in the line.
+         */
+        void write(const Token &token, bool includePosition = false);
+
+        /**
+         * @brief Writes the lines of every token in a stream.
+         *
+         * @param tokens The tokens to write.
+         * @param includePosition Whether to include the line and column in the lines.
+         */
+        void write(const TokenStream &tokens, bool includePosition = false);
+
+        /**
+         * @brief Writes out the buffered lines and flushes the output stream.
+         *
+         * @throws std::runtime_error if the output stream fails.
+         */
+        void flush();
+
+        /**
+         * @brief Gets an upper bound of the formatted length of a token, without the newline.
+         *
+         * @param valueLength The length of the token's value.
+         * @return The maximum number of characters `format()` writes.
+         */
+        static constexpr std::size_t maxFormattedLength(std::size_t valueLength)
+        {
+            // ", " + longest type name + " [Line: " + int + ", Column: " + int + "]"
+            return valueLength + 2 + 13 + 8 + 11 + 10 + 11 + 1;
+        }
+
+        /**
+         * @brief Formats a token the way `Token::toString()` does, without a newline.
+         *
+         * @param out Destination with room for `maxFormattedLength(value.size())` characters.
+         * @param type The type of the token.
+         * @param value The value of the token.
+         * @param line The line number of the token.
+         * @param column The column number of the token.
+         * @param includePosition Whether to include the line and column.
+         * @return The number of characters written.
+         * @throws std::out_of_range if the token type is invalid.
+         */
+        static std::size_t format(char *out, TokenType type, std::string_view value, int line, int column,
+                                  bool includePosition);
+
+    private:
+        std::ostream &output;            /**< The stream written to */
+        std::unique_ptr<char[]> buffer;  /**< The output buffer */
+        std::size_t capacity;            /**< Size of the output buffer */
+        std::size_t used = 0;            /**< Bytes of the buffer holding unwritten lines */
+
+        /**
+         * @brief Hands the buffered lines to the output stream and empties the buffer.
+         */
+        void drain();
+    };
+} // namespace TINY::SCANNER
+
+#endif // TOKEN_WRITER_HPP
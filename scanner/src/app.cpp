@@ -5,7 +5,7 @@
  * This file contains the implementation of the App class, which is responsible for:
  * - Parsing command-line arguments.
  * - Validating input.
- * - Running the application in interactive or file-based mode.
+ * - Running the application in interactive, file-based or pipe mode.
  * - Processing and printing tokens generated by the scanner.
  *
  * The App class coordinates the overall functionality of the TINY language scanner, providing
@@ -14,9 +14,58 @@
 
 #include "app.hpp"
 
+#include <limits>
+
 namespace TINY::SCANNER
 {
 
+    namespace
+    {
+        // getopt_long values of the options that only have a long form
+        enum LongOnlyOption
+        {
+            STREAM_OPTION = 256,
+            FORMAT_OPTION,
+            BATCH_OPTION,
+            STATS_OPTION,
+            STDIN_OPTION,
+            STDOUT_OPTION,
+            SERVE_OPTION,
+            MAX_ERRORS_OPTION,
+            MAX_TOKEN_LENGTH_OPTION
+        };
+
+        // The server run by --serve, stopped by the signal handler
+        ScanServer *activeServer = nullptr;
+
+        // Stops the active server on SIGINT and SIGTERM
+        void stopActiveServer(int)
+        {
+            if (activeServer != nullptr)
+            {
+                activeServer->stop();
+            }
+        }
+
+        // Parses a whole string as a non-negative decimal number, returns false if it is not one
+        bool parseUnsigned(const std::string &value, size_t &result)
+        {
+            if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+            {
+                return false;
+            }
+            try
+            {
+                result = static_cast<size_t>(std::stoull(value));
+            }
+            catch (const std::out_of_range &)
+            {
+                return false;
+            }
+            return true;
+        }
+    } // namespace
+
     App::App(int argc, char *argv[])
     {
         parseArgs(argc, argv);
@@ -29,31 +78,83 @@ namespace TINY::SCANNER
             return;
         }
 
-        if (interactiveMode)
+        // the wall clock of the run starts here, not when the arguments were parsed
+        stats = RunStats();
+        diagnostics = Diagnostics(maxErrors);
+
+        // the errors still pending and their count are reported however the run ends, after the
+        // writers of the mode have written out the tokens found before them
+        try
+        {
+            if (interactiveMode)
+            {
+                runInteractiveMode();
+            }
+            else if (!batchPattern.empty())
+            {
+                runBatchMode();
+            }
+            else if (!serveSocketPath.empty())
+            {
+                runServeMode();
+            }
+            else if (readStdin || writeStdout)
+            {
+                runPipeMode();
+            }
+            else if (streamMode)
+            {
+                runStreamMode();
+            }
+            else
+            {
+                runFileMode();
+            }
+        }
+        catch (...)
         {
-            runInteractiveMode();
+            reportDiagnostics();
+            throw;
         }
-        else
+        reportDiagnostics();
+
+        if (showStats)
         {
-            runFileMode();
+            printStats();
         }
     }
 
     void App::runInteractiveMode()
     {
-        // while loop to read input from user until terminateKeyword is entered
-        std::string input;
-        std::string inputContent;
+        // open the output file up front, every line is tokenized and written as soon as it is entered
+        std::ofstream outputFile;
+        if (hasOutputFile)
+        {
+            outputFile = FileHandler::openOutputFile(outputFilePath, binaryOutput);
+        }
+        TokenOutputs outputs;
+        openOutputs(outputs, hasOutputFile ? &outputFile : nullptr);
+
         // set color to green
         std::cout << "\033[1;32m";
         std::cout << "Enter TINY code (type '" << terminateKeyword << "' to finish):\n";
         // reset color
         std::cout << "\033[0m";
-
-        while (true)
+        if (showOutput)
         {
-            std::getline(std::cin, input);
+            printTokensHeader();
+        }
+
+        size_t tokenCount = 0;
+        StreamScanner scanner(makeTokenHandler(outputs, tokenCount), maxTokenLength);
 
+        // a newline ends every token, so each line's tokens are complete once the line is fed;
+        // the scanner keeps its state between lines, so a comment may span several of them
+        std::string input;
+        size_t bytesRead = 0;
+        auto streamStart = RunStats::Clock::now();
+        while (std::getline(std::cin, input))
+        {
             if (input == terminateKeyword)
             {
                 // set color to light green
@@ -64,10 +165,41 @@ namespace TINY::SCANNER
                 break;
             }
 
-            inputContent += input + "\n";
+            input += '\n';
+            bytesRead += input.size();
+            scanner.feed(input);
+            outputs.flush();
+            // the errors of the line follow its tokens
+            diagnostics.flush(std::cerr);
+        }
+        scanner.finish();
+        stats.addPhase("stream", streamStart, bytesRead, tokenCount);
+        stats.setTotals(bytesRead, tokenCount);
+
+        auto writeStart = RunStats::Clock::now();
+        outputs.finish();
+        stats.addPhase("write", writeStart, bytesRead, tokenCount);
+
+        if (hasOutputFile)
+        {
+            // set color to orange
+            std::cout << "\033[1;33m";
+            std::cout << "Tokens written to file: " << outputFilePath << std::endl;
+            // reset color
+            std::cout << "\033[0m";
+        }
+
+        // Empty input
+        if (bytesRead == 0)
+        {
+            throw std::invalid_argument("Input is empty");
         }
 
-        processTokens(inputContent);
+        // if no tokens are generated, throw an exception
+        if (tokenCount == 0)
+        {
+            throw std::runtime_error("No tokens generated. Please check the input.");
+        }
     }
 
     void App::runFileMode()
@@ -79,12 +211,309 @@ namespace TINY::SCANNER
         // reset color
         std::cout << "\033[0m";
 
-        std::string inputFileContent = FileHandler::readFile(inputFilePath);
+        // map the input file instead of reading it, the scanner works on the mapping directly;
+        // its pages are only read in while scanning, so that is where the read time shows up
+        auto readStart = RunStats::Clock::now();
+        MappedFile inputFile = FileHandler::mapFile(inputFilePath);
+        stats.addPhase("read", readStart, inputFile.view().size(), 0);
+
+        processTokens(inputFile.view());
+    }
+
+    void App::runStreamMode()
+    {
+        // set color to orange
+        std::cout << "\033[1;33m";
+        std::cout << "Streaming input file: " << inputFilePath << std::endl;
+        // reset color
+        std::cout << "\033[0m";
+
+        std::ifstream inputFile = FileHandler::openInputFile(inputFilePath);
+
+        // open the output file up front, tokens are written as soon as they are scanned
+        std::ofstream outputFile;
+        if (hasOutputFile)
+        {
+            // set color to orange
+            std::cout << "\033[1;33m";
+            std::cout << "Writing to file: " << outputFilePath << std::endl;
+            // reset color
+            std::cout << "\033[0m";
+
+            outputFile = FileHandler::openOutputFile(outputFilePath, binaryOutput);
+        }
+
+        // binary output uses the token pipe format, so nothing is held until the scan ends
+        TokenOutputs outputs;
+        openOutputs(outputs, hasOutputFile ? &outputFile : nullptr);
+        if (showOutput)
+        {
+            printTokensHeader();
+        }
+
+        size_t tokenCount = 0;
+        StreamScanner scanner(makeTokenHandler(outputs, tokenCount), maxTokenLength);
+
+        // read and scan the file one buffer at a time; reading, scanning and writing interleave,
+        // so they are timed as one phase
+        auto streamStart = RunStats::Clock::now();
+        size_t bytesRead = scanner.scan(inputFile, streamBufferSize);
+        stats.addPhase("stream", streamStart, bytesRead, tokenCount);
+        stats.setTotals(bytesRead, tokenCount);
+
+        auto writeStart = RunStats::Clock::now();
+        outputs.finish();
+        stats.addPhase("write", writeStart, bytesRead, tokenCount);
+
+        // reset color
+        std::cout << "\033[0m";
+
+        // Empty input file content
+        if (bytesRead == 0)
+        {
+            throw std::invalid_argument("Input file is empty");
+        }
+
+        // if no tokens are generated, throw an exception
+        if (tokenCount == 0)
+        {
+            throw std::runtime_error("No tokens generated. Please check the input file.");
+        }
+    }
+
+    void App::runPipeMode()
+    {
+        // when the standard output carries the tokens, nothing else may be printed to it
+        std::ifstream inputFile;
+        if (!readStdin)
+        {
+            inputFile = FileHandler::openInputFile(inputFilePath);
+        }
+        std::ofstream outputFile;
+        if (hasOutputFile)
+        {
+            outputFile = FileHandler::openOutputFile(outputFilePath, binaryOutput);
+        }
+        std::ostream &output = writeStdout ? std::cout : outputFile;
+
+        // binary output uses the token pipe format, which needs no seeking; the pipe and text
+        // writers keep a bounded buffer that is handed on after every chunk of input
+        TokenOutputs outputs;
+        openOutputs(outputs, &output, TokenPipeWriter::DEFAULT_BUFFER_SIZE);
+        if (showOutput)
+        {
+            printTokensHeader();
+        }
+
+        size_t tokenCount = 0;
+        StreamScanner scanner(makeTokenHandler(outputs, tokenCount), maxTokenLength);
+
+        // scan each chunk as soon as it arrives and pass its tokens on before waiting for the next,
+        // so memory stays bounded by the buffers and the next program in the pipeline never waits
+        // for more than one chunk
+        std::vector<char> buffer(streamBufferSize);
+        size_t bytesRead = 0;
+        auto streamStart = RunStats::Clock::now();
+        while (true)
+        {
+            size_t count = 0;
+            if (readStdin)
+            {
+                count = FileHandler::readStandardInput(buffer.data(), buffer.size());
+            }
+            else if (inputFile.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || inputFile.gcount() > 0)
+            {
+                count = static_cast<size_t>(inputFile.gcount());
+            }
+            if (count == 0)
+            {
+                break;
+            }
+
+            scanner.feed(std::string_view(buffer.data(), count));
+            bytesRead += count;
+            outputs.flush();
+            // the errors of the chunk follow its tokens
+            diagnostics.flush(std::cerr);
+        }
+        scanner.finish();
+        stats.addPhase("stream", streamStart, bytesRead, tokenCount);
+        stats.setTotals(bytesRead, tokenCount);
+
+        auto writeStart = RunStats::Clock::now();
+        outputs.finish();
+        stats.addPhase("write", writeStart, bytesRead, tokenCount);
+
+        // Empty input
+        if (bytesRead == 0)
+        {
+            throw std::invalid_argument("Input is empty");
+        }
+
+        // if no tokens are generated, throw an exception
+        if (tokenCount == 0)
+        {
+            throw std::runtime_error("No tokens generated. Please check the input.");
+        }
+    }
+
+    void App::openOutputs(TokenOutputs &outputs, std::ostream *output, size_t bufferSize)
+    {
+        // binary tokens use the pipe format, whose memory stays bounded, not the token file format
+        if (output != nullptr && binaryOutput)
+        {
+            outputs.pipeWriter.emplace(*output);
+        }
+        else if (output != nullptr)
+        {
+            outputs.textWriter.emplace(*output, bufferSize);
+        }
+        if (showOutput)
+        {
+            outputs.consoleWriter.emplace(std::cout, bufferSize);
+        }
+    }
+
+    StreamScanner::TokenHandler App::makeTokenHandler(TokenOutputs &outputs, size_t &tokenCount)
+    {
+        return [this, &outputs, &tokenCount](const Token &token)
+        {
+            ++tokenCount;
+
+            // a full batch of errors is written after the tokens printed before it
+            if (token.getType() == TokenType::UNKNOWN && reportUnknownToken(token.getValue(), token.getLine(), token.getColumn()))
+            {
+                if (outputs.consoleWriter)
+                {
+                    outputs.consoleWriter->flush();
+                }
+                diagnostics.flush(std::cerr);
+            }
+
+            outputs.write(token, includeTokenPosition);
+        };
+    }
+
+    void App::TokenOutputs::write(const Token &token, bool includePosition)
+    {
+        if (pipeWriter)
+        {
+            pipeWriter->write(token);
+        }
+        else if (textWriter)
+        {
+            textWriter->write(token, includePosition);
+        }
+        if (consoleWriter)
+        {
+            consoleWriter->write(token, includePosition);
+        }
+    }
+
+    void App::TokenOutputs::flush()
+    {
+        if (pipeWriter)
+        {
+            pipeWriter->flush();
+        }
+        else if (textWriter)
+        {
+            textWriter->flush();
+        }
+        if (consoleWriter)
+        {
+            consoleWriter->flush();
+        }
+    }
+
+    void App::TokenOutputs::finish()
+    {
+        if (pipeWriter)
+        {
+            pipeWriter->finish();
+        }
+        else if (textWriter)
+        {
+            textWriter->flush();
+        }
+        if (consoleWriter)
+        {
+            consoleWriter->flush();
+        }
+    }
+
+    void App::runServeMode()
+    {
+        ScanServer server(serveSocketPath, jobs);
+
+        // a signal lets the running requests finish, then the socket file is removed
+        activeServer = &server;
+        std::signal(SIGINT, stopActiveServer);
+        std::signal(SIGTERM, stopActiveServer);
+#if defined(__unix__) || defined(__APPLE__)
+        std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+        // set color to Orange
+        std::cout << "\033[1;33m";
+        std::cout << "Serving on " << server.getSocketPath() << " with " << server.threadCount()
+                  << " threads, press Ctrl+C to stop" << std::endl;
+        // reset color
+        std::cout << "\033[0m";
+
+        try
+        {
+            server.run();
+        }
+        catch (...)
+        {
+            activeServer = nullptr;
+            throw;
+        }
+        activeServer = nullptr;
+        std::signal(SIGINT, SIG_DFL);
+        std::signal(SIGTERM, SIG_DFL);
 
-        processTokens(inputFileContent);
+        std::cout << "\033[1;33m" << "Server stopped" << "\033[0m" << std::endl;
     }
 
-    void App::processTokens(std::string &inputFileContent)
+    void App::runBatchMode()
+    {
+        // set color to orange
+        std::cout << "\033[1;33m";
+        std::cout << "Scanning batch: " << batchPattern << std::endl;
+        // reset color
+        std::cout << "\033[0m";
+
+        BatchScanner batch(batchPattern);
+
+        // set color to orange
+        std::cout << "\033[1;33m";
+        std::cout << "Input files: " << batch.getInputs().size() << ", writing to: " << outputFilePath << std::endl;
+        // reset color
+        std::cout << "\033[0m";
+
+        auto batchStart = RunStats::Clock::now();
+        BatchReport report = batch.run(outputFilePath, jobs, includeTokenPosition, binaryOutput);
+        stats.addPhase("batch", batchStart, report.totalBytes(), report.totalTokens());
+        stats.setTotals(report.totalBytes(), report.totalTokens());
+
+        // set color to Green
+        std::cout << "\033[1;32m";
+        std::cout << "----------------------------Batch report:----------------------------\n";
+        // reset color
+        std::cout << "\033[0m";
+        report.print(std::cout);
+
+        // failed files make the whole run fail, after every other file was written
+        if (report.failedFiles() > 0)
+        {
+            throw std::runtime_error(std::to_string(report.failedFiles()) + " of " + std::to_string(report.files.size()) +
+                                     " files failed.");
+        }
+    }
+
+    void App::processTokens(std::string_view inputFileContent)
     {
         // Empty input file content
         if (inputFileContent.empty())
@@ -99,9 +528,19 @@ namespace TINY::SCANNER
         // initialize tokenStreamBuilder
         TokenStreamBuilder tokenStreamBuilder(scanner);
 
-        // build token stream
-        tokenStreamBuilder.build();
-        std::vector<Token> tokens = tokenStreamBuilder.getTokens();
+        // build token stream, splitting it across threads if more than one job is requested
+        auto scanStart = RunStats::Clock::now();
+        if (jobs == 1)
+        {
+            tokenStreamBuilder.build();
+        }
+        else
+        {
+            tokenStreamBuilder.buildParallel(jobs);
+        }
+        const TokenStream &tokens = tokenStreamBuilder.getTokens();
+        stats.addPhase("scan", scanStart, inputFileContent.size(), tokens.size());
+        stats.setTotals(inputFileContent.size(), tokens.size());
 
         // if no tokens are generated, throw an exception
         if (tokens.empty())
@@ -110,7 +549,9 @@ namespace TINY::SCANNER
         }
 
         // any unknown tokens printed as errors to the console
+        auto checkStart = RunStats::Clock::now();
         catchUnkonwnTokens(tokens);
+        stats.addPhase("check", checkStart, inputFileContent.size(), tokens.size());
 
         // write tokens to output file if specified
         if (hasOutputFile)
@@ -121,57 +562,95 @@ namespace TINY::SCANNER
             // reset color
             std::cout << "\033[0m";
 
-            FileHandler::writeTokens(outputFilePath, tokens, includeTokenPosition);
+            auto writeStart = RunStats::Clock::now();
+            if (binaryOutput)
+            {
+                FileHandler::writeBinaryTokens(outputFilePath, tokens);
+            }
+            else
+            {
+                FileHandler::writeTokens(outputFilePath, tokens, includeTokenPosition);
+            }
+            stats.addPhase("write", writeStart, inputFileContent.size(), tokens.size());
         }
 
         // if showOutput is true, print tokens to console
         if (showOutput)
         {
+            auto printStart = RunStats::Clock::now();
             printTokens(tokens, includeTokenPosition);
+            stats.addPhase("print", printStart, inputFileContent.size(), tokens.size());
         }
     }
 
-    void App::catchUnkonwnTokens(std::vector<TINY::SCANNER::Token> &tokens)
+    void App::catchUnkonwnTokens(const TokenStream &tokens)
     {
-        bool hasUnknownTokens = false;
-        for (const Token &token : tokens)
+        // only the one-byte type array is read, the other fields only for unknown tokens
+        const std::vector<TokenType> &types = tokens.getTypes();
+        for (size_t i = 0; i < types.size(); ++i)
         {
-            if (token.getType() == TokenType::UNKNOWN)
+            if (types[i] == TokenType::UNKNOWN)
             {
-                // for the first unknown token, set color to red
-                if (!hasUnknownTokens)
+                TokenStream::Row token = tokens[i];
+                if (reportUnknownToken(token.getValue(), token.getLine(), token.getColumn()))
                 {
-                    hasUnknownTokens = true;
-                    // set color to red
-                    std::cout << "\033[1;31m";
-                    std::cerr << "The input contains unexpected tokens, please check the input file."
-                              << std::endl
-                              << "List of unexpected tokens:"
-                              << std::endl;
+                    diagnostics.flush(std::cerr);
                 }
-
-                std::cerr << "-\tError: unexpected token '" << token.getValue()
-                          << "' at line " << token.getLine()
-                          << ", column " << token.getColumn()
-                          << std::endl;
             }
         }
+        // the errors are listed before the tokens are written or printed
+        diagnostics.flush(std::cerr);
+    }
+
+    bool App::reportUnknownToken(std::string_view value, int line, int column)
+    {
+        // past the limit the run is abandoned; run() writes the recorded errors and their count
+        if (diagnostics.report(value, line, column))
+        {
+            throw std::runtime_error("Too many unexpected tokens, stopped after " + std::to_string(maxErrors) + ".");
+        }
+        return diagnostics.isBatchFull();
+    }
+
+    void App::reportDiagnostics()
+    {
+        diagnostics.flush(std::cerr);
+        diagnostics.printSummary(std::cerr);
+    }
+
+    void App::printStats()
+    {
+        if (statsJson)
+        {
+            stats.printJson(std::cerr);
+            return;
+        }
+
+        // set color to Green
+        std::cerr << "\033[1;32m";
+        std::cerr << "----------------------------Stats:----------------------------\n";
         // reset color
-        std::cout << "\033[0m";
+        std::cerr << "\033[0m";
+        stats.print(std::cerr);
     }
 
-    void App::printTokens(const std::vector<Token> &tokens, bool includePosition)
+    void App::printTokens(const TokenStream &tokens, bool includePosition)
+    {
+        printTokensHeader();
+
+        // lines are written in large blocks instead of flushing the console per token
+        TokenWriter writer(std::cout);
+        writer.write(tokens, includePosition);
+        writer.flush();
+    }
+
+    void App::printTokensHeader()
     {
         // set color to Green
         std::cout << "\033[1;32m";
         std::cout << "----------------------------Tokens:----------------------------\n";
         // reset color
         std::cout << "\033[0m";
-
-        for (const Token &token : tokens)
-        {
-            std::cout << token.toString(includePosition) << std::endl;
-        }
     }
 
     void App::printHelp()
@@ -186,12 +665,35 @@ namespace TINY::SCANNER
                   << "  -p, --include-token-position    Include token position in output\n"
                   << "  -t, --terminate-keyword <kw>    Termination keyword for interactive mode\n"
                   << "  -d, --default-output            Save to a default output file if not specified\n"
+                  << "  -j, --jobs <n>                  Tokenize the input file on n threads (0 = all cores)\n"
+                  << "      --stream[=<bytes>]          Scan the input file in fixed-size buffers (default 65536 bytes)\n"
+                  << "      --max-token-length <bytes>  Reject longer tokens in the streaming modes (--stream, --stdin,\n"
+                  << "                                  --stdout, interactive; default 1048576, 0 = no limit); the\n"
+                  << "                                  other modes read the whole input and take any length\n"
+                  << "      --format=<format>           Output file format (text, binary; default text); binary is a\n"
+                  << "                                  token file, or a token pipe with --stream, --stdin, --stdout\n"
+                  << "                                  or interactive mode, whose memory must stay bounded\n"
+                  << "      --batch <dir|glob>          Tokenize every matching file, -o sets the output directory\n"
+                  << "      --stats[=<format>]          Report phase timings, throughput and peak memory (text, json)\n"
+                  << "      --stdin                     Read the source from the standard input ('-' as input file)\n"
+                  << "      --stdout                    Write the tokens to the standard output ('-' as output file)\n"
+                  << "      --serve <socket>            Answer scan requests on a Unix socket, -j sets the worker count\n"
+                  << "      --max-errors <n>            Stop after n unexpected tokens (0 = no limit, the default)\n"
                   << "\n"
                   << "Examples:\n"
                   << "  scanner input.txt output.txt\n"
                   << "  scanner -i input.txt -o output.txt --show-output\n"
                   << "  scanner --mode interactive\n"
-                  << "  scanner input.txt --show-output\n";
+                  << "  scanner input.txt --show-output\n"
+                  << "  scanner --stream big.tny output.txt\n"
+                  << "  scanner -j 8 big.tny output.txt\n"
+                  << "  scanner --format=binary input.txt tokens.bin\n"
+                  << "  scanner --batch 'src/**/*.tny' -o tokens -j 8\n"
+                  << "  scanner --stats=json big.tny output.txt\n"
+                  << "  tiny-gen -n 1G | scanner - --format=binary | consumer\n"
+                  << "  cat input.txt | scanner --stdin --stdout -p\n"
+                  << "  scanner --serve /tmp/scanner.sock -j 8\n"
+                  << "  scanner --max-errors 20 --stream suspect.tny\n";
     }
 
     void App::parseArgs(int argc, char *argv[])
@@ -206,6 +708,16 @@ namespace TINY::SCANNER
             {"include-token-position", no_argument, 0, 'p'},
             {"terminate-keyword", required_argument, 0, 't'},
             {"default-output", no_argument, 0, 'd'},
+            {"jobs", required_argument, 0, 'j'},
+            {"stream", optional_argument, 0, STREAM_OPTION},
+            {"format", required_argument, 0, FORMAT_OPTION},
+            {"batch", required_argument, 0, BATCH_OPTION},
+            {"stats", optional_argument, 0, STATS_OPTION},
+            {"stdin", no_argument, 0, STDIN_OPTION},
+            {"stdout", no_argument, 0, STDOUT_OPTION},
+            {"serve", required_argument, 0, SERVE_OPTION},
+            {"max-errors", required_argument, 0, MAX_ERRORS_OPTION},
+            {"max-token-length", required_argument, 0, MAX_TOKEN_LENGTH_OPTION},
             {0, 0, 0, 0} // Terminate the option array
         };
 
@@ -213,7 +725,7 @@ namespace TINY::SCANNER
         int c;
 
         // parse options
-        while ((c = getopt_long(argc, argv, "hi:o:m:t:spd", long_options, &option_index)) != -1)
+        while ((c = getopt_long(argc, argv, "hi:o:m:t:j:spd", long_options, &option_index)) != -1)
         {
             switch (c)
             {
@@ -264,6 +776,52 @@ namespace TINY::SCANNER
                 hasOutputFile = true;
                 break;
 
+            case 'j':
+                jobs = parseJobCount(optarg);
+                jobsSet = true;
+                break;
+
+            case STREAM_OPTION:
+                streamMode = true;
+                if (optarg != nullptr)
+                {
+                    streamBufferSize = parseBufferSize(optarg);
+                }
+                break;
+
+            case FORMAT_OPTION:
+                binaryOutput = parseOutputFormat(optarg);
+                break;
+
+            case BATCH_OPTION:
+                batchPattern = optarg;
+                break;
+
+            case STATS_OPTION:
+                showStats = true;
+                statsJson = optarg != nullptr && parseStatsFormat(optarg);
+                break;
+
+            case STDIN_OPTION:
+                readStdin = true;
+                break;
+
+            case STDOUT_OPTION:
+                writeStdout = true;
+                break;
+
+            case SERVE_OPTION:
+                serveSocketPath = optarg;
+                break;
+
+            case MAX_ERRORS_OPTION:
+                maxErrors = parseErrorLimit(optarg);
+                break;
+
+            case MAX_TOKEN_LENGTH_OPTION:
+                maxTokenLength = parseTokenLengthLimit(optarg);
+                break;
+
             case '?':
                 throw std::invalid_argument("Invalid option specified, use -h or --help for usage information.");
                 break;
@@ -277,6 +835,72 @@ namespace TINY::SCANNER
         defaultActions();
     }
 
+    size_t App::parseBufferSize(const std::string &value)
+    {
+        size_t size = 0;
+        if (!parseUnsigned(value, size) || size == 0)
+        {
+            throw std::invalid_argument("Invalid buffer size '" + value + "', use a positive number of bytes.");
+        }
+        return size;
+    }
+
+    size_t App::parseJobCount(const std::string &value)
+    {
+        size_t count = 0;
+        if (!parseUnsigned(value, count))
+        {
+            throw std::invalid_argument("Invalid job count '" + value + "', use a number of threads (0 = all cores).");
+        }
+        return count;
+    }
+
+    size_t App::parseErrorLimit(const std::string &value)
+    {
+        size_t limit = 0;
+        if (!parseUnsigned(value, limit))
+        {
+            throw std::invalid_argument("Invalid error limit '" + value + "', use a number of errors (0 = no limit).");
+        }
+        return limit;
+    }
+
+    size_t App::parseTokenLengthLimit(const std::string &value)
+    {
+        size_t limit = 0;
+        if (!parseUnsigned(value, limit))
+        {
+            throw std::invalid_argument("Invalid token length limit '" + value + "', use a number of bytes (0 = no limit).");
+        }
+        return limit == 0 ? std::numeric_limits<size_t>::max() : limit;
+    }
+
+    bool App::parseOutputFormat(const std::string &value)
+    {
+        if (value == "binary")
+        {
+            return true;
+        }
+        if (value != "text")
+        {
+            throw std::invalid_argument("Invalid output format '" + value + "', use 'text' or 'binary'.");
+        }
+        return false;
+    }
+
+    bool App::parseStatsFormat(const std::string &value)
+    {
+        if (value == "json")
+        {
+            return true;
+        }
+        if (value != "text")
+        {
+            throw std::invalid_argument("Invalid stats format '" + value + "', use 'text' or 'json'.");
+        }
+        return false;
+    }
+
     void App::handlePositionalArgs(int argc, char *argv[])
     {
         std::vector<std::string> positionalArgs;
@@ -303,6 +927,81 @@ namespace TINY::SCANNER
 
     void App::defaultActions()
     {
+        // "-" as the input or output file names the standard stream
+        if (inputFilePath == "-")
+        {
+            readStdin = true;
+            inputFilePath.clear();
+        }
+        if (hasOutputFile && outputFilePath == "-")
+        {
+            writeStdout = true;
+            hasOutputFile = false;
+            outputFilePath.clear();
+        }
+
+        // a server takes its sources from its clients, and uses every core unless told otherwise
+        if (!serveSocketPath.empty() && !showHelp)
+        {
+            if (interactiveMode || !batchPattern.empty() || readStdin || writeStdout ||
+                !inputFilePath.empty() || hasOutputFile)
+            {
+                throw std::invalid_argument("--serve cannot be combined with input or output files, batch, interactive or pipe mode.");
+            }
+            if (!jobsSet)
+            {
+                jobs = 0;
+            }
+            return;
+        }
+
+        // in pipe mode the source comes from the standard input or the tokens go to the standard output
+        if ((readStdin || writeStdout) && !showHelp)
+        {
+            if (interactiveMode || !batchPattern.empty())
+            {
+                throw std::invalid_argument("--stdin and --stdout cannot be combined with batch or interactive mode.");
+            }
+            if (readStdin && !inputFilePath.empty())
+            {
+                throw std::invalid_argument("--stdin cannot be combined with an input file.");
+            }
+            if (writeStdout && hasOutputFile)
+            {
+                throw std::invalid_argument("--stdout cannot be combined with an output file.");
+            }
+            if (!readStdin && inputFilePath.empty())
+            {
+                throw std::invalid_argument("Input file not specified, use -h or --help for usage information.");
+            }
+
+            // the tokens go to the standard output unless a file was named; showing them there too is redundant
+            if (!hasOutputFile)
+            {
+                writeStdout = true;
+            }
+            if (writeStdout)
+            {
+                showOutput = false;
+            }
+            return;
+        }
+
+        // in batch mode the input files come from the pattern and the output path is a directory
+        if (!batchPattern.empty() && !showHelp)
+        {
+            if (interactiveMode || !inputFilePath.empty())
+            {
+                throw std::invalid_argument("--batch cannot be combined with an input file or interactive mode.");
+            }
+            if (!hasOutputFile)
+            {
+                outputFilePath = DEFAULT_BATCH_OUTPUT_DIRECTORY;
+                hasOutputFile = true;
+            }
+            return;
+        }
+
         // if no input file specified, and not in interactive mode, and not showing help, throw an exception
         if (inputFilePath.empty() && !interactiveMode && !showHelp)
         {
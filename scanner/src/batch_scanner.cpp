@@ -0,0 +1,385 @@
+/**
+ * @file batch_scanner.cpp
+ * @brief Implements the BatchScanner class and the formatting of its report.
+ *
+ * The inputs are collected and the output directories created up front, on the calling
+ * thread. Every file then becomes one task on a ThreadPool that fills in its own slot of
+ * the report, so the workers share nothing but the pool's queues.
+ */
+
+#include "batch_scanner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "file_handler.hpp"
+#include "scanner.hpp"
+#include "thread_pool.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Whether a path component contains glob wildcards
+        bool hasWildcard(std::string_view component)
+        {
+            return component.find_first_of("*?") != std::string_view::npos;
+        }
+
+        // Formats a byte count with a binary unit
+        std::string formatBytes(double bytes)
+        {
+            const char *units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+            size_t unit = 0;
+            while (bytes >= 1024 && unit + 1 < sizeof(units) / sizeof(units[0]))
+            {
+                bytes /= 1024;
+                ++unit;
+            }
+            std::ostringstream text;
+            text << std::fixed << std::setprecision(unit == 0 ? 0 : 1) << bytes << ' ' << units[unit];
+            return text.str();
+        }
+    } // namespace
+
+    // ---------------------------------------------------------------------
+    // BatchReport
+    // ---------------------------------------------------------------------
+
+    // Counts the files that failed
+    std::size_t BatchReport::failedFiles() const
+    {
+        return static_cast<std::size_t>(std::count_if(files.begin(), files.end(), [](const BatchFileResult &file)
+                                                      { return !file.error.empty(); }));
+    }
+
+    // Sums the sizes of the input files
+    std::size_t BatchReport::totalBytes() const
+    {
+        std::size_t total = 0;
+        for (const BatchFileResult &file : files)
+        {
+            total += file.bytes;
+        }
+        return total;
+    }
+
+    // Sums the token counts
+    std::size_t BatchReport::totalTokens() const
+    {
+        std::size_t total = 0;
+        for (const BatchFileResult &file : files)
+        {
+            total += file.tokens;
+        }
+        return total;
+    }
+
+    // Sums the unknown token counts
+    std::size_t BatchReport::totalUnknownTokens() const
+    {
+        std::size_t total = 0;
+        for (const BatchFileResult &file : files)
+        {
+            total += file.unknownTokens;
+        }
+        return total;
+    }
+
+    // Prints the totals, then the failed files, then the slowest files
+    void BatchReport::print(std::ostream &out, std::size_t slowestCount) const
+    {
+        // the numbers are printed in fixed notation, the stream's own format is restored at the end
+        std::ios_base::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+
+        std::size_t bytes = totalBytes();
+        out << "Files:          " << files.size() << " (" << failedFiles() << " failed)\n"
+            << "Input:          " << formatBytes(static_cast<double>(bytes)) << "\n"
+            << "Tokens:         " << totalTokens() << " (" << totalUnknownTokens() << " unknown)\n"
+            << "Time:           " << std::fixed << std::setprecision(3) << seconds << " s on " << threads
+            << (threads == 1 ? " thread" : " threads");
+        if (seconds > 0)
+        {
+            out << " (" << formatBytes(static_cast<double>(bytes) / seconds) << "/s)";
+        }
+        out << "\n";
+
+        if (failedFiles() > 0)
+        {
+            out << "Errors:\n";
+            for (const BatchFileResult &file : files)
+            {
+                if (!file.error.empty())
+                {
+                    out << "-\t" << file.inputPath << ": " << file.error << "\n";
+                }
+            }
+        }
+
+        // the slowest files, slowest first
+        std::vector<const BatchFileResult *> slowest;
+        slowest.reserve(files.size());
+        for (const BatchFileResult &file : files)
+        {
+            slowest.push_back(&file);
+        }
+        slowestCount = std::min(slowestCount, slowest.size());
+        std::partial_sort(slowest.begin(), slowest.begin() + static_cast<std::ptrdiff_t>(slowestCount), slowest.end(),
+                          [](const BatchFileResult *a, const BatchFileResult *b)
+                          { return a->seconds > b->seconds; });
+
+        if (slowestCount > 0)
+        {
+            out << "Slowest files:\n";
+            for (std::size_t i = 0; i < slowestCount; ++i)
+            {
+                out << "-\t" << slowest[i]->inputPath << ": " << std::fixed << std::setprecision(3)
+                    << slowest[i]->seconds * 1000 << " ms, " << formatBytes(static_cast<double>(slowest[i]->bytes)) << "\n";
+            }
+        }
+
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    // ---------------------------------------------------------------------
+    // BatchScanner
+    // ---------------------------------------------------------------------
+
+    // Constructor: Splits the pattern into a base directory and a relative pattern, then collects the matches
+    BatchScanner::BatchScanner(const std::string &pattern)
+    {
+        namespace fs = std::filesystem;
+
+        std::string relativePattern;
+        if (fs::is_directory(pattern))
+        {
+            baseDirectory = pattern;
+            relativePattern = "**";
+        }
+        else
+        {
+            // the base directory ends before the first component with a wildcard
+            std::string generic = fs::path(pattern).generic_string();
+            std::size_t componentStart = 0;
+            while (componentStart <= generic.size())
+            {
+                std::size_t componentEnd = std::min(generic.find('/', componentStart), generic.size());
+                if (hasWildcard(std::string_view(generic).substr(componentStart, componentEnd - componentStart)))
+                {
+                    break;
+                }
+                componentStart = componentEnd + 1;
+            }
+
+            if (componentStart > generic.size())
+            {
+                // no wildcards: a single file
+                baseDirectory = fs::path(generic).parent_path();
+                relativePattern = fs::path(generic).filename().generic_string();
+            }
+            else
+            {
+                baseDirectory = generic.substr(0, componentStart);
+                relativePattern = generic.substr(componentStart);
+            }
+        }
+        if (baseDirectory.empty())
+        {
+            baseDirectory = ".";
+        }
+        else if (!baseDirectory.has_filename() && baseDirectory.has_relative_path())
+        {
+            // drop a trailing separator, so the inputs are relative to the directory itself
+            baseDirectory = baseDirectory.parent_path();
+        }
+
+        // only descend into subdirectories when the pattern can match below the base directory
+        if (fs::is_directory(baseDirectory))
+        {
+            auto collect = [&](const fs::directory_entry &entry)
+            {
+                if (entry.is_regular_file())
+                {
+                    fs::path relative = entry.path().lexically_relative(baseDirectory);
+                    if (matchPattern(relativePattern, relative.generic_string()))
+                    {
+                        inputs.push_back(relative);
+                    }
+                }
+            };
+            if (relativePattern.find('/') != std::string::npos || relativePattern.find("**") != std::string::npos)
+            {
+                for (const fs::directory_entry &entry : fs::recursive_directory_iterator(baseDirectory))
+                {
+                    collect(entry);
+                }
+            }
+            else
+            {
+                for (const fs::directory_entry &entry : fs::directory_iterator(baseDirectory))
+                {
+                    collect(entry);
+                }
+            }
+        }
+
+        if (inputs.empty())
+        {
+            throw std::invalid_argument("No input files match '" + pattern + "'.");
+        }
+        std::sort(inputs.begin(), inputs.end());
+    }
+
+    // Returns the input paths
+    const std::vector<std::filesystem::path> &BatchScanner::getInputs() const
+    {
+        return inputs;
+    }
+
+    // Returns the base directory
+    const std::filesystem::path &BatchScanner::getBaseDirectory() const
+    {
+        return baseDirectory;
+    }
+
+    // Tokenizes every input file on a thread pool
+    BatchReport BatchScanner::run(const std::string &outputDirectory, std::size_t jobs, bool includePosition,
+                                  bool binaryOutput) const
+    {
+        namespace fs = std::filesystem;
+        auto start = std::chrono::steady_clock::now();
+
+        BatchReport report;
+        report.files.resize(inputs.size());
+        for (std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            fs::path outputPath = fs::path(outputDirectory) / inputs[i];
+            outputPath += binaryOutput ? ".tokens.bin" : ".tokens";
+            report.files[i].inputPath = (baseDirectory / inputs[i]).string();
+            report.files[i].outputPath = outputPath.string();
+
+            // create the output directories here, so the workers never race to create them
+            fs::create_directories(outputPath.parent_path());
+        }
+
+        {
+            ThreadPool pool(jobs);
+            report.threads = pool.size();
+            for (BatchFileResult &result : report.files)
+            {
+                pool.submit([&result, includePosition, binaryOutput]
+                            { scanFile(result, includePosition, binaryOutput); });
+            }
+            pool.wait();
+        }
+
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
+
+    // Tokenizes one file, recording any error in the result
+    void BatchScanner::scanFile(BatchFileResult &result, bool includePosition, bool binaryOutput)
+    {
+        auto start = std::chrono::steady_clock::now();
+        try
+        {
+            MappedFile input = FileHandler::mapFile(result.inputPath);
+            std::string_view content = input.view();
+            result.bytes = content.size();
+            if (content.empty())
+            {
+                throw std::invalid_argument("Input file is empty");
+            }
+
+            Scanner scanner(content);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            const TokenStream &tokens = builder.getTokens();
+            if (tokens.empty())
+            {
+                throw std::runtime_error("No tokens generated.");
+            }
+
+            result.tokens = tokens.size();
+            const std::vector<TokenType> &types = tokens.getTypes();
+            result.unknownTokens = static_cast<std::size_t>(std::count(types.begin(), types.end(), TokenType::UNKNOWN));
+
+            if (binaryOutput)
+            {
+                FileHandler::writeBinaryTokens(result.outputPath, tokens);
+            }
+            else
+            {
+                FileHandler::writeTokens(result.outputPath, tokens, includePosition);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            result.error = e.what();
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Matches a path against a glob pattern, component wildcards first, "**" by backtracking
+    bool BatchScanner::matchPattern(std::string_view pattern, std::string_view path)
+    {
+        while (!pattern.empty())
+        {
+            if (pattern.substr(0, 2) == "**")
+            {
+                // "**/" matches zero or more whole components, a trailing "**" matches the rest
+                std::string_view rest = pattern.substr(2);
+                if (rest.empty())
+                {
+                    return true;
+                }
+                if (rest[0] == '/')
+                {
+                    rest.remove_prefix(1);
+                }
+                for (std::size_t i = 0; i <= path.size(); ++i)
+                {
+                    if ((i == 0 || path[i - 1] == '/') && matchPattern(rest, path.substr(i)))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            if (pattern[0] == '*')
+            {
+                // "*" matches any run of characters within the component
+                std::string_view rest = pattern.substr(1);
+                for (std::size_t i = 0; i <= path.size(); ++i)
+                {
+                    if (matchPattern(rest, path.substr(i)))
+                    {
+                        return true;
+                    }
+                    if (i < path.size() && path[i] == '/')
+                    {
+                        break;
+                    }
+                }
+                return false;
+            }
+
+            if (path.empty() || (pattern[0] == '?' ? path[0] == '/' : pattern[0] != path[0]))
+            {
+                return false;
+            }
+            pattern.remove_prefix(1);
+            path.remove_prefix(1);
+        }
+        return path.empty();
+    }
+
+} // namespace TINY::SCANNER
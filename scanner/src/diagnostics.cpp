@@ -0,0 +1,128 @@
+/**
+ * @file diagnostics.cpp
+ * @brief Implements the Diagnostics class for reporting unexpected tokens in batches.
+ *
+ * A batch is formatted into one reusable string, wrapped in the red color codes, with
+ * integers converted by `std::to_chars`, and written with a single `write` call; the stream
+ * is never flushed per error.
+ */
+
+#include "diagnostics.hpp"
+
+#include <charconv>
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        const std::string_view RED = "\033[1;31m";
+        const std::string_view RESET = "\033[0m";
+
+        // Appends a number in decimal to the text
+        void appendNumber(std::string &text, std::size_t number)
+        {
+            char digits[20];
+            char *end = std::to_chars(digits, digits + sizeof(digits), number).ptr;
+            text.append(digits, static_cast<std::size_t>(end - digits));
+        }
+
+        // Appends a line or column number in decimal to the text
+        void appendNumber(std::string &text, int number)
+        {
+            char digits[11];
+            char *end = std::to_chars(digits, digits + sizeof(digits), number).ptr;
+            text.append(digits, static_cast<std::size_t>(end - digits));
+        }
+    } // namespace
+
+    // Constructor: Starts with no errors
+    Diagnostics::Diagnostics(std::size_t maxErrors) : maxErrors(maxErrors)
+    {
+    }
+
+    // Records an unexpected token, unless the limit is already reached
+    bool Diagnostics::report(std::string_view value, int line, int column)
+    {
+        if (limitReached())
+        {
+            return true;
+        }
+
+        pending.push_back({values.size(), value.size(), line, column});
+        values.append(value);
+        ++errorCount;
+        return limitReached();
+    }
+
+    // Formats the pending errors into one block and writes it
+    void Diagnostics::flush(std::ostream &out)
+    {
+        if (pending.empty())
+        {
+            return;
+        }
+
+        text.clear();
+        text.append(RED);
+        if (!headerWritten)
+        {
+            headerWritten = true;
+            text.append("The input contains unexpected tokens, please check the input file.\n"
+                        "List of unexpected tokens:\n");
+        }
+        for (const Record &record : pending)
+        {
+            text.append("-\tError: unexpected token '");
+            text.append(values, record.valueOffset, record.valueLength);
+            text.append("' at line ");
+            appendNumber(text, record.line);
+            text.append(", column ");
+            appendNumber(text, record.column);
+            text.push_back('\n');
+        }
+        text.append(RESET);
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+
+        pending.clear();
+        values.clear();
+    }
+
+    // Writes the number of errors, and whether the limit stopped the run
+    void Diagnostics::printSummary(std::ostream &out) const
+    {
+        if (errorCount == 0)
+        {
+            return;
+        }
+
+        std::string summary(RED);
+        summary.append("Unexpected tokens: ");
+        appendNumber(summary, errorCount);
+        if (limitReached())
+        {
+            summary.append(" (stopped at the limit set by --max-errors)");
+        }
+        summary.push_back('\n');
+        summary.append(RESET);
+        out.write(summary.data(), static_cast<std::streamsize>(summary.size()));
+    }
+
+    // Returns the number of errors recorded so far
+    std::size_t Diagnostics::count() const
+    {
+        return errorCount;
+    }
+
+    // Checks whether enough errors are pending for a write
+    bool Diagnostics::isBatchFull() const
+    {
+        return pending.size() >= BATCH_SIZE;
+    }
+
+    // Checks whether the limit on the number of errors is reached
+    bool Diagnostics::limitReached() const
+    {
+        return maxErrors != 0 && errorCount >= maxErrors;
+    }
+} // namespace TINY::SCANNER
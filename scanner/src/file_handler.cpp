@@ -12,6 +12,11 @@
 
 #include "file_handler.hpp"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <unistd.h>
+#endif
+
 /**
  * @namespace TINY::SCANNER
  * @brief Contains all components related to the lexical analysis (scanning) of the TINY programming language.
@@ -52,21 +57,87 @@ namespace TINY::SCANNER
             std::istreambuf_iterator<char>());
     }
 
+    MappedFile FileHandler::mapFile(const std::string &filePath)
+    {
+        // file path cannot be empty
+        if (filePath.empty())
+        {
+            throw std::invalid_argument("File path cannot be empty.");
+        }
+
+        // file path must exist
+        if (!std::filesystem::exists(filePath))
+        {
+            throw std::invalid_argument("File does not exist: " + filePath);
+        }
+
+        // Map the file content, the mapping is released when the MappedFile goes out of scope
+        return MappedFile(filePath);
+    }
+
     void FileHandler::writeTokens(const std::string &filePath, const std::vector<Token> &tokens,
                                   bool includePosition)
     {
-        // Create a string file content from the tokens
-        std::ostringstream contentStream;
+        // Open the file at the given path, creating missing parent directories
+        std::ofstream file = FileHandler::openOutputFile(filePath);
+
+        // Format the tokens into large blocks and write them to the file
+        TokenWriter writer(file);
         for (const Token &token : tokens)
         {
-            contentStream << token.toString(includePosition) << "\n";
+            writer.write(token, includePosition);
         }
+        writer.flush();
+    }
+
+    void FileHandler::writeTokens(const std::string &filePath, const TokenStream &tokens,
+                                  bool includePosition)
+    {
+        // Open the file at the given path, creating missing parent directories
+        std::ofstream file = FileHandler::openOutputFile(filePath);
 
-        // Write the file content to the file at the given path
-        FileHandler::writeFile(filePath, contentStream.str());
+        // Format the tokens into large blocks and write them to the file
+        TokenWriter writer(file);
+        writer.write(tokens, includePosition);
+        writer.flush();
     }
 
-    void FileHandler::writeFile(const std::string &filePath, const std::string &content)
+    void FileHandler::writeBinaryTokens(const std::string &filePath, const TokenStream &tokens)
+    {
+        // Open the file in binary mode, creating missing parent directories
+        std::ofstream file = FileHandler::openOutputFile(filePath, true);
+
+        // Write the header, the records and the string pool
+        TokenFileWriter::write(file, tokens);
+    }
+
+    std::ifstream FileHandler::openInputFile(const std::string &filePath)
+    {
+        // file path cannot be empty
+        if (filePath.empty())
+        {
+            throw std::invalid_argument("File path cannot be empty.");
+        }
+
+        // file path must exist
+        if (!std::filesystem::exists(filePath))
+        {
+            throw std::invalid_argument("File does not exist: " + filePath);
+        }
+
+        // Open the file at the given path, in binary mode so it is read byte for byte
+        std::ifstream file(filePath, std::ios::binary);
+
+        // Check if the file was opened successfully
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open file: " + filePath);
+        }
+
+        return file;
+    }
+
+    std::ofstream FileHandler::openOutputFile(const std::string &filePath, bool binary)
     {
         // if the file path is empty, throw an invalid argument exception
         if (filePath.empty())
@@ -96,7 +167,7 @@ namespace TINY::SCANNER
         }
 
         // Open the file at the given path
-        std::ofstream file(filePath);
+        std::ofstream file(filePath, binary ? std::ios::out | std::ios::binary : std::ios::out);
 
         // Check if the file was opened successfully
         if (!file.is_open())
@@ -104,7 +175,41 @@ namespace TINY::SCANNER
             throw std::runtime_error("Failed to open file: " + filePath);
         }
 
+        return file;
+    }
+
+    void FileHandler::writeFile(const std::string &filePath, const std::string &content)
+    {
+        // Open the file at the given path, creating missing parent directories
+        std::ofstream file = FileHandler::openOutputFile(filePath);
+
         // Write the content to the file
         file << content;
     }
+
+    std::size_t FileHandler::readStandardInput(char *buffer, std::size_t size)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        // read() returns what the pipe holds instead of blocking until the buffer is full
+        while (true)
+        {
+            ssize_t count = ::read(STDIN_FILENO, buffer, size);
+            if (count >= 0)
+            {
+                return static_cast<std::size_t>(count);
+            }
+            if (errno != EINTR)
+            {
+                throw std::runtime_error("Failed to read the standard input.");
+            }
+        }
+#else
+        std::cin.read(buffer, static_cast<std::streamsize>(size));
+        if (std::cin.bad())
+        {
+            throw std::runtime_error("Failed to read the standard input.");
+        }
+        return static_cast<std::size_t>(std::cin.gcount());
+#endif
+    }
 } // namespace TINY::SCANNER
@@ -0,0 +1,67 @@
+/**
+ * @file line_index.cpp
+ * @brief Implements the LineIndex class, which resolves source offsets to line and column numbers.
+ */
+
+#include "line_index.hpp"
+#include "simd_scan.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace TINY::SCANNER
+{
+
+    // Constructor: Records the start of every line after the origin
+    LineIndex::LineIndex(std::string_view source, SourcePosition origin) : origin(origin)
+    {
+        const char *begin = source.data() + std::min(origin.offset, source.size());
+        const char *end = source.data() + source.size();
+        lineStarts.reserve(SIMD::countNewlines(begin, end));
+
+        for (const void *newline = std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)); newline != nullptr;)
+        {
+            const char *next = static_cast<const char *>(newline) + 1;
+            lineStarts.push_back(static_cast<std::size_t>(next - source.data()));
+            newline = std::memchr(next, '\n', static_cast<std::size_t>(end - next));
+        }
+    }
+
+    // Finds the line of an offset with a binary search
+    SourcePosition LineIndex::locate(std::size_t offset) const
+    {
+        std::size_t line = static_cast<std::size_t>(std::upper_bound(lineStarts.begin(), lineStarts.end(), offset) - lineStarts.begin());
+        return positionOn(offset, line);
+    }
+
+    // Finds the line of an offset by walking forward from the previous one
+    SourcePosition LineIndex::locate(std::size_t offset, std::size_t &hint) const
+    {
+        if (hint > 0 && lineStarts[hint - 1] > offset)
+        {
+            hint = 0; // the offsets went backwards, start over
+        }
+        while (hint < lineStarts.size() && lineStarts[hint] <= offset)
+        {
+            ++hint;
+        }
+        return positionOn(offset, hint);
+    }
+
+    // Returns the number of newlines after the origin
+    std::size_t LineIndex::newlineCount() const
+    {
+        return lineStarts.size();
+    }
+
+    // Counts the column from the start of the line, or from the origin on its line
+    SourcePosition LineIndex::positionOn(std::size_t offset, std::size_t line) const
+    {
+        if (line == 0)
+        {
+            return {offset, origin.line, origin.column + static_cast<int>(offset - origin.offset)};
+        }
+        return {offset, origin.line + static_cast<int>(line), static_cast<int>(offset - lineStarts[line - 1]) + 1};
+    }
+
+} // namespace TINY::SCANNER
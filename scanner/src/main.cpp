@@ -11,11 +11,11 @@ int main(int argc, char *argv[]) {
         TINY::SCANNER::App app(argc, argv);
         app.run();
     } catch (std::exception &e) {
-        // set color to red
-        std::cout << "\033[1;31m";
+        // set color to red, on the error stream so a token pipe on the standard output stays clean
+        std::cerr << "\033[1;31m";
         std::cerr << "Error: " << e.what() << std::endl;
         // reset
-        std::cout << "\033[0m";
+        std::cerr << "\033[0m";
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
@@ -0,0 +1,167 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Implements the MappedFile class for read-only memory-mapped file access.
+ *
+ * On POSIX systems the file is mapped with `mmap`, on Windows with `MapViewOfFile`.
+ * In both cases the file handle is closed right after mapping; the mapping itself
+ * keeps the file content accessible until it is released.
+ */
+
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace TINY::SCANNER
+{
+
+#ifdef _WIN32
+
+    MappedFile::MappedFile(const std::string &filePath)
+    {
+        HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Failed to open file: " + filePath);
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            CloseHandle(file);
+            throw std::runtime_error("Failed to get file size: " + filePath);
+        }
+
+        // An empty file cannot be mapped, represent it by an empty view
+        if (fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr)
+        {
+            throw std::runtime_error("Failed to map file: " + filePath);
+        }
+
+        void *address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (address == nullptr)
+        {
+            throw std::runtime_error("Failed to map file: " + filePath);
+        }
+
+        data = static_cast<const char *>(address);
+        length = static_cast<std::size_t>(fileSize.QuadPart);
+    }
+
+    void MappedFile::release() noexcept
+    {
+        if (data != nullptr)
+        {
+            UnmapViewOfFile(data);
+        }
+        data = nullptr;
+        length = 0;
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::string &filePath)
+    {
+        int fd = ::open(filePath.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Failed to open file: " + filePath);
+        }
+
+        struct stat fileStat;
+        if (::fstat(fd, &fileStat) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("Failed to get file size: " + filePath);
+        }
+
+        // An empty file cannot be mapped, represent it by an empty view
+        if (fileStat.st_size == 0)
+        {
+            ::close(fd);
+            return;
+        }
+
+        std::size_t fileSize = static_cast<std::size_t>(fileStat.st_size);
+        void *address = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED)
+        {
+            throw std::runtime_error("Failed to map file: " + filePath);
+        }
+
+        // The scanner reads the file front to back, let the kernel read ahead aggressively
+        ::madvise(address, fileSize, MADV_SEQUENTIAL);
+
+        data = static_cast<const char *>(address);
+        length = fileSize;
+    }
+
+    void MappedFile::release() noexcept
+    {
+        if (data != nullptr)
+        {
+            ::munmap(const_cast<char *>(data), length);
+        }
+        data = nullptr;
+        length = 0;
+    }
+
+#endif
+
+    MappedFile::~MappedFile()
+    {
+        release();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+        : data(std::exchange(other.data, nullptr)), length(std::exchange(other.length, 0))
+    {
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            data = std::exchange(other.data, nullptr);
+            length = std::exchange(other.length, 0);
+        }
+        return *this;
+    }
+
+    std::string_view MappedFile::view() const
+    {
+        return std::string_view(data, length);
+    }
+
+    std::size_t MappedFile::size() const
+    {
+        return length;
+    }
+
+    bool MappedFile::empty() const
+    {
+        return length == 0;
+    }
+
+} // namespace TINY::SCANNER
@@ -0,0 +1,273 @@
+/**
+ * @file program_generator.cpp
+ * @brief Implements the ProgramGenerator class.
+ *
+ * The generator follows the TINY grammar top-down: a statement sequence is one to four
+ * statements, `if` and `repeat` statements open a nested sequence while the nesting limit
+ * allows, and every expression is built with an exact operator budget, part of which may
+ * go into parenthesized subexpressions.
+ */
+
+#include "program_generator.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Size of the chunks written by generate(std::ostream &)
+        constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+        // Statements in a nested sequence are drawn from 1 to this many
+        constexpr std::size_t MAX_SEQUENCE_LENGTH = 4;
+
+        // Words of a comment are drawn from 2 to this many
+        constexpr std::size_t MAX_COMMENT_WORDS = 8;
+
+        // the scanner's keywords, and "else", which other TINY tools reserve
+        const char *const KEYWORDS[] = {"if", "then", "else", "end", "repeat", "until", "read", "write"};
+
+        const char *const COMMENT_WORDS[] = {"compute", "the", "value", "of", "this", "loop", "until", "done",
+                                             "check", "input", "and", "output", "a", "temporary", "result", "note"};
+
+        // The identifier of an index: a, b, ..., z, aa, ab, ...
+        std::string identifierName(std::size_t index)
+        {
+            std::string name;
+            do
+            {
+                name.insert(name.begin(), static_cast<char>('a' + index % 26));
+                index = index / 26;
+            } while (index-- > 0);
+            return name;
+        }
+    } // namespace
+
+    // Constructor: Validates the options and builds the vocabulary
+    ProgramGenerator::ProgramGenerator(const GeneratorOptions &options)
+        : options(options), random(options.seed)
+    {
+        if (!(options.commentDensity >= 0 && options.commentDensity <= 1))
+        {
+            throw std::invalid_argument("Comment density must be between 0 and 1.");
+        }
+        if (options.vocabularySize == 0)
+        {
+            throw std::invalid_argument("The vocabulary must hold at least one identifier.");
+        }
+
+        vocabulary.reserve(options.vocabularySize);
+        for (std::size_t index = 0; vocabulary.size() < options.vocabularySize; ++index)
+        {
+            std::string name = identifierName(index);
+            if (std::find(std::begin(KEYWORDS), std::end(KEYWORDS), name) == std::end(KEYWORDS))
+            {
+                vocabulary.push_back(std::move(name));
+            }
+        }
+    }
+
+    // Generates a whole program in memory
+    std::string ProgramGenerator::generate()
+    {
+        std::string program;
+        program.reserve(options.size + CHUNK_SIZE);
+        for (bool first = true; first || program.size() < options.size; first = false)
+        {
+            appendTopLevelStatement(program, first);
+        }
+        program += '\n';
+        return program;
+    }
+
+    // Generates a program into a stream, one chunk at a time
+    void ProgramGenerator::generate(std::ostream &out)
+    {
+        std::string chunk;
+        chunk.reserve(2 * CHUNK_SIZE);
+        std::size_t written = 0;
+        for (bool first = true; first || written + chunk.size() < options.size; first = false)
+        {
+            appendTopLevelStatement(chunk, first);
+            if (chunk.size() >= CHUNK_SIZE)
+            {
+                out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+                written += chunk.size();
+                chunk.clear();
+            }
+        }
+        chunk += '\n';
+        out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        out.flush();
+        if (!out)
+        {
+            throw std::runtime_error("Error writing the generated program.");
+        }
+    }
+
+    // Returns the vocabulary
+    const std::vector<std::string> &ProgramGenerator::getVocabulary() const
+    {
+        return vocabulary;
+    }
+
+    // Appends a top-level statement, separated from the previous one
+    void ProgramGenerator::appendTopLevelStatement(std::string &out, bool first)
+    {
+        if (!first)
+        {
+            out += ";\n";
+        }
+        appendStatement(out, 0);
+    }
+
+    // Appends one to MAX_SEQUENCE_LENGTH statements
+    void ProgramGenerator::appendStatementSequence(std::string &out, std::size_t depth)
+    {
+        std::size_t length = 1 + below(MAX_SEQUENCE_LENGTH);
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            if (i > 0)
+            {
+                out += ";\n";
+            }
+            appendStatement(out, depth);
+        }
+    }
+
+    // Appends a statement, compound ones only below the nesting limit
+    void ProgramGenerator::appendStatement(std::string &out, std::size_t depth)
+    {
+        if (options.maxCommentDepth > 0 && chance(options.commentDensity))
+        {
+            appendIndentation(out, depth);
+            appendComment(out, options.maxCommentDepth);
+            out += '\n';
+        }
+        appendIndentation(out, depth);
+
+        // if, repeat, read and write take one of 8 draws each, assignments the other 4
+        std::size_t kind = depth < options.maxNestingDepth ? below(8) : 2 + below(6);
+        switch (kind)
+        {
+        case 0:
+            out += "if ";
+            appendCondition(out);
+            out += " then\n";
+            appendStatementSequence(out, depth + 1);
+            out += '\n';
+            appendIndentation(out, depth);
+            out += "end";
+            break;
+
+        case 1:
+            out += "repeat\n";
+            appendStatementSequence(out, depth + 1);
+            out += '\n';
+            appendIndentation(out, depth);
+            out += "until ";
+            appendCondition(out);
+            break;
+
+        case 2:
+            out += "read ";
+            out += vocabulary[below(vocabulary.size())];
+            break;
+
+        case 3:
+            out += "write ";
+            appendExpression(out, below(options.maxExpressionLength + 1));
+            break;
+
+        default:
+            out += vocabulary[below(vocabulary.size())];
+            out += " := ";
+            appendExpression(out, below(options.maxExpressionLength + 1));
+            break;
+        }
+    }
+
+    // Appends two expressions compared with < or =, sharing one operator budget
+    void ProgramGenerator::appendCondition(std::string &out)
+    {
+        std::size_t operators = below(options.maxExpressionLength + 1);
+        std::size_t left = below(operators + 1);
+        appendExpression(out, left);
+        out += chance(0.5) ? " < " : " = ";
+        appendExpression(out, operators - left);
+    }
+
+    // Appends factors joined by operators, a factor being a number, an identifier or a parenthesized expression
+    void ProgramGenerator::appendExpression(std::string &out, std::size_t operators)
+    {
+        static const char *const OPERATORS[] = {" + ", " - ", " * ", " / "};
+
+        std::size_t remaining = operators;
+        for (bool first = true; first || remaining > 0; first = false)
+        {
+            if (!first)
+            {
+                out += OPERATORS[below(4)];
+                --remaining;
+            }
+
+            if (remaining > 0 && chance(0.25))
+            {
+                // move part of the remaining budget into a subexpression
+                std::size_t inner = 1 + below(remaining);
+                remaining -= inner;
+                out += '(';
+                appendExpression(out, inner);
+                out += ')';
+            }
+            else if (chance(0.3))
+            {
+                out += std::to_string(below(1000));
+            }
+            else
+            {
+                out += vocabulary[below(vocabulary.size())];
+            }
+        }
+    }
+
+    // Appends "{ words }", nesting further comments between the words while depth allows
+    void ProgramGenerator::appendComment(std::string &out, std::size_t depth)
+    {
+        out += '{';
+        std::size_t words = 2 + below(MAX_COMMENT_WORDS - 1);
+        for (std::size_t i = 0; i < words; ++i)
+        {
+            out += ' ';
+            if (depth > 1 && chance(0.25))
+            {
+                appendComment(out, depth - 1);
+                out += ' ';
+            }
+            out += COMMENT_WORDS[below(sizeof(COMMENT_WORDS) / sizeof(COMMENT_WORDS[0]))];
+        }
+        out += " }";
+    }
+
+    // Appends four spaces per nesting level
+    void ProgramGenerator::appendIndentation(std::string &out, std::size_t depth)
+    {
+        out.append(4 * depth, ' ');
+    }
+
+    // Draws a number in [0, bound)
+    std::size_t ProgramGenerator::below(std::size_t bound)
+    {
+        return static_cast<std::size_t>(random() % bound);
+    }
+
+    // Draws true with the given probability, from the top 53 bits of the next number
+    bool ProgramGenerator::chance(double probability)
+    {
+        return static_cast<double>(random() >> 11) * 0x1.0p-53 < probability;
+    }
+
+} // namespace TINY::SCANNER
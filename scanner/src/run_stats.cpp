@@ -0,0 +1,167 @@
+/**
+ * @file run_stats.cpp
+ * @brief Implements the RunStats class and its table and JSON reports.
+ */
+
+#include "run_stats.hpp"
+
+#include <iomanip>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // A rate, or 0 when the phase took no measurable time
+        double rate(std::size_t amount, double seconds)
+        {
+            return seconds > 0 ? static_cast<double>(amount) / seconds : 0;
+        }
+
+        // Prints a rate column, or a dash when the phase did not handle that kind of work
+        void printRate(std::ostream &out, std::size_t amount, double seconds, double unit)
+        {
+            out << std::setw(12);
+            if (amount == 0 || seconds <= 0)
+            {
+                out << "-";
+            }
+            else
+            {
+                out << rate(amount, seconds) / unit;
+            }
+        }
+    } // namespace
+
+    // Constructor: Starts the wall clock of the run
+    RunStats::RunStats() : start(Clock::now())
+    {
+    }
+
+    // Records a phase ending now
+    void RunStats::addPhase(const std::string &name, Clock::time_point phaseStart, std::size_t bytes, std::size_t tokens)
+    {
+        double seconds = std::chrono::duration<double>(Clock::now() - phaseStart).count();
+        phases.push_back({name, seconds, bytes, tokens});
+    }
+
+    // Sets the input size and the token count
+    void RunStats::setTotals(std::size_t bytes, std::size_t tokens)
+    {
+        inputBytes = bytes;
+        tokenCount = tokens;
+    }
+
+    // Returns the phases
+    const std::vector<PhaseStats> &RunStats::getPhases() const
+    {
+        return phases;
+    }
+
+    // Returns the wall time since construction
+    double RunStats::elapsedSeconds() const
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Prints one row per phase, then the totals
+    void RunStats::print(std::ostream &out) const
+    {
+        // the numbers are printed in fixed notation, the stream's own format is restored at the end
+        std::ios_base::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+
+        double wallSeconds = elapsedSeconds();
+        out << std::dec << std::left << std::setw(10) << "Phase" << std::right << std::setw(12) << "Time (ms)"
+            << std::setw(12) << "MiB/s" << std::setw(12) << "Mtokens/s" << "\n"
+            << std::fixed << std::setprecision(3);
+        for (const PhaseStats &phase : phases)
+        {
+            out << std::left << std::setw(10) << phase.name << std::right << std::setw(12) << phase.seconds * 1000;
+            printRate(out, phase.bytes, phase.seconds, 1024.0 * 1024.0);
+            printRate(out, phase.tokens, phase.seconds, 1e6);
+            out << "\n";
+        }
+        out << std::left << std::setw(10) << "total" << std::right << std::setw(12) << wallSeconds * 1000;
+        printRate(out, inputBytes, wallSeconds, 1024.0 * 1024.0);
+        printRate(out, tokenCount, wallSeconds, 1e6);
+        out << "\n";
+
+        out << "Input:          " << inputBytes << " bytes\n"
+            << "Tokens:         " << tokenCount << "\n"
+            << "Peak RSS:       ";
+        std::optional<std::size_t> peak = peakResidentBytes();
+        if (peak)
+        {
+            out << std::setprecision(1) << static_cast<double>(*peak) / (1024.0 * 1024.0) << " MiB\n";
+        }
+        else
+        {
+            out << "unavailable\n";
+        }
+
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    // Prints the report as a single-line JSON object
+    void RunStats::printJson(std::ostream &out) const
+    {
+        std::ios_base::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out.unsetf(std::ios_base::floatfield);
+        out << std::dec << std::setprecision(9);
+
+        double wallSeconds = elapsedSeconds();
+        out << "{\"input_bytes\":" << inputBytes << ",\"tokens\":" << tokenCount << ",\"wall_seconds\":" << wallSeconds
+            << ",\"peak_rss_bytes\":";
+        std::optional<std::size_t> peak = peakResidentBytes();
+        if (peak)
+        {
+            out << *peak;
+        }
+        else
+        {
+            out << "null";
+        }
+
+        out << ",\"phases\":[";
+        for (std::size_t i = 0; i < phases.size(); ++i)
+        {
+            // phase names are fixed identifiers, they never need escaping
+            const PhaseStats &phase = phases[i];
+            out << (i > 0 ? "," : "") << "{\"name\":\"" << phase.name << "\",\"seconds\":" << phase.seconds
+                << ",\"bytes\":" << phase.bytes << ",\"tokens\":" << phase.tokens
+                << ",\"bytes_per_second\":" << rate(phase.bytes, phase.seconds)
+                << ",\"tokens_per_second\":" << rate(phase.tokens, phase.seconds) << "}";
+        }
+        out << "]}\n";
+
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    // Reads the peak resident set size from getrusage, in kilobytes on Linux and bytes on macOS
+    std::optional<std::size_t> RunStats::peakResidentBytes()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return std::nullopt;
+        }
+#if defined(__APPLE__)
+        return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+        return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+        return std::nullopt;
+#endif
+    }
+
+} // namespace TINY::SCANNER
@@ -0,0 +1,807 @@
+/**
+ * @file scan_server.cpp
+ * @brief Implements the ScanServer and the ScanClient of the scan request protocol.
+ *
+ * The thread that calls `run()` runs an event loop over `poll()`: it accepts connections,
+ * reads requests and writes responses on non-blocking sockets, and submits every complete
+ * request to the thread pool. A request holds a session from the free list from its header
+ * until its response is written: the session's scanner, builder and buffers keep their memory
+ * between requests. A payload is read in chunks of at most 64 KiB, counted against the
+ * server's limit on pending bytes, and responses are formatted straight into the session's response buffer
+ * through a string-backed stream. Workers hand a formatted response back through a queue and
+ * wake the loop with a byte on a pipe. The socket calls are POSIX only; on other systems the
+ * server and the client fail to start.
+ */
+
+#include "scan_server.hpp"
+#include "file_handler.hpp"
+#include "scanner.hpp"
+#include "token_pipe.hpp"
+#include "token_stream_builder.hpp"
+#include "token_writer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Buffer sizes of the session writers; the response buffer itself grows as needed
+        constexpr std::size_t TEXT_BUFFER_SIZE = 64 * 1024;
+        constexpr std::size_t PIPE_BUFFER_SIZE = 16 * 1024;
+
+        // The payload buffer of a request grows by at most this much per read, so memory
+        // follows the bytes that arrived, not the length the header announces
+        constexpr std::size_t RECEIVE_CHUNK_SIZE = 64 * 1024;
+
+        // Request and response buffers larger than this are released after their request,
+        // so one huge request does not pin its memory in the session for good
+        constexpr std::size_t RETAINED_BUFFER_SIZE = 16 * 1024 * 1024;
+
+        // A stream buffer that appends everything written to it to a string
+        class StringSink : public std::streambuf
+        {
+        public:
+            explicit StringSink(std::string &target) : target(target) {}
+
+        protected:
+            std::streamsize xsputn(const char *data, std::streamsize count) override
+            {
+                target.append(data, static_cast<std::size_t>(count));
+                return count;
+            }
+
+            int_type overflow(int_type c) override
+            {
+                if (!traits_type::eq_int_type(c, traits_type::eof()))
+                {
+                    target.push_back(traits_type::to_char_type(c));
+                }
+                return traits_type::not_eof(c);
+            }
+
+        private:
+            std::string &target;
+        };
+
+        // Replaces the response of a session with an error message
+        void setError(std::string &response, std::string_view message)
+        {
+            ScanResponseHeader header{};
+            header.length = message.size();
+            response.assign(reinterpret_cast<const char *>(&header), sizeof(header));
+            response.append(message);
+        }
+    } // namespace
+
+    // The state a worker keeps between the requests it serves
+    struct ScanServer::Session
+    {
+        std::string request;                              // Payload of the current request
+        std::string response;                             // Header and body of the current response
+        StringSink sink{response};                        // Appends to the response
+        std::ostream output{&sink};                       // Stream over the sink, for the writers
+        TokenWriter textWriter{output, TEXT_BUFFER_SIZE}; // Formats text responses
+        Scanner scanner{std::string_view()};              // Reset to every request's source
+        TokenStreamBuilder builder{scanner};              // Keeps its token arrays between requests
+    };
+
+    // A client connection, only touched by the thread running the event loop
+    struct ScanServer::Connection
+    {
+        // What the connection is waiting for
+        enum class Stage
+        {
+            READING, // The rest of a request
+            WORKING, // A worker formatting the response
+            WRITING  // The socket to take the rest of the response
+        };
+
+        int socket = -1;                  // The connected socket
+        Stage stage = Stage::READING;     // What the connection is waiting for
+        ScanRequestHeader header{};       // Header of the current request
+        std::size_t headerReceived = 0;   // Bytes of the header read so far
+        std::size_t payloadReceived = 0;  // Bytes of the payload read so far
+        std::size_t responseSent = 0;     // Bytes of the response written so far
+        bool closeAfterResponse = false;  // The request was malformed, the connection ends after the error
+        std::unique_ptr<Session> session; // Held from a complete header until the response is written
+    };
+
+    // Tokenizes the payload and formats the response, or an error response
+    void ScanServer::handleRequest(Session &session, const ScanRequestHeader &header)
+    {
+        ScanResponseHeader responseHeader{};
+        session.response.assign(sizeof(responseHeader), '\0');
+        try
+        {
+            // a path is mapped, not read, and the scanner works on the mapping in place
+            std::optional<MappedFile> file;
+            std::string_view source = session.request;
+            if (header.kind == ScanRequestKind::PATH)
+            {
+                file.emplace(FileHandler::mapFile(session.request));
+                source = file->view();
+            }
+
+            session.scanner.reset(source);
+            session.builder.build();
+            const TokenStream &tokens = session.builder.getTokens();
+            if (header.format == ScanFormat::BINARY)
+            {
+                TokenPipeWriter writer(session.output, PIPE_BUFFER_SIZE);
+                writer.write(tokens);
+                writer.finish();
+            }
+            else
+            {
+                session.textWriter.write(tokens, header.format == ScanFormat::TEXT_WITH_POSITIONS);
+                session.textWriter.flush();
+            }
+            responseHeader.ok = 1;
+            responseHeader.tokenCount = tokens.size();
+            responseHeader.length = session.response.size() - sizeof(responseHeader);
+            std::memcpy(session.response.data(), &responseHeader, sizeof(responseHeader));
+        }
+        catch (const std::exception &error)
+        {
+            setError(session.response, error.what());
+        }
+    }
+
+    // Takes a session from the free list, or creates one
+    std::unique_ptr<ScanServer::Session> ScanServer::acquireSession()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sessionMutex);
+            if (!idleSessions.empty())
+            {
+                std::unique_ptr<Session> session = std::move(idleSessions.back());
+                idleSessions.pop_back();
+                return session;
+            }
+        }
+        return std::make_unique<Session>();
+    }
+
+    // Puts a session back on the free list, dropping oversized buffers
+    void ScanServer::releaseSession(std::unique_ptr<Session> session)
+    {
+        if (session->request.capacity() > RETAINED_BUFFER_SIZE)
+        {
+            std::string().swap(session->request);
+        }
+        if (session->response.capacity() > RETAINED_BUFFER_SIZE)
+        {
+            std::string().swap(session->response);
+        }
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        idleSessions.push_back(std::move(session));
+    }
+
+    // Returns the socket path
+    const std::string &ScanServer::getSocketPath() const
+    {
+        return socketPath;
+    }
+
+    // Returns the number of worker threads
+    std::size_t ScanServer::threadCount() const
+    {
+        return pool.size();
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+
+    namespace
+    {
+        // Builds the address of a socket path
+        sockaddr_un socketAddress(const std::string &path)
+        {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            if (path.empty() || path.size() >= sizeof(address.sun_path))
+            {
+                throw std::invalid_argument("Invalid socket path '" + path + "', use at most " +
+                                            std::to_string(sizeof(address.sun_path) - 1) + " bytes.");
+            }
+            std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+            return address;
+        }
+
+        // Reads exactly size bytes, false if the connection ends or fails first
+        bool receiveAll(int socket, void *data, std::size_t size)
+        {
+            char *cursor = static_cast<char *>(data);
+            while (size > 0)
+            {
+                ssize_t count = ::recv(socket, cursor, size, 0);
+                if (count < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (count <= 0)
+                {
+                    return false;
+                }
+                cursor += count;
+                size -= static_cast<std::size_t>(count);
+            }
+            return true;
+        }
+
+#ifdef MSG_NOSIGNAL
+        constexpr int SEND_FLAGS = MSG_NOSIGNAL; // a client that went away must not kill the server
+#else
+        constexpr int SEND_FLAGS = 0;
+#endif
+
+        // What one read from a non-blocking socket gave
+        struct ReceiveResult
+        {
+            std::size_t count = 0; // Bytes read, 0 if none had arrived
+            bool closed = false;   // The connection ended or failed
+        };
+
+        // Reads up to size bytes that have arrived on a non-blocking socket
+        ReceiveResult receiveSome(int socket, char *data, std::size_t size)
+        {
+            ReceiveResult result;
+            while (true)
+            {
+                ssize_t count = ::recv(socket, data, size, 0);
+                if (count < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                {
+                    return result;
+                }
+                if (count <= 0)
+                {
+                    result.closed = true;
+                    return result;
+                }
+                result.count = static_cast<std::size_t>(count);
+                return result;
+            }
+        }
+
+        // Makes a descriptor's reads and writes return instead of waiting, false on failure
+        bool setNonBlocking(int descriptor)
+        {
+            int flags = ::fcntl(descriptor, F_GETFL, 0);
+            return flags >= 0 && ::fcntl(descriptor, F_SETFL, flags | O_NONBLOCK) == 0;
+        }
+
+        // Writes exactly size bytes, false if the connection fails first
+        bool sendAll(int socket, const void *data, std::size_t size)
+        {
+            const char *cursor = static_cast<const char *>(data);
+            while (size > 0)
+            {
+                ssize_t count = ::send(socket, cursor, size, SEND_FLAGS);
+                if (count < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (count <= 0)
+                {
+                    return false;
+                }
+                cursor += count;
+                size -= static_cast<std::size_t>(count);
+            }
+            return true;
+        }
+
+        // The message of the last failed system call
+        std::string lastError()
+        {
+            return std::strerror(errno);
+        }
+    } // namespace
+
+    // Constructor: Replaces a stale socket file, then binds and listens
+    ScanServer::ScanServer(const std::string &socketPath, std::size_t threadCount, std::uint64_t maxPendingBytes)
+        : socketPath(socketPath), maxPendingBytes(maxPendingBytes), pool(threadCount)
+    {
+        const sockaddr_un address = socketAddress(socketPath);
+        const sockaddr *socketAddress = reinterpret_cast<const sockaddr *>(&address);
+
+        struct stat info;
+        if (::lstat(socketPath.c_str(), &info) == 0)
+        {
+            if (!S_ISSOCK(info.st_mode))
+            {
+                throw std::invalid_argument("Not a socket: " + socketPath);
+            }
+
+            // a socket nobody answers on was left behind by a server that is gone
+            int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            bool live = probe >= 0 && ::connect(probe, socketAddress, sizeof(address)) == 0;
+            if (probe >= 0)
+            {
+                ::close(probe);
+            }
+            if (live)
+            {
+                throw std::runtime_error("A server is already listening on " + socketPath);
+            }
+            ::unlink(socketPath.c_str());
+        }
+
+        int wakePipe[2];
+        if (::pipe(wakePipe) != 0)
+        {
+            throw std::runtime_error("Failed to create a pipe: " + lastError());
+        }
+        wakeRead = wakePipe[0];
+        wakeWrite = wakePipe[1];
+        setNonBlocking(wakeRead);
+        setNonBlocking(wakeWrite);
+
+        listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0 || ::bind(listener, socketAddress, sizeof(address)) != 0 ||
+            ::listen(listener, SOMAXCONN) != 0 || !setNonBlocking(listener))
+        {
+            std::string error = lastError();
+            if (listener >= 0)
+            {
+                ::close(listener);
+            }
+            ::close(wakeRead);
+            ::close(wakeWrite);
+            throw std::runtime_error("Failed to listen on " + socketPath + ": " + error);
+        }
+    }
+
+    // Destructor: Closes the socket and removes its file
+    ScanServer::~ScanServer()
+    {
+        ::close(listener);
+        ::close(wakeRead);
+        ::close(wakeWrite);
+        ::unlink(socketPath.c_str());
+    }
+
+    // Polls the listener and the connections, moving every connection through its stages, until stopped
+    void ScanServer::run()
+    {
+        ConnectionMap connections;
+        std::vector<pollfd> polled;
+        try
+        {
+            while (true)
+            {
+                // connections whose response a worker has formatted are written from here on
+                std::vector<int> done;
+                {
+                    std::lock_guard<std::mutex> lock(finishedMutex);
+                    done.swap(finished);
+                }
+                for (int socket : done)
+                {
+                    Connection &connection = connections.at(socket);
+                    connection.stage = Connection::Stage::WRITING;
+                    connection.responseSent = 0;
+                }
+
+                // once stopped, connections without a request being answered are closed
+                if (stopping)
+                {
+                    std::vector<int> waiting;
+                    for (const auto &[socket, connection] : connections)
+                    {
+                        if (connection.stage == Connection::Stage::READING)
+                        {
+                            waiting.push_back(socket);
+                        }
+                    }
+                    for (int socket : waiting)
+                    {
+                        closeConnection(connections, socket);
+                    }
+                    if (connections.empty())
+                    {
+                        break;
+                    }
+                }
+
+                // the wake-up pipe and the listener first, so sockets closed below are never reused in one round
+                polled.clear();
+                polled.push_back({wakeRead, POLLIN, 0});
+                if (!stopping)
+                {
+                    polled.push_back({listener, POLLIN, 0});
+                }
+                for (const auto &[socket, connection] : connections)
+                {
+                    if (connection.stage != Connection::Stage::WORKING)
+                    {
+                        short events = connection.stage == Connection::Stage::READING ? POLLIN : POLLOUT;
+                        polled.push_back({socket, events, 0});
+                    }
+                }
+
+                if (::poll(polled.data(), polled.size(), -1) < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    throw std::runtime_error("Failed to poll the connections: " + lastError());
+                }
+
+                for (const pollfd &entry : polled)
+                {
+                    if (entry.revents == 0)
+                    {
+                        continue;
+                    }
+                    if (entry.fd == wakeRead)
+                    {
+                        char bytes[64];
+                        while (::read(wakeRead, bytes, sizeof(bytes)) > 0)
+                        {
+                        }
+                    }
+                    else if (entry.fd == listener)
+                    {
+                        acceptConnections(connections);
+                    }
+                    else
+                    {
+                        Connection &connection = connections.at(entry.fd);
+                        bool open = connection.stage == Connection::Stage::READING ? receiveRequest(connection)
+                                                                                   : sendResponse(connection);
+                        if (!open)
+                        {
+                            closeConnection(connections, entry.fd);
+                        }
+                    }
+                }
+            }
+        }
+        catch (...)
+        {
+            // the workers still use the sessions of the connections
+            pool.wait();
+            while (!connections.empty())
+            {
+                closeConnection(connections, connections.begin()->first);
+            }
+            throw;
+        }
+        pool.wait();
+    }
+
+    // Flags the event loop to end and wakes it up
+    void ScanServer::stop()
+    {
+        stopping = true;
+        wake();
+    }
+
+    // Writes a byte to the wake-up pipe
+    void ScanServer::wake()
+    {
+        const char byte = 0;
+        if (::write(wakeWrite, &byte, 1) < 0)
+        {
+            // the pipe is full, so a wake-up is already pending
+        }
+    }
+
+    // Accepts connections until none is pending
+    void ScanServer::acceptConnections(ConnectionMap &connections)
+    {
+        while (true)
+        {
+            int client = ::accept(listener, nullptr, nullptr);
+            if (client < 0)
+            {
+                if (errno == EINTR || errno == ECONNABORTED)
+                {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    return;
+                }
+                throw std::runtime_error("Failed to accept a connection: " + lastError());
+            }
+#ifdef SO_NOSIGPIPE
+            int noSigPipe = 1;
+            ::setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+            if (!setNonBlocking(client))
+            {
+                ::close(client);
+                continue;
+            }
+            connections[client].socket = client;
+        }
+    }
+
+    // Reads the available bytes of the current request, and submits it once complete
+    bool ScanServer::receiveRequest(Connection &connection)
+    {
+        try
+        {
+            while (true)
+            {
+                // the header, read as far as it has arrived
+                if (connection.headerReceived < sizeof(connection.header))
+                {
+                    char *header = reinterpret_cast<char *>(&connection.header);
+                    ReceiveResult result = receiveSome(connection.socket, header + connection.headerReceived,
+                                                       sizeof(connection.header) - connection.headerReceived);
+                    if (result.closed)
+                    {
+                        return false;
+                    }
+                    if (result.count == 0)
+                    {
+                        return true; // the rest has not arrived yet
+                    }
+                    connection.headerReceived += result.count;
+                    continue;
+                }
+
+                // the header is complete: take a session to read the payload into; a malformed header
+                // leaves nothing to find the next request by, so the connection ends after the error
+                if (!connection.session)
+                {
+                    const ScanRequestHeader &header = connection.header;
+                    connection.session = acquireSession();
+                    if (header.kind > ScanRequestKind::PATH || header.format > ScanFormat::BINARY ||
+                        header.reserved != 0 || header.length > MAX_REQUEST_SIZE)
+                    {
+                        setError(connection.session->response, "Invalid request header.");
+                        connection.closeAfterResponse = true;
+                        connection.stage = Connection::Stage::WRITING;
+                        connection.responseSent = 0;
+                        return true;
+                    }
+                    connection.session->request.clear();
+                    continue;
+                }
+
+                // the payload, read as far as it has arrived into a buffer grown one chunk at a time
+                if (connection.payloadReceived < connection.header.length)
+                {
+                    std::size_t chunk = std::min<std::size_t>(RECEIVE_CHUNK_SIZE, connection.header.length - connection.payloadReceived);
+                    if (pendingBytes + chunk > maxPendingBytes)
+                    {
+                        setError(connection.session->response, "The server holds too many pending requests, try again later.");
+                        connection.closeAfterResponse = true;
+                        connection.stage = Connection::Stage::WRITING;
+                        connection.responseSent = 0;
+                        return true;
+                    }
+
+                    std::string &request = connection.session->request;
+                    request.resize(connection.payloadReceived + chunk);
+                    ReceiveResult result = receiveSome(connection.socket, request.data() + connection.payloadReceived, chunk);
+                    request.resize(connection.payloadReceived + result.count);
+                    if (result.closed)
+                    {
+                        return false;
+                    }
+                    if (result.count == 0)
+                    {
+                        return true; // the rest has not arrived yet
+                    }
+                    connection.payloadReceived += result.count;
+                    pendingBytes += result.count;
+                    continue;
+                }
+
+                dispatch(connection);
+                return true;
+            }
+        }
+        catch (const std::exception &)
+        {
+            // out of memory for a request: drop the connection, keep serving the others
+            return false;
+        }
+    }
+
+    // Hands a complete request to a worker, which queues the connection for writing when done
+    void ScanServer::dispatch(Connection &connection)
+    {
+        connection.stage = Connection::Stage::WORKING;
+        Session *session = connection.session.get();
+        const ScanRequestHeader header = connection.header;
+        const int socket = connection.socket;
+        pool.submit([this, session, header, socket]
+                    {
+            handleRequest(*session, header);
+            {
+                std::lock_guard<std::mutex> lock(finishedMutex);
+                finished.push_back(socket);
+            }
+            wake(); });
+    }
+
+    // Writes the part of the response the socket takes, then waits for the next request
+    bool ScanServer::sendResponse(Connection &connection)
+    {
+        const std::string &response = connection.session->response;
+        while (connection.responseSent < response.size())
+        {
+            ssize_t count = ::send(connection.socket, response.data() + connection.responseSent,
+                                   response.size() - connection.responseSent, SEND_FLAGS);
+            if (count < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                return true; // the rest is written when the socket has room
+            }
+            if (count <= 0)
+            {
+                return false;
+            }
+            connection.responseSent += static_cast<std::size_t>(count);
+        }
+
+        if (connection.closeAfterResponse)
+        {
+            return false;
+        }
+        releaseRequest(connection);
+        connection.stage = Connection::Stage::READING;
+        connection.headerReceived = 0;
+        return true;
+    }
+
+    // Releases the session of a finished request and takes its payload off the pending bytes
+    void ScanServer::releaseRequest(Connection &connection)
+    {
+        pendingBytes -= connection.payloadReceived;
+        connection.payloadReceived = 0;
+        if (connection.session)
+        {
+            releaseSession(std::move(connection.session));
+        }
+    }
+
+    // Closes the socket of a connection and releases its session
+    void ScanServer::closeConnection(ConnectionMap &connections, int socket)
+    {
+        auto found = connections.find(socket);
+        releaseRequest(found->second);
+        ::close(socket);
+        connections.erase(found);
+    }
+
+    // Constructor: Connects to the server
+    ScanClient::ScanClient(const std::string &socketPath)
+    {
+        const sockaddr_un address = socketAddress(socketPath);
+        connection = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connection < 0 || ::connect(connection, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            std::string error = lastError();
+            if (connection >= 0)
+            {
+                ::close(connection);
+            }
+            throw std::runtime_error("Failed to connect to " + socketPath + ": " + error);
+        }
+    }
+
+    // Destructor: Closes the connection
+    ScanClient::~ScanClient()
+    {
+        ::close(connection);
+    }
+
+    // Sends a request and reads the whole response
+    ScanResponse ScanClient::request(ScanRequestKind kind, ScanFormat format, std::string_view payload)
+    {
+        if (payload.size() > ScanServer::MAX_REQUEST_SIZE)
+        {
+            throw std::invalid_argument("Request exceeds " + std::to_string(ScanServer::MAX_REQUEST_SIZE) + " bytes.");
+        }
+
+        ScanRequestHeader header{};
+        header.kind = kind;
+        header.format = format;
+        header.length = static_cast<std::uint32_t>(payload.size());
+        if (!sendAll(connection, &header, sizeof(header)) || !sendAll(connection, payload.data(), payload.size()))
+        {
+            throw std::runtime_error("Failed to send the request.");
+        }
+
+        ScanResponseHeader responseHeader{};
+        ScanResponse response;
+        if (!receiveAll(connection, &responseHeader, sizeof(responseHeader)))
+        {
+            throw std::runtime_error("The server closed the connection.");
+        }
+        response.ok = responseHeader.ok != 0;
+        response.tokenCount = responseHeader.tokenCount;
+        response.body.resize(responseHeader.length);
+        if (!receiveAll(connection, response.body.data(), response.body.size()))
+        {
+            throw std::runtime_error("The server closed the connection.");
+        }
+        return response;
+    }
+
+#else
+
+    // Unix domain sockets are not available: the server and the client cannot start
+
+    ScanServer::ScanServer(const std::string &socketPath, std::size_t threadCount, std::uint64_t maxPendingBytes)
+        : socketPath(socketPath), maxPendingBytes(maxPendingBytes), pool(threadCount)
+    {
+        throw std::runtime_error("The scan server needs Unix domain sockets, which this platform does not have.");
+    }
+
+    ScanServer::~ScanServer()
+    {
+    }
+
+    void ScanServer::run()
+    {
+    }
+
+    void ScanServer::stop()
+    {
+    }
+
+    void ScanServer::wake()
+    {
+    }
+
+    ScanClient::ScanClient(const std::string &)
+    {
+        throw std::runtime_error("The scan client needs Unix domain sockets, which this platform does not have.");
+    }
+
+    ScanClient::~ScanClient()
+    {
+    }
+
+    ScanResponse ScanClient::request(ScanRequestKind, ScanFormat, std::string_view)
+    {
+        return ScanResponse();
+    }
+
+#endif
+
+    // Tokenizes source code sent with the request
+    ScanResponse ScanClient::scanSource(std::string_view source, ScanFormat format)
+    {
+        return request(ScanRequestKind::SOURCE, format, source);
+    }
+
+    // Tokenizes a file the server reads
+    ScanResponse ScanClient::scanFile(const std::string &path, ScanFormat format)
+    {
+        return request(ScanRequestKind::PATH, format, path);
+    }
+
+} // namespace TINY::SCANNER
@@ -5,132 +5,142 @@
  * This file contains the implementation of the Scanner class, which is responsible for
  * performing lexical analysis on TINY language source code. It identifies tokens such as
  * keywords, operators, delimiters, and literals.
+ *
+ * Tokens are recognized by a table-driven DFA (see lexer_tables.hpp): each byte is mapped
+ * to a character class, and the scanner follows the transition table until it reaches a
+ * final state, which decides the token type and whether the last byte belongs to the token.
+ *
+ * Whitespace and comments are skipped with the vectorized searches from simd_scan.hpp,
+ * and nested comments are tracked with a depth counter.
+ *
+ * The scanner is a template over its policies; its members are defined here and compiled
+ * once for every combination at the end of the file, so users of scanner.hpp do not
+ * instantiate them again.
  */
 
 #include "scanner.hpp"
-#include <cctype>
+#include "lexer_tables.hpp"
+#include "simd_scan.hpp"
 #include <stdexcept>
-#include <stack>
 
 namespace TINY::SCANNER
 {
 
     // Constructor: Initializes the Scanner with the input source code
-    Scanner::Scanner(const std::string &input) : input(input)
+    template <class PositionPolicy, class ValuePolicy>
+    BasicScanner<PositionPolicy, ValuePolicy>::BasicScanner(std::string_view input) : input(input)
+    {
+    }
+
+    // Constructor: Initializes the Scanner to resume scanning part of the input
+    template <class PositionPolicy, class ValuePolicy>
+    BasicScanner<PositionPolicy, ValuePolicy>::BasicScanner(std::string_view input, size_t startPos, int startLine,
+                                                            int startColumn, int startCommentDepth)
+        : input(input), pos(startPos), commentDepth(startCommentDepth), positionOffset(startPos), line(startLine),
+          column(startColumn)
+    {
+    }
+
+    // Restarts scanning at the beginning of a new input
+    template <class PositionPolicy, class ValuePolicy>
+    void BasicScanner<PositionPolicy, ValuePolicy>::reset(std::string_view newInput)
     {
+        input = newInput;
+        pos = 0;
+        commentDepth = 0;
+        positionOffset = 0;
+        line = 1;
+        column = 1;
+        ++generation;
     }
 
     // Extracts the next token from the input source code
-    Token Scanner::getNextToken()
+    template <class PositionPolicy, class ValuePolicy>
+    typename BasicScanner<PositionPolicy, ValuePolicy>::Result BasicScanner<PositionPolicy, ValuePolicy>::getNextToken()
     {
         // Skip any whitespace and comments before processing the next token
         bool unclosedComment = skipWhitespaceAndComments();
 
+        // Without position tracking the bytes are never counted and tokens carry line and column 0
+        if constexpr (PositionPolicy::enabled)
+        {
+            syncPosition();
+        }
+
         // If an unclosed comment was detected, return an UNKNOWN token with an error message
         if (unclosedComment)
         {
-            return Token(TokenType::UNKNOWN, "Unclosed comment", line, column);
+            return ValuePolicy::make(TokenType::UNKNOWN, "Unclosed comment", tokenLine(), tokenColumn());
         }
 
         // Check if we've reached the end of the input
         if (pos >= input.size())
         {
-            // Return an UNKNOWN token to indicate end of input (or define an EOF token if desired)
-            return Token(TokenType::UNKNOWN, "", line, column);
+            // Every call past the last token returns the end of input marker
+            return ValuePolicy::make(TokenType::END_OF_INPUT, "", tokenLine(), tokenColumn());
         }
 
-        // Get the next character from the input
-        char current = get();
-
-        // Handle single-character tokens using a switch statement
-        switch (current)
+        const size_t start = pos;
+        TokenType type = scanLexeme();
+        if constexpr (PositionPolicy::enabled)
         {
-        case '+':
-            return Token(TokenType::PLUS, "+", line, column);
-        case '-':
-            return Token(TokenType::MINUS, "-", line, column);
-        case '*':
-            return Token(TokenType::MULT, "*", line, column);
-        case '/':
-            return Token(TokenType::DIV, "/", line, column);
-        case '(':
-            return Token(TokenType::OPENBRACKET, "(", line, column);
-        case ')':
-            return Token(TokenType::CLOSEDBRACKET, ")", line, column);
-        case ';':
-            return Token(TokenType::SEMICOLON, ";", line, column);
-        case ':':
-            // Check if the next character is '=' to form the ':=' token
-            if (peek() == '=')
-            {
-                get(); // Consume '='
-                return Token(TokenType::ASSIGN, ":=", line, column);
-            }
-            // If not, return an UNKNOWN token for ':'
-            return Token(TokenType::UNKNOWN, ":", line, column);
-        case '<':
-            return Token(TokenType::LESSTHAN, "<", line, column);
-        case '=':
-            return Token(TokenType::EQUAL, "=", line, column);
+            // Tokens never span a newline, the column just moves past the token
+            column += static_cast<int>(pos - start);
+            positionOffset = pos;
         }
 
-        // Identifiers and keywords
-        if (std::isalpha(current))
-        {
-            std::string identifier(1, current); // Start building the identifier
+        return ValuePolicy::make(type, input.substr(start, pos - start), tokenLine(), tokenColumn());
+    }
 
-            // Continue consuming alphabetic characters
-            while (std::isalpha(peek()))
-            {
-                identifier += get();
-            }
+    // The line number given to tokens, 0 without position tracking
+    template <class PositionPolicy, class ValuePolicy>
+    int BasicScanner<PositionPolicy, ValuePolicy>::tokenLine() const
+    {
+        return PositionPolicy::enabled ? line : 0;
+    }
 
-            // Check if the identifier matches any reserved keywords
-            if (identifier == "if")
-                return Token(TokenType::IF, identifier, line, column);
-            if (identifier == "then")
-                return Token(TokenType::THEN, identifier, line, column);
-            if (identifier == "end")
-                return Token(TokenType::END, identifier, line, column);
-            if (identifier == "repeat")
-                return Token(TokenType::REPEAT, identifier, line, column);
-            if (identifier == "until")
-                return Token(TokenType::UNTIL, identifier, line, column);
-            if (identifier == "read")
-                return Token(TokenType::READ, identifier, line, column);
-            if (identifier == "write")
-                return Token(TokenType::WRITE, identifier, line, column);
-
-            // If not a keyword, it's an identifier
-            return Token(TokenType::IDENTIFIER, identifier, line, column);
-        }
+    // The column number given to tokens, 0 without position tracking
+    template <class PositionPolicy, class ValuePolicy>
+    int BasicScanner<PositionPolicy, ValuePolicy>::tokenColumn() const
+    {
+        return PositionPolicy::enabled ? column : 0;
+    }
 
-        // Numbers (integer literals)
-        if (std::isdigit(current))
+    // Recognizes the token at the current position with the DFA and advances past it
+    template <class PositionPolicy, class ValuePolicy>
+    TokenType BasicScanner<PositionPolicy, ValuePolicy>::scanLexeme()
+    {
+        // Run the DFA from the current position until it reaches a final state
+        const size_t start = pos;
+        size_t cursor = pos;
+        LEXER::State state = LEXER::START;
+        while (true)
         {
-            std::string number(1, current); // Start building the number literal
-
-            // Continue consuming digit characters
-            while (std::isdigit(peek()))
+            LEXER::CharClass charClass = cursor < input.size() ? LEXER::classOf(input[cursor]) : LEXER::END_OF_DATA;
+            state = LEXER::transitions[state][charClass];
+            if (state >= LEXER::FIRST_FINAL)
             {
-                number += get();
+                break;
             }
-
-            // Return a NUMBER token
-            return Token(TokenType::NUMBER, number, line, column);
+            ++cursor;
+        }
+        if (LEXER::consumesLastByte[state])
+        {
+            ++cursor;
         }
 
-        // If the character doesn't match any known token patterns, return an UNKNOWN token
-        return Token(TokenType::UNKNOWN, std::string(1, current), line, column);
+        // Advance past the token
+        pos = cursor;
+
+        return LEXER::tokenTypeOf(state, input.substr(start, cursor - start));
     }
 
     // Checks if there are more tokens to be extracted
-    bool Scanner::hasMoreTokens()
+    template <class PositionPolicy, class ValuePolicy>
+    bool BasicScanner<PositionPolicy, ValuePolicy>::hasMoreTokens()
     {
         // Save the current state to avoid modifying the scanner's actual state
-        size_t tempPos = pos;
-        int tempLine = line;
-        int tempColumn = column;
+        const Checkpoint start = save();
 
         // Temporarily skip whitespace and comments
         bool unclosedComment = skipWhitespaceAndComments();
@@ -139,15 +149,129 @@ namespace TINY::SCANNER
         bool hasMore = (pos < input.size()) && !unclosedComment;
 
         // Restore the scanner's state
-        pos = tempPos;
-        line = tempLine;
-        column = tempColumn;
+        restore(start);
 
         return hasMore;
     }
 
+    // Saves the current scanning state
+    template <class PositionPolicy, class ValuePolicy>
+    typename BasicScanner<PositionPolicy, ValuePolicy>::Checkpoint BasicScanner<PositionPolicy, ValuePolicy>::save() const
+    {
+        Checkpoint checkpoint;
+        checkpoint.pos = pos;
+        checkpoint.commentDepth = commentDepth;
+        checkpoint.positionOffset = positionOffset;
+        checkpoint.line = line;
+        checkpoint.column = column;
+        checkpoint.generation = generation;
+        return checkpoint;
+    }
+
+    // Returns to a saved scanning state
+    template <class PositionPolicy, class ValuePolicy>
+    void BasicScanner<PositionPolicy, ValuePolicy>::restore(const Checkpoint &checkpoint)
+    {
+        if (checkpoint.generation != Checkpoint::ANY_INPUT && checkpoint.generation != generation)
+        {
+            throw std::invalid_argument("Checkpoint was saved on a previous input");
+        }
+        if (checkpoint.pos > input.size())
+        {
+            throw std::out_of_range("Checkpoint lies past the end of the input");
+        }
+        pos = checkpoint.pos;
+        commentDepth = checkpoint.commentDepth;
+        positionOffset = checkpoint.positionOffset;
+        line = checkpoint.line;
+        column = checkpoint.column;
+    }
+
+    // Returns a lazy range over the remaining tokens
+    template <class PositionPolicy, class ValuePolicy>
+    typename BasicScanner<PositionPolicy, ValuePolicy>::TokenRange BasicScanner<PositionPolicy, ValuePolicy>::tokens()
+    {
+        return TokenRange(*this);
+    }
+
+    // Constructor: Views the remaining tokens of the scanner
+    template <class PositionPolicy, class ValuePolicy>
+    BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::TokenRange(BasicScanner &scanner) : scanner(scanner)
+    {
+    }
+
+    // Scans the first remaining token
+    template <class PositionPolicy, class ValuePolicy>
+    typename BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::iterator BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::begin()
+    {
+        return iterator(scanner);
+    }
+
+    // Returns the end iterator
+    template <class PositionPolicy, class ValuePolicy>
+    typename BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::iterator BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::end()
+    {
+        return iterator();
+    }
+
+    // Constructor: Scans the next token of the scanner
+    template <class PositionPolicy, class ValuePolicy>
+    BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::iterator::iterator(BasicScanner &scanner) : scanner(&scanner)
+    {
+        ++*this;
+    }
+
+    // Returns the current token
+    template <class PositionPolicy, class ValuePolicy>
+    const typename BasicScanner<PositionPolicy, ValuePolicy>::Result &BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::iterator::operator*() const
+    {
+        return *current;
+    }
+
+    // Returns a pointer to the current token
+    template <class PositionPolicy, class ValuePolicy>
+    const typename BasicScanner<PositionPolicy, ValuePolicy>::Result *BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::iterator::operator->() const
+    {
+        return &*current;
+    }
+
+    // Scans the next token, the end of input turns the iterator into the end iterator
+    template <class PositionPolicy, class ValuePolicy>
+    typename BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::iterator &BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::iterator::operator++()
+    {
+        current.emplace(scanner->getNextToken());
+        if (current->getType() == TokenType::END_OF_INPUT)
+        {
+            scanner = nullptr;
+            current.reset();
+        }
+        return *this;
+    }
+
+    // Scans the next token
+    template <class PositionPolicy, class ValuePolicy>
+    void BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::iterator::operator++(int)
+    {
+        ++*this;
+    }
+
+    // Iterators compare equal when both or neither are at the end
+    template <class PositionPolicy, class ValuePolicy>
+    bool BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::iterator::operator==(const iterator &other) const
+    {
+        return (scanner == nullptr) == (other.scanner == nullptr);
+    }
+
+    // Iterators differ when exactly one is at the end
+    template <class PositionPolicy, class ValuePolicy>
+    bool BasicScanner<PositionPolicy, ValuePolicy>::TokenRange::iterator::operator!=(const iterator &other) const
+    {
+        return !(*this == other);
+    }
+
     // Skips over whitespace and comments in the input
-    bool Scanner::skipWhitespaceAndComments()
+    template <class PositionPolicy, class ValuePolicy>
+    bool BasicScanner<PositionPolicy, ValuePolicy>::skipWhitespaceAndComments()
     {
         while (true)
         {
@@ -161,7 +285,7 @@ namespace TINY::SCANNER
             }
 
             // If no more whitespace or comments, break out of the loop
-            if (!std::isspace(peek()) && peek() != '{')
+            if (!LEXER::isSpace(peek()) && peek() != '{')
             {
                 break;
             }
@@ -171,87 +295,143 @@ namespace TINY::SCANNER
     }
 
     // Skips over whitespace characters in the input
-    void Scanner::skipWhitespace()
+    template <class PositionPolicy, class ValuePolicy>
+    void BasicScanner<PositionPolicy, ValuePolicy>::skipWhitespace()
     {
-        // Consume all consecutive whitespace characters
-        while (pos < input.size() && std::isspace(peek()))
+        const char *begin = input.data() + pos;
+        const char *end = input.data() + input.size();
+
+        // Most runs are a single separator or a short indentation, check those without a kernel call
+        const char *cursor = begin;
+        const char *shortRunEnd = static_cast<size_t>(end - begin) > SHORT_RUN ? begin + SHORT_RUN : end;
+        while (cursor < shortRunEnd && LEXER::isSpace(*cursor))
+        {
+            ++cursor;
+        }
+
+        // Long runs: find the first non-whitespace byte a vector at a time
+        if (cursor == begin + SHORT_RUN)
         {
-            get(); // Consume the whitespace character
+            cursor = SIMD::findNonSpace(cursor, end);
         }
+
+        pos = static_cast<size_t>(cursor - input.data());
     }
 
     // Skips over comments in the input source code
-    bool Scanner::skipComments()
+    template <class PositionPolicy, class ValuePolicy>
+    bool BasicScanner<PositionPolicy, ValuePolicy>::skipComments()
     {
-        if (pos < input.size() && peek() == '{')
+        // Not inside a comment and no comment starts here
+        if (commentDepth == 0 && (pos >= input.size() || peek() != '{'))
         {
-            get(); // Consume initial '{'
-            std::stack<char> commentStack;
-            commentStack.push('{'); // Push the initial '{' onto the stack
+            return false; // No comment to skip
+        }
 
-            while (pos < input.size())
+        const char *cursor = input.data() + pos;
+        const char *end = input.data() + input.size();
+        if (commentDepth == 0)
+        {
+            ++cursor;         // Skip the initial '{'
+            commentDepth = 1; // Nesting level of the comment
+        }
+
+        while (true)
+        {
+            // Only '{', '}' and '\0' matter inside a comment, jump straight to the next one
+            cursor = SIMD::findCommentDelimiter(cursor, end);
+            if (cursor == end)
             {
-                char currentChar = get();
+                // EOF reached before all comments were closed
+                pos = input.size();
+                commentDepth = 0;
+                return true; // Unclosed comment detected
+            }
 
-                if (currentChar == '{')
-                {
-                    commentStack.push('{'); // Push nested '{' onto the stack
-                }
-                else if (currentChar == '}')
-                {
-                    commentStack.pop(); // Pop a '{' from the stack
-
-                    if (commentStack.empty())
-                    {
-                        // All comments are closed
-                        skipWhitespace(); // Skip whitespace after comment
-                        return false;     // Comment was successfully skipped
-                    }
-                }
-                else if (currentChar == '\0')
+            char currentChar = *cursor++;
+            if (currentChar == '{')
+            {
+                commentDepth++; // Nested comment opened
+            }
+            else if (currentChar == '}')
+            {
+                if (--commentDepth == 0)
                 {
-                    // End of input reached unexpectedly
-                    return true; // Unclosed comment detected
+                    // All comments are closed
+                    pos = static_cast<size_t>(cursor - input.data());
+                    skipWhitespace(); // Skip whitespace after comment
+                    return false;     // Comment was successfully skipped
                 }
-                // Continue consuming characters inside the comment
             }
-
-            // EOF reached before all comments were closed
-            return true; // Unclosed comment detected
+            else
+            {
+                // A '\0' inside a comment ends the input, nothing after it is scanned
+                pos = input.size();
+                commentDepth = 0;
+                return true; // Unclosed comment detected
+            }
         }
-        return false; // No comment to skip
     }
 
     // Peeks at the next character in the input without advancing the position
-    char Scanner::peek() const
+    template <class PositionPolicy, class ValuePolicy>
+    char BasicScanner<PositionPolicy, ValuePolicy>::peek() const
     {
         // Return the next character if within bounds, or '\0' if at the end
         return pos < input.size() ? input[pos] : '\0';
     }
 
-    // Gets the next character in the input and advances the position
-    char Scanner::get()
+    // Counts the lines and columns of the bytes passed since the last sync
+    template <class PositionPolicy, class ValuePolicy>
+    void BasicScanner<PositionPolicy, ValuePolicy>::syncPosition()
     {
-        // Check if at the end of input
-        if (pos >= input.size())
+        const size_t target = pos;
+        const char *begin = input.data() + positionOffset;
+        const char *end = input.data() + target;
+
+        // Short ranges are cheaper to walk than to hand to a kernel
+        if (target - positionOffset <= SHORT_RUN)
         {
-            return '\0';
+            for (const char *cursor = begin; cursor < end; ++cursor)
+            {
+                if (*cursor == '\n')
+                {
+                    line++;     // Move to the next line
+                    column = 1; // Reset column number
+                }
+                else
+                {
+                    column++; // Move to the next column
+                }
+            }
+            positionOffset = target;
+            return;
         }
 
-        char currentChar = input[pos++]; // Get the current character and advance position
-
-        // Update line and column numbers for error reporting and tracking
-        if (currentChar == '\n')
+        size_t newlines = SIMD::countNewlines(begin, end);
+        if (newlines == 0)
         {
-            line++;     // Move to the next line
-            column = 1; // Reset column number
+            column += static_cast<int>(target - positionOffset); // Still on the same line
         }
         else
         {
-            column++; // Move to the next column
+            // Move down the skipped lines, the column restarts after the last newline
+            const char *lastNewline = end - 1;
+            while (*lastNewline != '\n')
+            {
+                --lastNewline;
+            }
+            line += static_cast<int>(newlines);
+            column = static_cast<int>(end - lastNewline);
         }
 
-        return currentChar;
+        positionOffset = target;
     }
 
+    // The combinations of policies, compiled once here for every user of scanner.hpp
+    template class BasicScanner<TrackPositions, ViewValues>;
+    template class BasicScanner<TrackPositions, NoValues>;
+    template class BasicScanner<NoPositions, ViewValues>;
+    template class BasicScanner<NoPositions, NoValues>;
+
 } // namespace TINY::SCANNER
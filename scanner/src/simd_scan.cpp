@@ -0,0 +1,304 @@
+/**
+ * @file simd_scan.cpp
+ * @brief Implements the vectorized byte-search kernels and their runtime dispatch.
+ *
+ * The SSE2 and AVX2 kernels compare a whole vector of input bytes at once, turn the
+ * comparison result into a bit mask with `movemask`, and locate the first interesting
+ * byte with a count-trailing-zeros instruction. The bytes left over after the last full
+ * vector are handled by the scalar kernel.
+ *
+ * The kernels are compiled with per-function target attributes, so the rest of the
+ * scanner does not need to be built with `-mavx2`; the AVX2 kernel is only called after
+ * CPUID reports AVX2 support.
+ */
+
+#include "simd_scan.hpp"
+#include "lexer_tables.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TINY_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define TINY_SIMD_X86 0
+#endif
+
+namespace TINY::SCANNER::SIMD
+{
+
+    namespace
+    {
+        // ---------------------------------------------------------------------
+        // Scalar kernels
+        // ---------------------------------------------------------------------
+
+        const char *findNonSpaceScalar(const char *begin, const char *end)
+        {
+            while (begin < end && LEXER::isSpace(*begin))
+            {
+                ++begin;
+            }
+            return begin;
+        }
+
+        const char *findCommentDelimiterScalar(const char *begin, const char *end)
+        {
+            while (begin < end && *begin != '{' && *begin != '}' && *begin != '\0')
+            {
+                ++begin;
+            }
+            return begin;
+        }
+
+        std::size_t countNewlinesScalar(const char *begin, const char *end)
+        {
+            return static_cast<std::size_t>(std::count(begin, end, '\n'));
+        }
+
+#if TINY_SIMD_X86
+
+        // ---------------------------------------------------------------------
+        // SSE2 kernels (16 bytes per step)
+        // ---------------------------------------------------------------------
+
+        // Mask of the whitespace bytes: ' ' or '\t'..'\r' (0x09..0x0D)
+        __attribute__((target("sse2"))) inline __m128i spaceMask128(__m128i bytes)
+        {
+            __m128i offset = _mm_sub_epi8(bytes, _mm_set1_epi8('\t'));
+            __m128i inControlRange = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8('\r' - '\t')), offset);
+            return _mm_or_si128(inControlRange, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')));
+        }
+
+        __attribute__((target("sse2"))) const char *findNonSpaceSse2(const char *begin, const char *end)
+        {
+            while (end - begin >= 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+                unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(spaceMask128(bytes))) & 0xFFFFu;
+                if (mask != 0)
+                {
+                    return begin + __builtin_ctz(mask);
+                }
+                begin += 16;
+            }
+            return findNonSpaceScalar(begin, end);
+        }
+
+        __attribute__((target("sse2"))) const char *findCommentDelimiterSse2(const char *begin, const char *end)
+        {
+            const __m128i open = _mm_set1_epi8('{');
+            const __m128i close = _mm_set1_epi8('}');
+            const __m128i nul = _mm_setzero_si128();
+            while (end - begin >= 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+                __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, open), _mm_cmpeq_epi8(bytes, close)),
+                                            _mm_cmpeq_epi8(bytes, nul));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+                if (mask != 0)
+                {
+                    return begin + __builtin_ctz(mask);
+                }
+                begin += 16;
+            }
+            return findCommentDelimiterScalar(begin, end);
+        }
+
+        __attribute__((target("sse2"))) std::size_t countNewlinesSse2(const char *begin, const char *end)
+        {
+            const __m128i newline = _mm_set1_epi8('\n');
+            std::size_t count = 0;
+            while (end - begin >= 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+                count += static_cast<std::size_t>(
+                    __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)))));
+                begin += 16;
+            }
+            return count + countNewlinesScalar(begin, end);
+        }
+
+        // ---------------------------------------------------------------------
+        // AVX2 kernels (32 bytes per step)
+        // ---------------------------------------------------------------------
+
+        // Mask of the whitespace bytes: ' ' or '\t'..'\r' (0x09..0x0D)
+        __attribute__((target("avx2"))) inline __m256i spaceMask256(__m256i bytes)
+        {
+            __m256i offset = _mm256_sub_epi8(bytes, _mm256_set1_epi8('\t'));
+            __m256i inControlRange = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8('\r' - '\t')), offset);
+            return _mm256_or_si256(inControlRange, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')));
+        }
+
+        __attribute__((target("avx2"))) const char *findNonSpaceAvx2(const char *begin, const char *end)
+        {
+            while (end - begin >= 32)
+            {
+                __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+                std::uint32_t mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(spaceMask256(bytes)));
+                if (mask != 0)
+                {
+                    return begin + __builtin_ctz(mask);
+                }
+                begin += 32;
+            }
+            return findNonSpaceSse2(begin, end);
+        }
+
+        __attribute__((target("avx2"))) const char *findCommentDelimiterAvx2(const char *begin, const char *end)
+        {
+            const __m256i open = _mm256_set1_epi8('{');
+            const __m256i close = _mm256_set1_epi8('}');
+            const __m256i nul = _mm256_setzero_si256();
+            while (end - begin >= 32)
+            {
+                __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+                __m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, open), _mm256_cmpeq_epi8(bytes, close)),
+                                               _mm256_cmpeq_epi8(bytes, nul));
+                std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+                if (mask != 0)
+                {
+                    return begin + __builtin_ctz(mask);
+                }
+                begin += 32;
+            }
+            return findCommentDelimiterSse2(begin, end);
+        }
+
+        __attribute__((target("avx2"))) std::size_t countNewlinesAvx2(const char *begin, const char *end)
+        {
+            const __m256i newline = _mm256_set1_epi8('\n');
+            std::size_t count = 0;
+            while (end - begin >= 32)
+            {
+                __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+                count += static_cast<std::size_t>(
+                    __builtin_popcount(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, newline)))));
+                begin += 32;
+            }
+            return count + countNewlinesSse2(begin, end);
+        }
+
+#endif // TINY_SIMD_X86
+
+        // ---------------------------------------------------------------------
+        // Dispatch
+        // ---------------------------------------------------------------------
+
+        // The function pointers of one kernel
+        struct KernelTable
+        {
+            Kernel kernel;
+            const char *(*findNonSpace)(const char *, const char *);
+            const char *(*findCommentDelimiter)(const char *, const char *);
+            std::size_t (*countNewlines)(const char *, const char *);
+        };
+
+        constexpr KernelTable scalarKernel = {Kernel::SCALAR, findNonSpaceScalar, findCommentDelimiterScalar, countNewlinesScalar};
+#if TINY_SIMD_X86
+        constexpr KernelTable sse2Kernel = {Kernel::SSE2, findNonSpaceSse2, findCommentDelimiterSse2, countNewlinesSse2};
+        constexpr KernelTable avx2Kernel = {Kernel::AVX2, findNonSpaceAvx2, findCommentDelimiterAvx2, countNewlinesAvx2};
+#endif
+
+        // Checks whether the CPU running the program supports a kernel
+        bool isSupported(Kernel kernel)
+        {
+            switch (kernel)
+            {
+            case Kernel::SCALAR:
+                return true;
+#if TINY_SIMD_X86
+            case Kernel::SSE2:
+                return __builtin_cpu_supports("sse2");
+            case Kernel::AVX2:
+                return __builtin_cpu_supports("avx2");
+#endif
+            default:
+                return false;
+            }
+        }
+
+        // Picks the fastest kernel supported by the CPU
+        const KernelTable *detectKernel()
+        {
+#if TINY_SIMD_X86
+            __builtin_cpu_init();
+            if (isSupported(Kernel::AVX2))
+            {
+                return &avx2Kernel;
+            }
+            if (isSupported(Kernel::SSE2))
+            {
+                return &sse2Kernel;
+            }
+#endif
+            return &scalarKernel;
+        }
+
+        // The kernel in use, selected on first use
+        const KernelTable *&currentKernel()
+        {
+            static const KernelTable *kernel = detectKernel();
+            return kernel;
+        }
+    } // namespace
+
+    const char *findNonSpace(const char *begin, const char *end)
+    {
+        return currentKernel()->findNonSpace(begin, end);
+    }
+
+    const char *findCommentDelimiter(const char *begin, const char *end)
+    {
+        return currentKernel()->findCommentDelimiter(begin, end);
+    }
+
+    std::size_t countNewlines(const char *begin, const char *end)
+    {
+        return currentKernel()->countNewlines(begin, end);
+    }
+
+    Kernel activeKernel()
+    {
+        return currentKernel()->kernel;
+    }
+
+    bool selectKernel(Kernel kernel)
+    {
+        if (!isSupported(kernel))
+        {
+            return false;
+        }
+
+        switch (kernel)
+        {
+#if TINY_SIMD_X86
+        case Kernel::AVX2:
+            currentKernel() = &avx2Kernel;
+            return true;
+        case Kernel::SSE2:
+            currentKernel() = &sse2Kernel;
+            return true;
+#endif
+        default:
+            currentKernel() = &scalarKernel;
+            return true;
+        }
+    }
+
+    std::string_view kernelName(Kernel kernel)
+    {
+        switch (kernel)
+        {
+        case Kernel::AVX2:
+            return "avx2";
+        case Kernel::SSE2:
+            return "sse2";
+        default:
+            return "scalar";
+        }
+    }
+
+} // namespace TINY::SCANNER::SIMD
@@ -0,0 +1,225 @@
+/**
+ * @file stream_scanner.cpp
+ * @brief Implements the StreamScanner class for tokenizing input delivered in chunks.
+ *
+ * The StreamScanner runs the same DFA and the same SIMD skipping kernels as the Scanner,
+ * but every loop stops at the end of the current chunk instead of the end of the input.
+ * Whatever is in progress at that point (a token's DFA state and text, or the comment
+ * nesting depth) is kept in members and picked up again by the next `feed()`.
+ */
+
+#include "stream_scanner.hpp"
+#include "simd_scan.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TINY::SCANNER
+{
+
+    // Constructor: Initializes the StreamScanner with the token callback and the token length limit
+    StreamScanner::StreamScanner(TokenHandler onToken, std::size_t maxTokenLength)
+        : onToken(std::move(onToken)), maxTokenLength(maxTokenLength)
+    {
+    }
+
+    // Scans the next chunk of the input
+    void StreamScanner::feed(std::string_view chunk)
+    {
+        const char *cursor = chunk.data();
+        const char *end = chunk.data() + chunk.size();
+
+        while (cursor < end && !stopped)
+        {
+            // Resume whatever the previous chunk left in progress
+            if (commentDepth > 0)
+            {
+                cursor = skipComment(cursor, end);
+            }
+            else if (state != LEXER::START)
+            {
+                cursor = scanToken(cursor, end);
+            }
+            else if (LEXER::isSpace(*cursor))
+            {
+                // Skip whitespace a vector at a time
+                const char *next = SIMD::findNonSpace(cursor, end);
+                advance(cursor, next);
+                cursor = next;
+            }
+            else if (*cursor == '{')
+            {
+                // Start of a comment
+                commentDepth = 1;
+                advance(cursor, cursor + 1);
+                cursor = skipComment(cursor + 1, end);
+            }
+            else
+            {
+                cursor = scanToken(cursor, end);
+            }
+        }
+    }
+
+    // Signals the end of the input
+    void StreamScanner::finish()
+    {
+        if (stopped)
+        {
+            return;
+        }
+
+        // The end of input ends the pending token, if any
+        if (state != LEXER::START)
+        {
+            emit(LEXER::transitions[state][LEXER::END_OF_DATA], pending);
+        }
+
+        unclosedComment = commentDepth > 0;
+        stopped = true;
+    }
+
+    // Reads a stream in fixed-size buffers and scans it to the end
+    std::size_t StreamScanner::scan(std::istream &input, std::size_t bufferSize)
+    {
+        std::vector<char> buffer(bufferSize);
+        std::size_t total = 0;
+
+        while (input.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || input.gcount() > 0)
+        {
+            std::size_t count = static_cast<std::size_t>(input.gcount());
+            feed(std::string_view(buffer.data(), count));
+            total += count;
+        }
+
+        finish();
+        return total;
+    }
+
+    // Checks whether scanning stopped at an unclosed comment
+    bool StreamScanner::hasUnclosedComment() const
+    {
+        return unclosedComment;
+    }
+
+    // Skips comment bytes until the comment is closed or the chunk ends
+    const char *StreamScanner::skipComment(const char *cursor, const char *end)
+    {
+        const char *begin = cursor;
+
+        while (true)
+        {
+            // Only '{', '}' and '\0' matter inside a comment, jump straight to the next one
+            cursor = SIMD::findCommentDelimiter(cursor, end);
+            if (cursor == end)
+            {
+                break; // The comment continues in the next chunk
+            }
+
+            char currentChar = *cursor++;
+            if (currentChar == '{')
+            {
+                commentDepth++; // Nested comment opened
+            }
+            else if (currentChar == '}')
+            {
+                if (--commentDepth == 0)
+                {
+                    break; // All comments are closed
+                }
+            }
+            else
+            {
+                // '\0' inside a comment ends scanning like the end of input does
+                stopped = true;
+                unclosedComment = true;
+                break;
+            }
+        }
+
+        advance(begin, cursor);
+        return cursor;
+    }
+
+    // Runs the DFA over the chunk until the current token ends or the chunk ends
+    const char *StreamScanner::scanToken(const char *cursor, const char *end)
+    {
+        const char *begin = cursor;
+
+        while (cursor < end)
+        {
+            LEXER::State next = LEXER::transitions[state][LEXER::classOf(*cursor)];
+            if (next >= LEXER::FIRST_FINAL)
+            {
+                if (LEXER::consumesLastByte[next])
+                {
+                    ++cursor;
+                }
+                checkTokenLength(pending.size() + static_cast<std::size_t>(cursor - begin));
+                column += static_cast<int>(cursor - begin);
+
+                // a token that started in this chunk is handed out in place, only one cut by
+                // the previous chunk boundary has its text in the pending buffer
+                if (pending.empty())
+                {
+                    emit(next, std::string_view(begin, static_cast<std::size_t>(cursor - begin)));
+                }
+                else
+                {
+                    pending.append(begin, cursor);
+                    emit(next, pending);
+                }
+                return cursor;
+            }
+            state = next;
+            ++cursor;
+        }
+
+        // The token may continue in the next chunk, keep its text so far
+        checkTokenLength(pending.size() + static_cast<std::size_t>(cursor - begin));
+        pending.append(begin, cursor);
+        column += static_cast<int>(cursor - begin);
+        return cursor;
+    }
+
+    // Throws if the token is longer than the limit, before its text is buffered
+    void StreamScanner::checkTokenLength(std::size_t length) const
+    {
+        if (length > maxTokenLength)
+        {
+            throw std::runtime_error("Token at line " + std::to_string(line) + " is longer than " +
+                                     std::to_string(maxTokenLength) + " bytes.");
+        }
+    }
+
+    // Emits the token ending in the given final state
+    void StreamScanner::emit(LEXER::State finalState, std::string_view value)
+    {
+        onToken(Token(LEXER::tokenTypeOf(finalState, value), value, line, column));
+        pending.clear();
+        state = LEXER::START;
+    }
+
+    // Updates the line and column numbers for the skipped bytes
+    void StreamScanner::advance(const char *begin, const char *end)
+    {
+        std::size_t newlines = SIMD::countNewlines(begin, end);
+        if (newlines == 0)
+        {
+            column += static_cast<int>(end - begin); // Still on the same line
+            return;
+        }
+
+        // Move down the skipped lines, the column restarts after the last newline
+        const char *lastNewline = end - 1;
+        while (*lastNewline != '\n')
+        {
+            --lastNewline;
+        }
+        line += static_cast<int>(newlines);
+        column = static_cast<int>(end - lastNewline);
+    }
+
+} // namespace TINY::SCANNER
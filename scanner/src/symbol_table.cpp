@@ -0,0 +1,191 @@
+/**
+ * @file symbol_table.cpp
+ * @brief Implements the SymbolTable class for interning identifier spellings.
+ *
+ * Spellings are appended to the current arena block until it is full, then a new block is
+ * started; the blocks are never reallocated, so the stored views stay valid for the
+ * lifetime of the table. The hash table only stores symbol IDs; probing compares the
+ * stored hash before the spelling.
+ */
+
+#include "symbol_table.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace TINY::SCANNER
+{
+
+    // Copy constructor: Re-interns every spelling so the copy has its own arena and the same IDs
+    SymbolTable::SymbolTable(const SymbolTable &other)
+    {
+        spellings.reserve(other.spellings.size());
+        hashes.reserve(other.hashes.size());
+        for (std::string_view text : other.spellings)
+        {
+            intern(text);
+        }
+    }
+
+    // Copy assignment: Builds the copy first, then takes it over
+    SymbolTable &SymbolTable::operator=(const SymbolTable &other)
+    {
+        if (this != &other)
+        {
+            SymbolTable copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    // Move constructor: The arena blocks do not move, so the views and map keys stay valid
+    SymbolTable::SymbolTable(SymbolTable &&other) noexcept
+        : blocks(std::move(other.blocks)), currentBlock(other.currentBlock), blockUsed(other.blockUsed),
+          spellings(std::move(other.spellings)), hashes(std::move(other.hashes)), slots(std::move(other.slots))
+    {
+        other.clear();
+    }
+
+    // Move assignment: Takes over the arena and leaves the other table empty
+    SymbolTable &SymbolTable::operator=(SymbolTable &&other) noexcept
+    {
+        if (this != &other)
+        {
+            blocks = std::move(other.blocks);
+            currentBlock = other.currentBlock;
+            blockUsed = other.blockUsed;
+            spellings = std::move(other.spellings);
+            hashes = std::move(other.hashes);
+            slots = std::move(other.slots);
+            other.clear();
+        }
+        return *this;
+    }
+
+    // Returns the ID of a spelling, adding the spelling if it is new
+    std::uint32_t SymbolTable::intern(std::string_view spelling)
+    {
+        // Keep the table at most half full
+        if ((spellings.size() + 1) * 2 > slots.size())
+        {
+            grow();
+        }
+
+        std::uint32_t spellingHash = hash(spelling);
+        std::size_t slot = findSlot(spelling, spellingHash);
+        if (slots[slot] != NO_SYMBOL)
+        {
+            return slots[slot];
+        }
+
+        std::uint32_t symbol = static_cast<std::uint32_t>(spellings.size());
+        spellings.push_back(store(spelling));
+        hashes.push_back(spellingHash);
+        slots[slot] = symbol;
+        return symbol;
+    }
+
+    // Returns the ID of a spelling, or NO_SYMBOL if it was never interned
+    std::uint32_t SymbolTable::find(std::string_view spelling) const
+    {
+        if (slots.empty())
+        {
+            return NO_SYMBOL;
+        }
+        return slots[findSlot(spelling, hash(spelling))];
+    }
+
+    // Returns the spelling of a symbol
+    std::string_view SymbolTable::spelling(std::uint32_t symbol) const
+    {
+        return spellings[symbol];
+    }
+
+    // Returns the number of distinct symbols
+    std::size_t SymbolTable::size() const
+    {
+        return spellings.size();
+    }
+
+    // Removes all symbols
+    void SymbolTable::clear()
+    {
+        slots.clear();
+        hashes.clear();
+        spellings.clear();
+        blocks.clear();
+        currentBlock = nullptr;
+        blockUsed = 0;
+    }
+
+    // Hashes a spelling with 32-bit FNV-1a
+    std::uint32_t SymbolTable::hash(std::string_view text)
+    {
+        std::uint32_t value = 2166136261u;
+        for (char c : text)
+        {
+            value = (value ^ static_cast<unsigned char>(c)) * 16777619u;
+        }
+        return value;
+    }
+
+    // Probes linearly from the spelling's home slot
+    std::size_t SymbolTable::findSlot(std::string_view text, std::uint32_t textHash) const
+    {
+        std::size_t mask = slots.size() - 1;
+        std::size_t slot = textHash & mask;
+        while (slots[slot] != NO_SYMBOL)
+        {
+            std::uint32_t symbol = slots[slot];
+            if (hashes[symbol] == textHash && spellings[symbol] == text)
+            {
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    // Doubles the hash table, placing the symbols by their stored hashes
+    void SymbolTable::grow()
+    {
+        std::size_t capacity = slots.empty() ? 64 : slots.size() * 2;
+        slots.assign(capacity, NO_SYMBOL);
+        for (std::uint32_t symbol = 0; symbol < spellings.size(); ++symbol)
+        {
+            std::size_t slot = hashes[symbol] & (capacity - 1);
+            while (slots[slot] != NO_SYMBOL)
+            {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            slots[slot] = symbol;
+        }
+    }
+
+    // Copies a spelling into the arena
+    std::string_view SymbolTable::store(std::string_view text)
+    {
+        // Spellings longer than a block get a block of their own, the current block stays open
+        if (text.size() > BLOCK_SIZE)
+        {
+            blocks.emplace_back(new char[text.size()]);
+            char *copy = blocks.back().get();
+            std::memcpy(copy, text.data(), text.size());
+            return std::string_view(copy, text.size());
+        }
+
+        // Start a new block when the spelling does not fit in the current one
+        if (currentBlock == nullptr || BLOCK_SIZE - blockUsed < text.size())
+        {
+            blocks.emplace_back(new char[BLOCK_SIZE]);
+            currentBlock = blocks.back().get();
+            blockUsed = 0;
+        }
+
+        char *copy = currentBlock + blockUsed;
+        std::memcpy(copy, text.data(), text.size());
+        blockUsed += text.size();
+        return std::string_view(copy, text.size());
+    }
+
+} // namespace TINY::SCANNER
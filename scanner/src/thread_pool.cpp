@@ -0,0 +1,164 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implements the ThreadPool class with per-worker queues and work stealing.
+ *
+ * Submitting a task pushes it onto the next queue in turn and wakes one worker. A worker
+ * pops from the back of its own queue and steals from the front of the others. The
+ * shared counters are only used to put idle workers to sleep and to implement wait().
+ */
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace TINY::SCANNER
+{
+
+    // Constructor: Creates one queue per worker, then starts the workers
+    ThreadPool::ThreadPool(std::size_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        queues.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            queues.push_back(std::make_unique<Queue>());
+        }
+
+        workers.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            workers.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    // Destructor: Lets the workers drain the queues, then joins them
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            stopping = true;
+        }
+        taskQueued.notify_all();
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    // Queues a task on the next worker in turn
+    void ThreadPool::submit(Task task)
+    {
+        Queue &queue = *queues[nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            ++queuedTasks;
+            ++pendingTasks;
+        }
+        taskQueued.notify_one();
+    }
+
+    // Waits for the pending tasks, then reports the first error
+    void ThreadPool::wait()
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        allFinished.wait(lock, [this]
+                         { return pendingTasks == 0; });
+
+        if (firstError)
+        {
+            std::exception_ptr error = std::exchange(firstError, nullptr);
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Returns the number of workers
+    std::size_t ThreadPool::size() const
+    {
+        return workers.size();
+    }
+
+    // Sleeps until a task is queued, runs it, and repeats until the pool stops
+    void ThreadPool::workerLoop(std::size_t index)
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(stateMutex);
+                taskQueued.wait(lock, [this]
+                                { return queuedTasks > 0 || stopping; });
+                if (queuedTasks == 0)
+                {
+                    return;
+                }
+                // claim one queued task; tasks are pushed before they are counted and only
+                // claiming workers take them, so the queues hold at least one per claim
+                --queuedTasks;
+            }
+
+            // a sweep can miss a task that moved behind it while other workers took theirs
+            std::optional<Task> task;
+            while (!(task = takeTask(index)))
+            {
+                std::this_thread::yield();
+            }
+
+            std::exception_ptr error;
+            try
+            {
+                (*task)();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (error && !firstError)
+            {
+                firstError = error;
+            }
+            if (--pendingTasks == 0)
+            {
+                allFinished.notify_all();
+            }
+        }
+    }
+
+    // Pops the newest own task, or steals the oldest task of another worker
+    std::optional<ThreadPool::Task> ThreadPool::takeTask(std::size_t index)
+    {
+        for (std::size_t offset = 0; offset < queues.size(); ++offset)
+        {
+            Queue &queue = *queues[(index + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                continue;
+            }
+
+            Task task;
+            if (offset == 0)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            return task;
+        }
+        return std::nullopt;
+    }
+
+} // namespace TINY::SCANNER
@@ -4,7 +4,7 @@
  *
  * This file contains the implementation of the Token class, which represents the fundamental units
  * of the TINY language. The key functionalities provided by the Token class include:
- * - Storing information about a token's type, value, and position in the source code.
+ * - Storing a token's type, a view of its value, and its position in the source code.
  * - Converting token details into a string representation for easy debugging and reporting.
  * - Mapping the TokenType enumeration to human-readable strings for better interpretability.
  *
@@ -13,15 +13,14 @@
  */
 
 #include "token.hpp"
-#include <sstream>
-#include <stdexcept>
+#include "token_writer.hpp"
 
 namespace TINY::SCANNER
 {
 
-    // Constructor to initialize the token with its type, value, and position
+    // Constructor to initialize the token with its type, borrowed value, and position
     Token::Token(TokenType type, std::string_view value, int line, int column)
-        : type(type), value(value), line(line), column(column)
+        : data(value.data()), length(static_cast<std::uint32_t>(value.size())), line(line), column(column), type(type)
     {
     }
 
@@ -31,10 +30,10 @@ namespace TINY::SCANNER
         return type;
     }
 
-    // Returns the value of the token as a string
-    std::string Token::getValue() const
+    // Returns the value of the token as a view of the borrowed characters
+    std::string_view Token::getValue() const
     {
-        return value;
+        return std::string_view(data, length);
     }
 
     // Returns the line number where the token was found
@@ -49,40 +48,13 @@ namespace TINY::SCANNER
         return column;
     }
 
-    // Converts the token type to its string representation using a lookup table
-    std::string_view Token::getTokenTypeString() const
-    {
-        size_t index = static_cast<size_t>(type);
-
-        // Ensure the index is valid and within range
-        if (index >= tokenTypeStrings.size())
-        {
-            throw std::out_of_range("Invalid TokenType index");
-        }
-
-        // Return the string representation of the token type
-        return tokenTypeStrings[index];
-    }
-
     // Converts the token to a detailed string representation
     std::string Token::toString(bool includePosition) const
     {
-        std::ostringstream oss;
-
-        // Add the token's value as the "Token String"
-        oss << value;
-
-        // Add the token type after the token string, separated by a comma
-        oss << ", " << getTokenTypeString();
-
-        // Optionally include the token's line and column positions
-        if (includePosition)
-        {
-            oss << " [Line: " << line << ", Column: " << column << "]";
-        }
-
-        // Return the final string representation
-        return oss.str();
+        // Format into a string with room for the longest result, then trim it
+        std::string result(TokenWriter::maxFormattedLength(length), '\0');
+        result.resize(TokenWriter::format(result.data(), type, getValue(), line, column, includePosition));
+        return result;
     }
 
 } // namespace TINY::SCANNER
@@ -0,0 +1,198 @@
+/**
+ * @file token_file.cpp
+ * @brief Implements the binary token file writer and its memory-mapped reader.
+ *
+ * The writer emits a placeholder header, then one record per token, and finally the
+ * string pool, after which it seeks back to fill in the header. Distinct values are
+ * tracked with a SymbolTable, whose symbol order is the order of the pool. Integers are
+ * written in host byte order. The reader maps the file, checks the header (its byte order
+ * included) and the bounds of the records and the pool, and then serves tokens straight
+ * from the mapping.
+ */
+
+#include "token_file.hpp"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // The magic bytes at the start of every token file
+        constexpr char MAGIC[4] = {'T', 'N', 'Y', 'T'};
+
+        // Builds a header for the given counts
+        TokenFileHeader makeHeader(std::uint64_t tokenCount, std::uint64_t poolSize)
+        {
+            TokenFileHeader header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = TokenFileHeader::VERSION;
+            header.recordSize = sizeof(TokenRecord);
+            header.tokenCount = tokenCount;
+            header.poolSize = poolSize;
+            return header;
+        }
+
+        // Checks whether a version field holds the current version with its two bytes swapped
+        bool isByteSwapped(std::uint16_t version)
+        {
+            const std::uint16_t swapped = static_cast<std::uint16_t>((TokenFileHeader::VERSION << 8) | (TokenFileHeader::VERSION >> 8));
+            return swapped != TokenFileHeader::VERSION && version == swapped;
+        }
+    } // namespace
+
+    // ---------------------------------------------------------------------
+    // TokenFileWriter
+    // ---------------------------------------------------------------------
+
+    // Constructor: Reserves room for the header
+    TokenFileWriter::TokenFileWriter(std::ostream &output) : output(output), start(output.tellp())
+    {
+        TokenFileHeader header = makeHeader(0, 0);
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+
+    // Writes the record of one token, adding its value to the pool if it is new
+    void TokenFileWriter::write(TokenType type, std::string_view value, int line, int column)
+    {
+        // A new value is placed at the end of the pool
+        std::uint32_t symbol = values.intern(value);
+        if (symbol == valueOffsets.size())
+        {
+            if (poolSize + value.size() > std::numeric_limits<std::uint32_t>::max())
+            {
+                throw std::runtime_error("Token file string pool exceeds 4 GiB.");
+            }
+            valueOffsets.push_back(static_cast<std::uint32_t>(poolSize));
+            poolSize += value.size();
+        }
+
+        TokenRecord record{};
+        record.offset = valueOffsets[symbol];
+        record.length = static_cast<std::uint32_t>(value.size());
+        record.line = static_cast<std::uint32_t>(line);
+        record.column = static_cast<std::uint32_t>(column);
+        record.type = type;
+        output.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        ++tokenCount;
+    }
+
+    // Writes the pool, then goes back to fill in the header
+    void TokenFileWriter::finish()
+    {
+        for (std::uint32_t symbol = 0; symbol < values.size(); ++symbol)
+        {
+            std::string_view value = values.spelling(symbol);
+            output.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+        std::streampos end = output.tellp();
+
+        TokenFileHeader header = makeHeader(tokenCount, poolSize);
+        output.seekp(start);
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        output.seekp(end);
+        output.flush();
+
+        if (!output)
+        {
+            throw std::runtime_error("Failed to write the token file.");
+        }
+    }
+
+    // Writes a whole token stream
+    void TokenFileWriter::write(std::ostream &output, const TokenStream &tokens)
+    {
+        TokenFileWriter writer(output);
+        const LineIndex &index = tokens.getLineIndex();
+        std::size_t hint = 0;
+        for (std::size_t i = 0; i < tokens.size(); ++i)
+        {
+            SourcePosition position = index.locate(tokens.getOffsets()[i] + tokens.getLengths()[i], hint);
+            writer.write(tokens.getTypes()[i], tokens.valueAt(i), position.line, position.column);
+        }
+        writer.finish();
+    }
+
+    // ---------------------------------------------------------------------
+    // TokenFile
+    // ---------------------------------------------------------------------
+
+    // Constructor: Maps the file and validates its layout
+    TokenFile::TokenFile(const std::string &filePath) : file(filePath)
+    {
+        std::string_view content = file.view();
+        TokenFileHeader header;
+        if (content.size() < sizeof(header))
+        {
+            throw std::runtime_error("Not a token file (too short): " + filePath);
+        }
+        std::memcpy(&header, content.data(), sizeof(header));
+
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            throw std::runtime_error("Not a token file (bad magic): " + filePath);
+        }
+        if (isByteSwapped(header.version))
+        {
+            throw std::runtime_error("Token file written on a host of the other byte order: " + filePath);
+        }
+        if (header.version != TokenFileHeader::VERSION || header.recordSize != sizeof(TokenRecord))
+        {
+            throw std::runtime_error("Unsupported token file version " + std::to_string(header.version) + ": " + filePath);
+        }
+
+        // The records and the pool must fit in the file exactly
+        std::uint64_t available = content.size() - sizeof(header);
+        if (header.tokenCount > available / sizeof(TokenRecord) ||
+            header.poolSize != available - header.tokenCount * sizeof(TokenRecord))
+        {
+            throw std::runtime_error("Truncated or corrupt token file: " + filePath);
+        }
+
+        count = static_cast<std::size_t>(header.tokenCount);
+        records = reinterpret_cast<const TokenRecord *>(content.data() + sizeof(header));
+        pool = content.substr(sizeof(header) + count * sizeof(TokenRecord));
+
+        // Every value must lie inside the pool, and every type must be one of the token types
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (static_cast<std::uint64_t>(records[i].offset) + records[i].length > pool.size())
+            {
+                throw std::runtime_error("Corrupt token file (value out of bounds): " + filePath);
+            }
+            if (records[i].type > TokenType::END_OF_INPUT)
+            {
+                throw std::runtime_error("Corrupt token file (invalid token type): " + filePath);
+            }
+        }
+    }
+
+    // Returns the number of tokens
+    std::size_t TokenFile::size() const
+    {
+        return count;
+    }
+
+    // Returns the record of a token
+    const TokenRecord &TokenFile::record(std::size_t index) const
+    {
+        return records[index];
+    }
+
+    // Returns the value of a token from the pool
+    std::string_view TokenFile::valueAt(std::size_t index) const
+    {
+        return pool.substr(records[index].offset, records[index].length);
+    }
+
+    // Copies a token out of the file
+    Token TokenFile::toToken(std::size_t index) const
+    {
+        const TokenRecord &token = records[index];
+        return Token(token.type, valueAt(index), static_cast<int>(token.line), static_cast<int>(token.column));
+    }
+
+} // namespace TINY::SCANNER
@@ -0,0 +1,201 @@
+/**
+ * @file token_pipe.cpp
+ * @brief Implements the binary token pipe writer and reader.
+ *
+ * The writer appends each record and its value to a bounded buffer and hands the buffer to
+ * the stream when it fills up or is flushed; nothing is ever written out of order, so the
+ * stream does not have to be seekable. The reader checks the header once and then reads
+ * one record and one value per token until the end record.
+ */
+
+#include "token_pipe.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // The magic bytes at the start of every token pipe
+        constexpr char MAGIC[4] = {'T', 'N', 'Y', 'S'};
+
+        // Checks whether a version field holds the current version with its two bytes swapped
+        bool isByteSwapped(std::uint16_t version)
+        {
+            const std::uint16_t swapped = static_cast<std::uint16_t>((TokenPipeHeader::VERSION << 8) | (TokenPipeHeader::VERSION >> 8));
+            return swapped != TokenPipeHeader::VERSION && version == swapped;
+        }
+    } // namespace
+
+    // ---------------------------------------------------------------------
+    // TokenPipeWriter
+    // ---------------------------------------------------------------------
+
+    // Constructor: Buffers the header
+    TokenPipeWriter::TokenPipeWriter(std::ostream &output, std::size_t bufferSize)
+        : output(output), buffer(new char[std::max(bufferSize, sizeof(TokenPipeHeader))]),
+          capacity(std::max(bufferSize, sizeof(TokenPipeHeader)))
+    {
+        TokenPipeHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = TokenPipeHeader::VERSION;
+        header.recordSize = sizeof(TokenPipeRecord);
+        std::memcpy(buffer.get(), &header, sizeof(header));
+        used = sizeof(header);
+    }
+
+    // Destructor: Writes out whatever is still buffered
+    TokenPipeWriter::~TokenPipeWriter()
+    {
+        try
+        {
+            drain();
+        }
+        catch (...)
+        {
+            // a destructor must not throw, stream errors are reported by flush()
+        }
+    }
+
+    // Appends the record and the value of one token, handing the buffer over when it is full
+    void TokenPipeWriter::write(TokenType type, std::string_view value, int line, int column)
+    {
+        if (value.size() > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::runtime_error("Token value exceeds 4 GiB.");
+        }
+
+        TokenPipeRecord record{};
+        record.length = static_cast<std::uint32_t>(value.size());
+        record.line = static_cast<std::uint32_t>(line);
+        record.column = static_cast<std::uint32_t>(column);
+        record.type = type;
+
+        std::size_t size = sizeof(record) + value.size();
+        if (capacity - used < size)
+        {
+            drain();
+        }
+
+        // A token larger than the whole buffer is written on its own
+        if (size > capacity)
+        {
+            output.write(reinterpret_cast<const char *>(&record), sizeof(record));
+            output.write(value.data(), static_cast<std::streamsize>(value.size()));
+            return;
+        }
+
+        std::memcpy(buffer.get() + used, &record, sizeof(record));
+        std::memcpy(buffer.get() + used + sizeof(record), value.data(), value.size());
+        used += size;
+    }
+
+    // Writes one token
+    void TokenPipeWriter::write(const Token &token)
+    {
+        write(token.getType(), token.getValue(), token.getLine(), token.getColumn());
+    }
+
+    // Writes every token of a stream, resolving the positions in source order
+    void TokenPipeWriter::write(const TokenStream &tokens)
+    {
+        const std::vector<TokenType> &types = tokens.getTypes();
+        const std::vector<std::size_t> &offsets = tokens.getOffsets();
+        const std::vector<std::uint32_t> &lengths = tokens.getLengths();
+        const LineIndex &index = tokens.getLineIndex();
+        std::size_t hint = 0;
+        for (std::size_t i = 0; i < tokens.size(); ++i)
+        {
+            SourcePosition position = index.locate(offsets[i] + lengths[i], hint);
+            write(types[i], tokens.valueAt(i), position.line, position.column);
+        }
+    }
+
+    // Writes out the buffer and flushes the stream
+    void TokenPipeWriter::flush()
+    {
+        drain();
+        output.flush();
+        if (!output)
+        {
+            throw std::runtime_error("Failed to write the token pipe.");
+        }
+    }
+
+    // Writes the end record and flushes
+    void TokenPipeWriter::finish()
+    {
+        write(TokenType::END_OF_INPUT, "", 0, 0);
+        flush();
+    }
+
+    // Hands the buffered records to the stream
+    void TokenPipeWriter::drain()
+    {
+        if (used > 0)
+        {
+            output.write(buffer.get(), static_cast<std::streamsize>(used));
+            used = 0;
+        }
+    }
+
+    // ---------------------------------------------------------------------
+    // TokenPipeReader
+    // ---------------------------------------------------------------------
+
+    // Constructor: Reads and checks the header
+    TokenPipeReader::TokenPipeReader(std::istream &input) : input(input)
+    {
+        TokenPipeHeader header{};
+        if (!input.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            throw std::runtime_error("Not a token pipe.");
+        }
+        if (isByteSwapped(header.version))
+        {
+            throw std::runtime_error("Token pipe written on a host of the other byte order.");
+        }
+        if (header.version != TokenPipeHeader::VERSION || header.recordSize != sizeof(TokenPipeRecord))
+        {
+            throw std::runtime_error("Unsupported token pipe version " + std::to_string(header.version) + ".");
+        }
+    }
+
+    // Reads the next record and its value
+    std::optional<Token> TokenPipeReader::next()
+    {
+        if (finished)
+        {
+            return std::nullopt;
+        }
+
+        TokenPipeRecord record{};
+        if (!input.read(reinterpret_cast<char *>(&record), sizeof(record)))
+        {
+            throw std::runtime_error("Token pipe ended before its end record.");
+        }
+        if (record.type > TokenType::END_OF_INPUT)
+        {
+            throw std::runtime_error("Token pipe holds an invalid token type.");
+        }
+        if (record.type == TokenType::END_OF_INPUT)
+        {
+            finished = true;
+            return std::nullopt;
+        }
+
+        value.resize(record.length);
+        if (!input.read(value.data(), static_cast<std::streamsize>(value.size())))
+        {
+            throw std::runtime_error("Token pipe ended inside a token value.");
+        }
+        return Token(record.type, value, static_cast<int>(record.line), static_cast<int>(record.column));
+    }
+
+} // namespace TINY::SCANNER
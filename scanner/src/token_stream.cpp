@@ -0,0 +1,359 @@
+/**
+ * @file token_stream.cpp
+ * @brief Implements the TokenStream structure-of-arrays token container.
+ *
+ * Every field of a token lives in its own array, and a token's value is a slice of the
+ * borrowed source. Positions are resolved through a LineIndex built on first use and
+ * published with an atomic compare-and-swap, so concurrent readers may race to build it.
+ * The Row and const_iterator classes rebuild the per-token view that code written against
+ * the Token class expects. Identifiers are interned into the stream's SymbolTable as they
+ * are appended.
+ */
+
+#include "token_stream.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Replaces count elements of an array at first with the elements of another array,
+        // overwriting in place and moving the tail only once
+        template <typename T>
+        void spliceArray(std::vector<T> &array, std::size_t first, std::size_t count, const std::vector<T> &replacement)
+        {
+            std::size_t common = std::min(count, replacement.size());
+            std::copy(replacement.begin(), replacement.begin() + common, array.begin() + first);
+            if (count > replacement.size())
+            {
+                array.erase(array.begin() + first + common, array.begin() + first + count);
+            }
+            else
+            {
+                array.insert(array.begin() + first + common, replacement.begin() + common, replacement.end());
+            }
+        }
+    } // namespace
+
+    // ---------------------------------------------------------------------
+    // Row
+    // ---------------------------------------------------------------------
+
+    // Constructor: Views the token at the given index
+    TokenStream::Row::Row(const TokenStream &stream, std::size_t index) : stream(&stream), index(index)
+    {
+    }
+
+    // Returns the type of the token
+    TokenType TokenStream::Row::getType() const
+    {
+        return stream->types[index];
+    }
+
+    // Returns the value of the token as a view into the source
+    std::string_view TokenStream::Row::getValue() const
+    {
+        return stream->valueAt(index);
+    }
+
+    // Returns the line number where the token was found
+    int TokenStream::Row::getLine() const
+    {
+        return getPosition().line;
+    }
+
+    // Returns the column number where the token was found
+    int TokenStream::Row::getColumn() const
+    {
+        return getPosition().column;
+    }
+
+    // Looks up the position of the end of the token
+    SourcePosition TokenStream::Row::getPosition() const
+    {
+        return stream->getLineIndex().locate(stream->offsets[index] + stream->lengths[index]);
+    }
+
+    // Returns the offset of the token in the source
+    std::size_t TokenStream::Row::getOffset() const
+    {
+        return stream->offsets[index];
+    }
+
+    // Returns the symbol ID of the token
+    std::uint32_t TokenStream::Row::getSymbol() const
+    {
+        return stream->symbols[index];
+    }
+
+    // Copies the token out of the stream
+    Token TokenStream::Row::toToken() const
+    {
+        SourcePosition position = getPosition();
+        return Token(getType(), getValue(), position.line, position.column);
+    }
+
+    // Converts the token to its string representation
+    std::string TokenStream::Row::toString(bool includePosition) const
+    {
+        return toToken().toString(includePosition);
+    }
+
+    // ---------------------------------------------------------------------
+    // const_iterator
+    // ---------------------------------------------------------------------
+
+    // Constructor: Points at the given index of the stream
+    TokenStream::const_iterator::const_iterator(const TokenStream &stream, std::size_t index)
+        : stream(&stream), index(index)
+    {
+    }
+
+    // Returns a view of the current token
+    TokenStream::Row TokenStream::const_iterator::operator*() const
+    {
+        return Row(*stream, index);
+    }
+
+    // Moves to the next token
+    TokenStream::const_iterator &TokenStream::const_iterator::operator++()
+    {
+        ++index;
+        return *this;
+    }
+
+    // Moves to the next token, returning the previous position
+    TokenStream::const_iterator TokenStream::const_iterator::operator++(int)
+    {
+        const_iterator previous = *this;
+        ++index;
+        return previous;
+    }
+
+    // Compares two iterators
+    bool TokenStream::const_iterator::operator==(const const_iterator &other) const
+    {
+        return stream == other.stream && index == other.index;
+    }
+
+    // Compares two iterators
+    bool TokenStream::const_iterator::operator!=(const const_iterator &other) const
+    {
+        return !(*this == other);
+    }
+
+    // ---------------------------------------------------------------------
+    // TokenStream
+    // ---------------------------------------------------------------------
+
+    // Constructor: Starts an empty stream over the given source
+    TokenStream::TokenStream(std::string_view source) : source(source)
+    {
+    }
+
+    // Removes all tokens and switches to a new source
+    void TokenStream::reset(std::string_view newSource, SourcePosition newOrigin)
+    {
+        source = newSource;
+        origin = newOrigin;
+        types.clear();
+        offsets.clear();
+        lengths.clear();
+        symbols.clear();
+        symbolTable.clear();
+        lineIndex.reset();
+    }
+
+    // Reserves room in every array
+    void TokenStream::reserve(std::size_t count)
+    {
+        types.reserve(count);
+        offsets.reserve(count);
+        lengths.reserve(count);
+        symbols.reserve(count);
+    }
+
+    // Appends a token to every array
+    void TokenStream::push_back(TokenType type, std::size_t offset, std::size_t length)
+    {
+        types.push_back(type);
+        offsets.push_back(offset);
+        lengths.push_back(static_cast<std::uint32_t>(length));
+        symbols.push_back(type == TokenType::IDENTIFIER ? symbolTable.intern(source.substr(offset, length))
+                                                        : SymbolTable::NO_SYMBOL);
+    }
+
+    // Appends all tokens of another stream
+    void TokenStream::append(const TokenStream &other)
+    {
+        types.insert(types.end(), other.types.begin(), other.types.end());
+        offsets.insert(offsets.end(), other.offsets.begin(), other.offsets.end());
+        lengths.insert(lengths.end(), other.lengths.begin(), other.lengths.end());
+
+        // Translate the other stream's symbol IDs, interning each of its spellings once
+        std::vector<std::uint32_t> translated(other.symbolTable.size());
+        for (std::uint32_t symbol = 0; symbol < translated.size(); ++symbol)
+        {
+            translated[symbol] = symbolTable.intern(other.symbolTable.spelling(symbol));
+        }
+        symbols.reserve(symbols.size() + other.symbols.size());
+        for (std::uint32_t symbol : other.symbols)
+        {
+            symbols.push_back(symbol == SymbolTable::NO_SYMBOL ? symbol : translated[symbol]);
+        }
+    }
+
+    // Replaces a range of tokens, translating the replacement's symbol IDs
+    void TokenStream::replace(std::size_t first, std::size_t count, const TokenStream &replacement)
+    {
+        spliceArray(types, first, count, replacement.types);
+        spliceArray(offsets, first, count, replacement.offsets);
+        spliceArray(lengths, first, count, replacement.lengths);
+
+        std::vector<std::uint32_t> translated(replacement.symbolTable.size());
+        for (std::uint32_t symbol = 0; symbol < translated.size(); ++symbol)
+        {
+            translated[symbol] = symbolTable.intern(replacement.symbolTable.spelling(symbol));
+        }
+        std::vector<std::uint32_t> replacementSymbols;
+        replacementSymbols.reserve(replacement.symbols.size());
+        for (std::uint32_t symbol : replacement.symbols)
+        {
+            replacementSymbols.push_back(symbol == SymbolTable::NO_SYMBOL ? symbol : translated[symbol]);
+        }
+        spliceArray(symbols, first, count, replacementSymbols);
+    }
+
+    // Moves the tail of the stream by an edit before it
+    void TokenStream::shift(std::size_t first, std::ptrdiff_t offsetDelta)
+    {
+        if (offsetDelta == 0)
+        {
+            return;
+        }
+        for (std::size_t i = first; i < size(); ++i)
+        {
+            offsets[i] = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(offsets[i]) + offsetDelta);
+        }
+    }
+
+    // Points the stream at a new source, whose lines are indexed again when next asked for
+    void TokenStream::rebind(std::string_view newSource)
+    {
+        source = newSource;
+        lineIndex.reset();
+    }
+
+    // Returns the origin of the positions
+    SourcePosition TokenStream::getOrigin() const
+    {
+        return origin;
+    }
+
+    // Returns the line index, building it on the first call; of racing builders, the first to publish wins
+    const LineIndex &TokenStream::getLineIndex() const
+    {
+        std::shared_ptr<const LineIndex> index = std::atomic_load(&lineIndex);
+        if (!index)
+        {
+            std::shared_ptr<const LineIndex> built = std::make_shared<const LineIndex>(source, origin);
+            if (std::atomic_compare_exchange_strong(&lineIndex, &index, built))
+            {
+                index = std::move(built);
+            }
+        }
+        return *index;
+    }
+
+    // Returns the number of tokens
+    std::size_t TokenStream::size() const
+    {
+        return types.size();
+    }
+
+    // Checks whether there are no tokens
+    bool TokenStream::empty() const
+    {
+        return types.empty();
+    }
+
+    // Returns a view of the token at the given index
+    TokenStream::Row TokenStream::operator[](std::size_t index) const
+    {
+        return Row(*this, index);
+    }
+
+    // Returns an iterator to the first token
+    TokenStream::const_iterator TokenStream::begin() const
+    {
+        return const_iterator(*this, 0);
+    }
+
+    // Returns an iterator past the last token
+    TokenStream::const_iterator TokenStream::end() const
+    {
+        return const_iterator(*this, size());
+    }
+
+    // Returns the scanned source
+    std::string_view TokenStream::getSource() const
+    {
+        return source;
+    }
+
+    // Returns the value of a token as a slice of the source
+    std::string_view TokenStream::valueAt(std::size_t index) const
+    {
+        return source.substr(offsets[index], lengths[index]);
+    }
+
+    // Returns the type array
+    const std::vector<TokenType> &TokenStream::getTypes() const
+    {
+        return types;
+    }
+
+    // Returns the offset array
+    const std::vector<std::size_t> &TokenStream::getOffsets() const
+    {
+        return offsets;
+    }
+
+    // Returns the length array
+    const std::vector<std::uint32_t> &TokenStream::getLengths() const
+    {
+        return lengths;
+    }
+
+    // Returns the symbol array
+    const std::vector<std::uint32_t> &TokenStream::getSymbols() const
+    {
+        return symbols;
+    }
+
+    // Returns the symbol table
+    const SymbolTable &TokenStream::getSymbolTable() const
+    {
+        return symbolTable;
+    }
+
+    // Copies every token out of the stream
+    std::vector<Token> TokenStream::toTokens() const
+    {
+        std::vector<Token> tokens;
+        tokens.reserve(size());
+        const LineIndex &index = getLineIndex();
+        std::size_t hint = 0;
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            SourcePosition position = index.locate(offsets[i] + lengths[i], hint);
+            tokens.emplace_back(types[i], valueAt(i), position.line, position.column);
+        }
+        return tokens;
+    }
+
+} // namespace TINY::SCANNER
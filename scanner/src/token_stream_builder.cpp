@@ -3,14 +3,57 @@
  * @brief Implements the TokenStreamBuilder class for orchestrating the tokenization process.
  *
  * The TokenStreamBuilder class handles tokenization by utilizing the Scanner
- * to generate tokens and stores them in a vector for further processing.
+ * to recognize tokens and stores them in a TokenStream for further processing.
+ * Large inputs can also be tokenized in parallel segments, see buildParallel().
  */
 
 #include "token_stream_builder.hpp"
+#include "simd_scan.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
 
 namespace TINY::SCANNER
 {
 
+    namespace
+    {
+        // What a segment does to the comment nesting depth.
+        // Outside a comment '{' opens one and '}' is an unknown token; inside, '{' nests and
+        // '}' closes one level. So a segment maps an entry depth d to max(d - closes, 0) + opens.
+        struct SegmentSummary
+        {
+            int closes = 0; // '}' bytes not matched by a '{' earlier in the segment
+            int opens = 0;  // '{' bytes not matched by a '}' later in the segment
+        };
+
+        // Summarizes the bytes of one segment
+        SegmentSummary summarize(const char *begin, const char *end)
+        {
+            SegmentSummary summary;
+
+            for (const char *cursor = SIMD::findCommentDelimiter(begin, end); cursor < end;
+                 cursor = SIMD::findCommentDelimiter(cursor + 1, end))
+            {
+                if (*cursor == '{')
+                {
+                    summary.opens++;
+                }
+                else if (summary.opens > 0)
+                {
+                    summary.opens--; // '}' closes a '{' of this segment
+                }
+                else
+                {
+                    summary.closes++; // '}' closes a comment opened before the segment, if any
+                }
+            }
+            return summary;
+        }
+    } // namespace
+
     // Constructor initializes the TokenStreamBuilder with a reference to the Scanner object.
     TokenStreamBuilder::TokenStreamBuilder(Scanner &scanner) : scanner(scanner)
     {
@@ -19,15 +62,259 @@ namespace TINY::SCANNER
     // Processes the input source code using the Scanner and generates tokens.
     void TokenStreamBuilder::build()
     {
-        tokens.clear(); // Clear any existing tokens in the vector
-        while (scanner.hasMoreTokens())
+        tokens.reset(scanner.input, startPosition()); // Clear any existing tokens
+        scanInto(scanner, tokens);
+    }
+
+    // The scanner's offset and its position, which the stream resolves token positions from
+    SourcePosition TokenStreamBuilder::startPosition()
+    {
+        scanner.syncPosition();
+        return {scanner.pos, scanner.line, scanner.column};
+    }
+
+    // Appends the remaining tokens of a scanner to a stream, without building Token objects.
+    // Whitespace and comments are skipped exactly once, there is no hasMoreTokens() look-ahead,
+    // and no line or column is counted: the stream resolves them from the offsets on demand.
+    void TokenStreamBuilder::scanInto(Scanner &source, TokenStream &stream)
+    {
+        while (true)
+        {
+            // An unclosed comment ends the stream without a token, as does the end of input
+            bool unclosedComment = source.skipWhitespaceAndComments();
+            if (unclosedComment || source.pos >= source.input.size())
+            {
+                break;
+            }
+
+            size_t start = source.pos;
+            TokenType type = source.scanLexeme();
+            stream.push_back(type, start, source.pos - start);
+        }
+    }
+
+    // Processes the input source code on several threads, see the header for the algorithm.
+    void TokenStreamBuilder::buildParallel(size_t segmentCount, size_t minSegmentSize)
+    {
+        const std::string_view input = scanner.input;
+        const size_t start = scanner.pos;
+        const size_t remaining = input.size() - std::min(start, input.size());
+
+        if (segmentCount == 0)
+        {
+            segmentCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        segmentCount = std::min(segmentCount, remaining / std::max<size_t>(1, minSegmentSize));
+
+        // A '\0' byte inside a comment stops scanning, which the brace summaries do not model
+        bool hasNul = std::memchr(input.data() + start, '\0', remaining) != nullptr;
+        if (segmentCount < 2 || hasNul)
+        {
+            build();
+            return;
+        }
+
+        // Split just after the first newline following each nominal boundary
+        std::vector<size_t> bounds = {start};
+        for (size_t i = 1; i < segmentCount; ++i)
+        {
+            size_t nominal = std::max(start + remaining / segmentCount * i, bounds.back());
+            const void *newline = std::memchr(input.data() + nominal, '\n', input.size() - nominal);
+            if (newline == nullptr)
+            {
+                break;
+            }
+            size_t bound = static_cast<size_t>(static_cast<const char *>(newline) - input.data()) + 1;
+            if (bound > bounds.back() && bound < input.size())
+            {
+                bounds.push_back(bound);
+            }
+        }
+        bounds.push_back(input.size());
+        size_t segments = bounds.size() - 1;
+
+        // Pass 1: summarize every segment in parallel
+        std::vector<SegmentSummary> summaries(segments);
+        {
+            std::vector<std::thread> workers;
+            for (size_t i = 0; i < segments; ++i)
+            {
+                workers.emplace_back([&, i]
+                                     { summaries[i] = summarize(input.data() + bounds[i], input.data() + bounds[i + 1]); });
+            }
+            for (std::thread &worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        // Resolve the comment depth at the start of every segment, in order. The segment scanners
+        // only store offsets, so their line and column numbers are never read.
+        std::vector<Scanner> segmentScanners;
+        segmentScanners.reserve(segments);
+        segmentScanners.emplace_back(input.substr(0, bounds[1]), start, 1, 1, scanner.commentDepth);
+        int depth = scanner.commentDepth;
+        for (size_t i = 1; i < segments; ++i)
+        {
+            depth = std::max(depth - summaries[i - 1].closes, 0) + summaries[i - 1].opens;
+            segmentScanners.emplace_back(input.substr(0, bounds[i + 1]), bounds[i], 1, 1, depth);
+        }
+
+        // Pass 2: scan every segment in parallel
+        std::vector<TokenStream> segmentTokens(segments, TokenStream(input));
+        {
+            std::vector<std::thread> workers;
+            for (size_t i = 0; i < segments; ++i)
+            {
+                workers.emplace_back([&, i]
+                                     { scanInto(segmentScanners[i], segmentTokens[i]); });
+            }
+            for (std::thread &worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        // Merge the segments in order
+        size_t total = 0;
+        for (const TokenStream &part : segmentTokens)
+        {
+            total += part.size();
+        }
+        tokens.reset(input, startPosition());
+        tokens.reserve(total);
+        for (const TokenStream &part : segmentTokens)
+        {
+            tokens.append(part);
+        }
+
+        // Leave the scanner where a sequential build would have left it; its cached position
+        // is still before that point and stays valid
+        Scanner &last = segmentScanners.back();
+        scanner.pos = last.pos;
+        scanner.commentDepth = last.commentDepth;
+    }
+
+    // Rescans the tokens around an edit, see the header for the restart and resync rules.
+    TokenStreamUpdate TokenStreamBuilder::update(std::string_view newSource, size_t offset, size_t removedLength,
+                                                 size_t insertedLength)
+    {
+        const size_t oldSize = tokens.getSource().size();
+        if (offset > oldSize || removedLength > oldSize - offset ||
+            newSource.size() != oldSize - removedLength + insertedLength)
+        {
+            throw std::out_of_range("Edit does not fit in the source.");
+        }
+
+        const std::vector<size_t> &offsets = tokens.getOffsets();
+        const std::vector<uint32_t> &lengths = tokens.getLengths();
+        const size_t count = tokens.size();
+        const std::ptrdiff_t delta = static_cast<std::ptrdiff_t>(insertedLength) - static_cast<std::ptrdiff_t>(removedLength);
+
+        // Keep the tokens that end, look-ahead included, before the edit (binary search, ends are increasing)
+        TokenStreamUpdate result;
+        size_t high = count;
+        while (result.firstToken < high)
+        {
+            size_t middle = result.firstToken + (high - result.firstToken) / 2;
+            if (offsets[middle] + lengths[middle] < offset)
+            {
+                result.firstToken = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        const size_t first = result.firstToken;
+        const size_t restart = first > 0 ? offsets[first - 1] + lengths[first - 1] : 0;
+        Scanner rescanner(newSource, restart, 1, 1, 0); // only offsets are stored, its position is never read
+
+        // The old tokens that start after the edit are the candidates to resync with
+        size_t next = static_cast<size_t>(std::lower_bound(offsets.begin(), offsets.end(), offset + removedLength) - offsets.begin());
+        bool resynced = false;
+
+        TokenStream inserted(newSource);
+        while (true)
+        {
+            bool unclosedComment = rescanner.skipWhitespaceAndComments();
+            if (unclosedComment || rescanner.pos >= newSource.size())
+            {
+                break;
+            }
+
+            size_t start = rescanner.pos;
+            TokenType type = rescanner.scanLexeme();
+            size_t length = rescanner.pos - start;
+
+            // A token after the edit that an old token also started at means the rest is unchanged
+            if (start >= offset + insertedLength)
+            {
+                size_t oldStart = static_cast<size_t>(static_cast<std::ptrdiff_t>(start) - delta);
+                while (next < count && offsets[next] < oldStart)
+                {
+                    ++next;
+                }
+                if (next < count && offsets[next] == oldStart && lengths[next] == length)
+                {
+                    resynced = true;
+                    break;
+                }
+            }
+            inserted.push_back(type, start, length);
+        }
+        result.rescannedBytes = rescanner.pos - restart;
+
+        // Move the scanner to the new source, where a build of it would have left it
+        if (resynced)
+        {
+            scanner.pos = static_cast<size_t>(static_cast<std::ptrdiff_t>(scanner.pos) + delta);
+        }
+        else
+        {
+            next = count;
+            scanner.pos = rescanner.pos;
+            scanner.commentDepth = rescanner.commentDepth;
+        }
+        scanner.input = newSource;
+        ++scanner.generation;
+
+        // The scanner's cached position is only kept if the edit came after it
+        if (scanner.positionOffset > offset || scanner.positionOffset > scanner.pos)
+        {
+            SourcePosition origin = tokens.getOrigin();
+            scanner.positionOffset = origin.offset;
+            scanner.line = origin.line;
+            scanner.column = origin.column;
+        }
+
+        // Shift the unchanged tail first, while its indices are still the old ones
+        tokens.rebind(newSource);
+        if (resynced)
+        {
+            tokens.shift(next, delta);
+        }
+        result.removedTokens = next - first;
+        result.insertedTokens = inserted.size();
+        tokens.replace(first, result.removedTokens, inserted);
+        return result;
+    }
+
+    // Edits the source in place, then updates the tokens
+    TokenStreamUpdate TokenStreamBuilder::applyEdit(std::string &source, size_t offset, size_t removedLength,
+                                                    std::string_view insertedText)
+    {
+        if (offset > source.size() || removedLength > source.size() - offset)
         {
-            tokens.push_back(scanner.getNextToken()); // Append the next token to the vector
+            throw std::out_of_range("Edit does not fit in the source.");
         }
+        source.replace(offset, removedLength, insertedText);
+        return update(source, offset, removedLength, insertedText.size());
     }
 
-    // Returns a constant reference to the vector of tokens generated by the Scanner.
-    const std::vector<Token> &TokenStreamBuilder::getTokens() const
+    // Returns a constant reference to the tokens generated by the Scanner.
+    const TokenStream &TokenStreamBuilder::getTokens() const
     {
         return tokens; // Provide read-only access to the tokens
     }
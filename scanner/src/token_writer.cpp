@@ -0,0 +1,157 @@
+/**
+ * @file token_writer.cpp
+ * @brief Implements the TokenWriter class for writing token lines in large blocks.
+ *
+ * Lines are formatted in place at the end of the buffer. When the next line might not fit,
+ * the buffer is drained to the stream first; a line longer than the whole buffer is
+ * formatted into a temporary buffer of its own.
+ */
+
+#include "token_writer.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Copies text to the destination, returns the end of the copy
+        char *append(char *out, std::string_view text)
+        {
+            std::memcpy(out, text.data(), text.size());
+            return out + text.size();
+        }
+
+        // Writes a number in decimal to the destination, returns the end of the number
+        char *appendNumber(char *out, int number)
+        {
+            // an int has at most 11 characters, the caller reserved room for them
+            return std::to_chars(out, out + 11, number).ptr;
+        }
+    } // namespace
+
+    // Constructor: Allocates the output buffer
+    TokenWriter::TokenWriter(std::ostream &output, std::size_t bufferSize)
+        : output(output), buffer(new char[bufferSize]), capacity(bufferSize)
+    {
+    }
+
+    // Destructor: Writes out whatever is still buffered
+    TokenWriter::~TokenWriter()
+    {
+        try
+        {
+            drain();
+        }
+        catch (...)
+        {
+            // a destructor must not throw, stream errors are reported by flush()
+        }
+    }
+
+    // Formats one token line at the end of the buffer
+    void TokenWriter::write(TokenType type, std::string_view value, int line, int column, bool includePosition)
+    {
+        std::size_t maxLength = maxFormattedLength(value.size()) + 1;
+        if (capacity - used < maxLength)
+        {
+            drain();
+        }
+
+        // A line longer than the whole buffer is written on its own
+        if (maxLength > capacity)
+        {
+            std::string longLine(maxLength, '\0');
+            std::size_t length = format(longLine.data(), type, value, line, column, includePosition);
+            longLine[length] = '\n';
+            output.write(longLine.data(), static_cast<std::streamsize>(length + 1));
+            return;
+        }
+
+        char *out = buffer.get() + used;
+        std::size_t length = format(out, type, value, line, column, includePosition);
+        out[length] = '\n';
+        used += length + 1;
+    }
+
+    // Formats one token line from a Token
+    void TokenWriter::write(const Token &token, bool includePosition)
+    {
+        write(token.getType(), token.getValue(), token.getLine(), token.getColumn(), includePosition);
+    }
+
+    // Formats the lines of a whole stream, reading its arrays directly
+    void TokenWriter::write(const TokenStream &tokens, bool includePosition)
+    {
+        const std::vector<TokenType> &types = tokens.getTypes();
+        if (!includePosition)
+        {
+            for (std::size_t i = 0; i < tokens.size(); ++i)
+            {
+                write(types[i], tokens.valueAt(i), 0, 0, false);
+            }
+            return;
+        }
+
+        // The tokens are in source order, so each lookup continues from the previous line
+        const std::vector<std::size_t> &offsets = tokens.getOffsets();
+        const std::vector<std::uint32_t> &lengths = tokens.getLengths();
+        const LineIndex &index = tokens.getLineIndex();
+        std::size_t hint = 0;
+        for (std::size_t i = 0; i < tokens.size(); ++i)
+        {
+            SourcePosition position = index.locate(offsets[i] + lengths[i], hint);
+            write(types[i], tokens.valueAt(i), position.line, position.column, true);
+        }
+    }
+
+    // Writes out the buffer and flushes the stream
+    void TokenWriter::flush()
+    {
+        drain();
+        output.flush();
+        if (!output)
+        {
+            throw std::runtime_error("Failed to write tokens to the output stream.");
+        }
+    }
+
+    // Hands the buffered lines to the stream in one block
+    void TokenWriter::drain()
+    {
+        if (used > 0)
+        {
+            output.write(buffer.get(), static_cast<std::streamsize>(used));
+            used = 0;
+        }
+    }
+
+    // Formats "value, TYPE" and optionally " [Line: l, Column: c]"
+    std::size_t TokenWriter::format(char *out, TokenType type, std::string_view value, int line, int column,
+                                    bool includePosition)
+    {
+        std::size_t index = static_cast<std::size_t>(type);
+        if (index >= Token::tokenTypeStrings.size())
+        {
+            throw std::out_of_range("Invalid TokenType index");
+        }
+
+        char *end = append(out, value);
+        end = append(end, ", ");
+        end = append(end, Token::tokenTypeStrings[index]);
+        if (includePosition)
+        {
+            end = append(end, " [Line: ");
+            end = appendNumber(end, line);
+            end = append(end, ", Column: ");
+            end = appendNumber(end, column);
+            end = append(end, "]");
+        }
+        return static_cast<std::size_t>(end - out);
+    }
+
+} // namespace TINY::SCANNER
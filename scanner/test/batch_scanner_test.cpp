@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "batch_scanner.hpp"
+#include "file_handler.hpp"
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Creates a scratch directory tree of inputs and returns its path
+        std::filesystem::path makeInputTree()
+        {
+            std::filesystem::path root = std::filesystem::temp_directory_path() / "batch_scanner_test";
+            std::filesystem::remove_all(root);
+            FileHandler::writeFile((root / "a.tny").string(), "read x;");
+            FileHandler::writeFile((root / "notes.txt").string(), "x := 1");
+            FileHandler::writeFile((root / "sub" / "b.tny").string(), "write x @");
+            FileHandler::writeFile((root / "sub" / "deep" / "c.tny").string(), "");
+            return root;
+        }
+    } // namespace
+
+    // Test the glob matching rules
+    TEST(BatchScannerTest, MatchPattern)
+    {
+        EXPECT_TRUE(BatchScanner::matchPattern("*.tny", "a.tny"));
+        EXPECT_FALSE(BatchScanner::matchPattern("*.tny", "sub/a.tny"));
+        EXPECT_TRUE(BatchScanner::matchPattern("?.tny", "a.tny"));
+        EXPECT_FALSE(BatchScanner::matchPattern("?.tny", "ab.tny"));
+        EXPECT_TRUE(BatchScanner::matchPattern("**/*.tny", "a.tny"));
+        EXPECT_TRUE(BatchScanner::matchPattern("**/*.tny", "sub/deep/a.tny"));
+        EXPECT_FALSE(BatchScanner::matchPattern("**/*.tny", "sub/a.txt"));
+        EXPECT_TRUE(BatchScanner::matchPattern("sub/**", "sub/deep/a.txt"));
+        EXPECT_FALSE(BatchScanner::matchPattern("sub/*", "sub/deep/a.txt"));
+    }
+
+    // Test collecting inputs from a directory and from glob patterns
+    TEST(BatchScannerTest, CollectsInputs)
+    {
+        std::filesystem::path root = makeInputTree();
+
+        EXPECT_EQ(BatchScanner(root.string()).getInputs().size(), 4u);
+
+        BatchScanner recursive((root / "**" / "*.tny").string());
+        ASSERT_EQ(recursive.getInputs().size(), 3u);
+        EXPECT_EQ(recursive.getBaseDirectory(), root);
+        EXPECT_EQ(recursive.getInputs()[0].generic_string(), "a.tny");
+        EXPECT_EQ(recursive.getInputs()[2].generic_string(), "sub/deep/c.tny");
+
+        EXPECT_EQ(BatchScanner((root / "*.tny").string()).getInputs().size(), 1u);
+        EXPECT_THROW(BatchScanner((root / "*.none").string()), std::invalid_argument);
+
+        std::filesystem::remove_all(root);
+    }
+
+    // Test that every file is written and a failing file is reported without stopping the others
+    TEST(BatchScannerTest, RunWritesOutputsAndReport)
+    {
+        std::filesystem::path root = makeInputTree();
+        std::filesystem::path output = root / "out";
+
+        BatchScanner batch((root / "**" / "*.tny").string());
+        BatchReport report = batch.run(output.string(), 2, true);
+
+        ASSERT_EQ(report.files.size(), 3u);
+        EXPECT_EQ(report.threads, 2u);
+        EXPECT_EQ(report.failedFiles(), 1u);
+        EXPECT_EQ(report.totalTokens(), 6u);
+        EXPECT_EQ(report.totalUnknownTokens(), 1u);
+        EXPECT_EQ(report.files[2].error, "Input file is empty");
+
+        EXPECT_EQ(FileHandler::readFile((output / "a.tny.tokens").string()),
+                  "read, READ [Line: 1, Column: 5]\nx, IDENTIFIER [Line: 1, Column: 7]\n;, SEMICOLON [Line: 1, Column: 8]\n");
+        EXPECT_TRUE(std::filesystem::exists(output / "sub" / "b.tny.tokens"));
+
+        std::ostringstream printed;
+        report.print(printed);
+        EXPECT_NE(printed.str().find("Files:          3 (1 failed)"), std::string::npos);
+        EXPECT_NE(printed.str().find("c.tny: Input file is empty"), std::string::npos);
+
+        std::filesystem::remove_all(root);
+    }
+
+} // namespace TINY::SCANNER
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include "diagnostics.hpp"
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Removes the color codes from the text written by Diagnostics
+        std::string stripColors(const std::string &text)
+        {
+            std::string plain;
+            for (size_t i = 0; i < text.size(); ++i)
+            {
+                if (text[i] == '\033')
+                {
+                    i = text.find('m', i);
+                    continue;
+                }
+                plain.push_back(text[i]);
+            }
+            return plain;
+        }
+    } // namespace
+
+    // Test that errors are written in one batch, with the header only before the first one
+    TEST(DiagnosticsTest, BatchesAndSummary)
+    {
+        Diagnostics diagnostics;
+        std::ostringstream out;
+
+        diagnostics.flush(out);
+        diagnostics.printSummary(out);
+        EXPECT_EQ(out.str(), "");
+
+        std::string value = "@";
+        EXPECT_FALSE(diagnostics.report(value, 1, 2));
+        value = "#"; // values are copied, the caller's buffer may change
+        EXPECT_FALSE(diagnostics.report(value, 3, 4));
+        EXPECT_EQ(out.str(), "");
+        diagnostics.flush(out);
+        EXPECT_FALSE(diagnostics.report("Unclosed comment", 5, 6));
+        diagnostics.flush(out);
+        diagnostics.printSummary(out);
+
+        EXPECT_EQ(stripColors(out.str()),
+                  "The input contains unexpected tokens, please check the input file.\n"
+                  "List of unexpected tokens:\n"
+                  "-\tError: unexpected token '@' at line 1, column 2\n"
+                  "-\tError: unexpected token '#' at line 3, column 4\n"
+                  "-\tError: unexpected token 'Unclosed comment' at line 5, column 6\n"
+                  "Unexpected tokens: 3\n");
+        EXPECT_EQ(diagnostics.count(), 3u);
+        EXPECT_FALSE(diagnostics.limitReached());
+    }
+
+    // Test that the collection stops at the limit and the summary says so
+    TEST(DiagnosticsTest, Limit)
+    {
+        Diagnostics diagnostics(2);
+        EXPECT_FALSE(diagnostics.report("@", 1, 1));
+        EXPECT_TRUE(diagnostics.report("#", 1, 2));
+        EXPECT_TRUE(diagnostics.report("$", 1, 3));
+        EXPECT_TRUE(diagnostics.limitReached());
+        EXPECT_EQ(diagnostics.count(), 2u);
+
+        std::ostringstream out;
+        diagnostics.flush(out);
+        diagnostics.printSummary(out);
+        std::string text = stripColors(out.str());
+        EXPECT_EQ(text.find("'$'"), std::string::npos);
+        EXPECT_NE(text.find("Unexpected tokens: 2 (stopped at the limit set by --max-errors)\n"), std::string::npos);
+    }
+
+    // Test that a full batch is signalled and flushing empties it
+    TEST(DiagnosticsTest, BatchFull)
+    {
+        Diagnostics diagnostics;
+        for (size_t i = 0; i + 1 < Diagnostics::BATCH_SIZE; ++i)
+        {
+            diagnostics.report("@", 1, static_cast<int>(i));
+        }
+        EXPECT_FALSE(diagnostics.isBatchFull());
+        diagnostics.report("@", 2, 1);
+        EXPECT_TRUE(diagnostics.isBatchFull());
+
+        std::ostringstream out;
+        diagnostics.flush(out);
+        EXPECT_FALSE(diagnostics.isBatchFull());
+        EXPECT_EQ(diagnostics.count(), Diagnostics::BATCH_SIZE);
+    }
+
+} // namespace TINY::SCANNER
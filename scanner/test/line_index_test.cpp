@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "line_index.hpp"
+#include "scanner.hpp"
+
+namespace TINY::SCANNER
+{
+
+    // Test that offsets resolve to the positions the Scanner counts, with and without a hint
+    TEST(LineIndexTest, LocateMatchesScanner)
+    {
+        std::string input = "read x;\n\n  y := 42 { a\n comment }\r\nwrite y\n";
+        LineIndex index(input);
+        EXPECT_EQ(index.newlineCount(), 5u);
+
+        Scanner scanner(input);
+        std::size_t hint = 0;
+        std::size_t end = 0;
+        while (true)
+        {
+            Token token = scanner.getNextToken();
+            if (token.getType() == TokenType::END_OF_INPUT)
+            {
+                break;
+            }
+            end = input.find(token.getValue(), end) + token.getValue().size();
+            SourcePosition position = index.locate(end);
+            EXPECT_EQ(position.line, token.getLine()) << token.getValue();
+            EXPECT_EQ(position.column, token.getColumn()) << token.getValue();
+
+            SourcePosition hinted = index.locate(end, hint);
+            EXPECT_EQ(hinted.line, position.line);
+            EXPECT_EQ(hinted.column, position.column);
+        }
+
+        // going backwards with a hint starts the walk over
+        EXPECT_EQ(index.locate(3, hint).line, 1);
+        EXPECT_EQ(index.locate(input.size()).line, 6);
+        EXPECT_EQ(index.locate(input.size()).column, 1);
+    }
+
+    // Test that an origin other than the start of the source shifts the first line only
+    TEST(LineIndexTest, OriginOffsetsTheFirstLine)
+    {
+        std::string input = "ignored\nx := 1\ny";
+        LineIndex index(input, SourcePosition{10, 4, 3});
+
+        EXPECT_EQ(index.newlineCount(), 1u);
+        EXPECT_EQ(index.locate(12).line, 4);
+        EXPECT_EQ(index.locate(12).column, 5);
+        EXPECT_EQ(index.locate(16).line, 5);
+        EXPECT_EQ(index.locate(16).column, 2);
+    }
+
+} // namespace TINY::SCANNER
@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "program_generator.hpp"
+#include "scanner.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Recursive-descent recognizer of the TINY grammar over token types, recording the deepest nesting
+        class GrammarChecker
+        {
+        public:
+            explicit GrammarChecker(const std::vector<TokenType> &types) : types(types) {}
+
+            // Checks that the tokens form exactly one program
+            void checkProgram()
+            {
+                sequence(0);
+                if (position != types.size())
+                {
+                    fail("statement separator");
+                }
+            }
+
+            size_t maxDepth = 0;
+
+        private:
+            const std::vector<TokenType> &types;
+            size_t position = 0;
+
+            TokenType peek() const
+            {
+                return position < types.size() ? types[position] : TokenType::END_OF_INPUT;
+            }
+
+            void expect(TokenType type, const char *what)
+            {
+                if (peek() != type)
+                {
+                    fail(what);
+                }
+                ++position;
+            }
+
+            [[noreturn]] void fail(const char *what) const
+            {
+                throw std::runtime_error(std::string("expected ") + what + " at token " + std::to_string(position));
+            }
+
+            void sequence(size_t depth)
+            {
+                maxDepth = std::max(maxDepth, depth);
+                statement(depth);
+                while (peek() == TokenType::SEMICOLON)
+                {
+                    ++position;
+                    statement(depth);
+                }
+            }
+
+            void statement(size_t depth)
+            {
+                switch (peek())
+                {
+                case TokenType::IF:
+                    ++position;
+                    expression();
+                    expect(TokenType::THEN, "then");
+                    sequence(depth + 1);
+                    expect(TokenType::END, "end");
+                    break;
+                case TokenType::REPEAT:
+                    ++position;
+                    sequence(depth + 1);
+                    expect(TokenType::UNTIL, "until");
+                    expression();
+                    break;
+                case TokenType::READ:
+                    ++position;
+                    expect(TokenType::IDENTIFIER, "identifier");
+                    break;
+                case TokenType::WRITE:
+                    ++position;
+                    expression();
+                    break;
+                case TokenType::IDENTIFIER:
+                    ++position;
+                    expect(TokenType::ASSIGN, ":=");
+                    expression();
+                    break;
+                default:
+                    fail("statement");
+                }
+            }
+
+            void expression()
+            {
+                simpleExpression();
+                if (peek() == TokenType::LESSTHAN || peek() == TokenType::EQUAL)
+                {
+                    ++position;
+                    simpleExpression();
+                }
+            }
+
+            void simpleExpression()
+            {
+                term();
+                while (peek() == TokenType::PLUS || peek() == TokenType::MINUS)
+                {
+                    ++position;
+                    term();
+                }
+            }
+
+            void term()
+            {
+                factor();
+                while (peek() == TokenType::MULT || peek() == TokenType::DIV)
+                {
+                    ++position;
+                    factor();
+                }
+            }
+
+            void factor()
+            {
+                if (peek() == TokenType::OPENBRACKET)
+                {
+                    ++position;
+                    expression();
+                    expect(TokenType::CLOSEDBRACKET, ")");
+                }
+                else if (peek() == TokenType::NUMBER || peek() == TokenType::IDENTIFIER)
+                {
+                    ++position;
+                }
+                else
+                {
+                    fail("factor");
+                }
+            }
+        };
+
+        // The deepest comment nesting of a program, or -1 if its braces do not balance
+        int commentDepth(const std::string &program)
+        {
+            int depth = 0;
+            int deepest = 0;
+            for (char c : program)
+            {
+                depth += c == '{' ? 1 : c == '}' ? -1
+                                                 : 0;
+                if (depth < 0)
+                {
+                    return -1;
+                }
+                deepest = std::max(deepest, depth);
+            }
+            return depth == 0 ? deepest : -1;
+        }
+    } // namespace
+
+    TEST(ProgramGeneratorTest, GeneratesValidPrograms)
+    {
+        struct Knobs
+        {
+            size_t depth, expressionLength, commentDepth, vocabulary;
+            double commentDensity;
+        };
+        const Knobs knobs[] = {{3, 4, 1, 26, 0.1}, {0, 0, 0, 1, 0.0}, {8, 12, 5, 1000, 1.0}, {1, 1, 2, 3, 0.5}};
+
+        for (const Knobs &knob : knobs)
+        {
+            for (uint64_t seed = 1; seed <= 3; ++seed)
+            {
+                GeneratorOptions options;
+                options.size = 32 * 1024;
+                options.maxNestingDepth = knob.depth;
+                options.maxExpressionLength = knob.expressionLength;
+                options.maxCommentDepth = knob.commentDepth;
+                options.vocabularySize = knob.vocabulary;
+                options.commentDensity = knob.commentDensity;
+                options.seed = seed;
+                const std::string program = ProgramGenerator(options).generate();
+                SCOPED_TRACE("depth " + std::to_string(knob.depth) + ", seed " + std::to_string(seed));
+
+                EXPECT_GE(program.size(), options.size);
+                int comments = commentDepth(program);
+                EXPECT_GE(comments, 0);
+                EXPECT_LE(comments, static_cast<int>(knob.commentDepth));
+
+                Scanner scanner(program);
+                TokenStreamBuilder builder(scanner);
+                builder.build();
+                const TokenStream &tokens = builder.getTokens();
+                EXPECT_EQ(std::count(tokens.getTypes().begin(), tokens.getTypes().end(), TokenType::UNKNOWN), 0);
+                EXPECT_LE(tokens.getSymbolTable().size(), knob.vocabulary);
+
+                GrammarChecker checker(tokens.getTypes());
+                EXPECT_NO_THROW(checker.checkProgram());
+                EXPECT_LE(checker.maxDepth, knob.depth);
+            }
+        }
+    }
+
+    TEST(ProgramGeneratorTest, SeedMakesProgramsReproducible)
+    {
+        GeneratorOptions options;
+        options.size = 200 * 1024;
+        options.seed = 42;
+
+        const std::string program = ProgramGenerator(options).generate();
+        EXPECT_EQ(ProgramGenerator(options).generate(), program);
+
+        // the chunked stream output is the same program
+        std::ostringstream stream;
+        ProgramGenerator(options).generate(stream);
+        EXPECT_EQ(stream.str(), program);
+
+        options.seed = 43;
+        EXPECT_NE(ProgramGenerator(options).generate(), program);
+    }
+
+    TEST(ProgramGeneratorTest, VocabularyAvoidsKeywords)
+    {
+        GeneratorOptions options;
+        options.vocabularySize = 300;
+        ProgramGenerator generator(options);
+
+        const std::vector<std::string> &vocabulary = generator.getVocabulary();
+        ASSERT_EQ(vocabulary.size(), 300u);
+        EXPECT_EQ(vocabulary.front(), "a");
+        EXPECT_EQ(std::find(vocabulary.begin(), vocabulary.end(), "if"), vocabulary.end());
+        for (const std::string &name : vocabulary)
+        {
+            Scanner scanner(name);
+            EXPECT_EQ(scanner.getNextToken().getType(), TokenType::IDENTIFIER) << name;
+        }
+
+        options.vocabularySize = 0;
+        EXPECT_THROW(ProgramGenerator{options}, std::invalid_argument);
+        options.vocabularySize = 1;
+        options.commentDensity = 1.5;
+        EXPECT_THROW(ProgramGenerator{options}, std::invalid_argument);
+    }
+
+} // namespace TINY::SCANNER
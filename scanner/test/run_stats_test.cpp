@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "run_stats.hpp"
+
+namespace TINY::SCANNER
+{
+
+    TEST(RunStatsTest, RecordsPhasesInOrder)
+    {
+        RunStats stats;
+        auto start = RunStats::Clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        stats.addPhase("scan", start, 1000, 200);
+        stats.addPhase("write", RunStats::Clock::now(), 1000, 200);
+
+        ASSERT_EQ(stats.getPhases().size(), 2u);
+        EXPECT_EQ(stats.getPhases()[0].name, "scan");
+        EXPECT_GE(stats.getPhases()[0].seconds, 0.002);
+        EXPECT_EQ(stats.getPhases()[0].tokens, 200u);
+        EXPECT_EQ(stats.getPhases()[1].name, "write");
+        EXPECT_GE(stats.elapsedSeconds(), stats.getPhases()[0].seconds);
+
+#if defined(__unix__) || defined(__APPLE__)
+        ASSERT_TRUE(RunStats::peakResidentBytes().has_value());
+        EXPECT_GT(*RunStats::peakResidentBytes(), 0u);
+#endif
+    }
+
+    TEST(RunStatsTest, PrintsTableAndJson)
+    {
+        RunStats stats;
+        stats.addPhase("read", RunStats::Clock::now(), 4096, 0);
+        stats.addPhase("scan", RunStats::Clock::now() - std::chrono::milliseconds(10), 4096, 512);
+        stats.setTotals(4096, 512);
+
+        // the table leaves the stream's number format as it was
+        std::ostringstream table;
+        table << std::hex;
+        stats.print(table);
+        EXPECT_NE(table.str().find("scan"), std::string::npos);
+        EXPECT_NE(table.str().find("Tokens:         512"), std::string::npos);
+        EXPECT_TRUE(table.flags() & std::ios_base::hex);
+
+        std::ostringstream json;
+        stats.printJson(json);
+        const std::string text = json.str();
+        EXPECT_EQ(text.rfind("{\"input_bytes\":4096,\"tokens\":512,\"wall_seconds\":", 0), 0u);
+        EXPECT_NE(text.find("\"peak_rss_bytes\":"), std::string::npos);
+        EXPECT_NE(text.find("{\"name\":\"read\""), std::string::npos);
+        EXPECT_NE(text.find("\"tokens\":0,\"bytes_per_second\":"), std::string::npos);
+        EXPECT_NE(text.find("{\"name\":\"scan\""), std::string::npos);
+        EXPECT_EQ(text.substr(text.size() - 3), "]}\n");
+        EXPECT_EQ(text.find('\n'), text.size() - 1);
+    }
+
+} // namespace TINY::SCANNER
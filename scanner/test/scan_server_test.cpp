@@ -0,0 +1,278 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "file_handler.hpp"
+#include "scan_server.hpp"
+#include "scanner.hpp"
+#include "token_pipe.hpp"
+#include "token_stream_builder.hpp"
+#include "token_writer.hpp"
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Tokenizes a source in process, in the text format the server answers with
+        std::string scanLocally(const std::string &source, bool includePosition)
+        {
+            Scanner scanner(source);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            std::ostringstream output;
+            {
+                TokenWriter writer(output);
+                writer.write(builder.getTokens(), includePosition);
+            }
+            return output.str();
+        }
+
+        // Connects a plain socket to the server, to send partial requests
+        int connectRaw(const std::string &path)
+        {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+            int socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (socket >= 0 && ::connect(socket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+            {
+                ::close(socket);
+                return -1;
+            }
+            return socket;
+        }
+
+        // Returns the resident memory of this process in bytes, 0 where /proc is not available
+        size_t residentBytes()
+        {
+            std::ifstream statm("/proc/self/statm");
+            size_t totalPages = 0;
+            size_t residentPages = 0;
+            if (!(statm >> totalPages >> residentPages))
+            {
+                return 0;
+            }
+            return residentPages * static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        }
+
+        // Sends a request header announcing a payload of the given length on a plain socket
+        bool sendHeader(int socket, uint32_t length)
+        {
+            ScanRequestHeader header{};
+            header.length = length;
+            return ::send(socket, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+        }
+
+        // Runs a server on a scratch socket for the lifetime of the fixture
+        class ScanServerTest : public ::testing::Test
+        {
+        protected:
+            std::filesystem::path root = std::filesystem::temp_directory_path() / "scan_server_test";
+            std::string socketPath = (root / "scanner.sock").string();
+            std::optional<ScanServer> server;
+            std::thread serverThread;
+
+            void SetUp() override
+            {
+                std::filesystem::remove_all(root);
+                std::filesystem::create_directories(root);
+                server.emplace(socketPath, 2);
+                serverThread = std::thread([this]
+                                           { server->run(); });
+            }
+
+            void TearDown() override
+            {
+                server->stop();
+                serverThread.join();
+                server.reset();
+                std::filesystem::remove_all(root);
+            }
+        };
+    } // namespace
+
+    // Test that concurrent clients sending several requests each get the tokens of their sources
+    TEST_F(ScanServerTest, ConcurrentClients)
+    {
+        std::vector<std::thread> clients;
+        std::vector<std::string> failures(4);
+        for (size_t c = 0; c < failures.size(); ++c)
+        {
+            clients.emplace_back([&, c]
+                                 {
+                ScanClient client(socketPath);
+                for (int i = 0; i < 20; ++i)
+                {
+                    std::string source = "read x" + std::to_string(c) + ";\n{ note }\nx := x * " + std::to_string(i) + " @";
+                    bool positions = i % 2 == 0;
+                    ScanResponse response = client.scanSource(source, positions ? ScanFormat::TEXT_WITH_POSITIONS : ScanFormat::TEXT);
+                    std::string expected = scanLocally(source, positions);
+                    size_t lines = static_cast<size_t>(std::count(expected.begin(), expected.end(), '\n'));
+                    if (!response.ok || response.tokenCount != lines || response.body != expected)
+                    {
+                        failures[c] = source;
+                    }
+                } });
+        }
+        for (std::thread &client : clients)
+        {
+            client.join();
+        }
+        for (const std::string &failure : failures)
+        {
+            EXPECT_EQ(failure, "");
+        }
+    }
+
+    // Test that idle connections, more than there are workers, hold up no other client
+    TEST_F(ScanServerTest, IdleConnectionsDoNotBlock)
+    {
+        std::vector<std::unique_ptr<ScanClient>> idle;
+        for (size_t i = 0; i < server->threadCount() * 2 + 1; ++i)
+        {
+            idle.push_back(std::make_unique<ScanClient>(socketPath));
+        }
+
+        // another has sent half a request header
+        int partial = connectRaw(socketPath);
+        ASSERT_GE(partial, 0);
+        const char half[4] = {};
+        ASSERT_EQ(::send(partial, half, sizeof(half), 0), 4);
+
+        ScanClient client(socketPath);
+        ScanResponse response = client.scanSource("read x;");
+        EXPECT_TRUE(response.ok);
+        EXPECT_EQ(response.body, scanLocally("read x;", false));
+
+        // a request and response larger than the socket buffers arrive and leave in parts
+        std::string big;
+        for (int i = 0; i < 100000; ++i)
+        {
+            big += "x := x + 1; { step }\n";
+        }
+        ScanResponse bigResponse = client.scanSource(big, ScanFormat::TEXT_WITH_POSITIONS);
+        EXPECT_TRUE(bigResponse.ok);
+        EXPECT_EQ(bigResponse.tokenCount, 600000u);
+        EXPECT_EQ(bigResponse.body, scanLocally(big, true));
+
+        // the idle clients are still served afterwards
+        EXPECT_TRUE(idle.front()->scanSource("x").ok);
+        ::close(partial);
+    }
+
+    // Test that announced payloads take no memory before they arrive, and that the server limits pending bytes
+    TEST_F(ScanServerTest, PendingRequestsAreBounded)
+    {
+        // connections that announce the largest payload and send nothing of it
+        size_t residentBefore = residentBytes();
+        std::vector<int> announced;
+        for (int i = 0; i < 3; ++i)
+        {
+            announced.push_back(connectRaw(socketPath));
+            ASSERT_GE(announced.back(), 0);
+            ASSERT_TRUE(sendHeader(announced.back(), ScanServer::MAX_REQUEST_SIZE));
+        }
+        ScanClient client(socketPath);
+        EXPECT_TRUE(client.scanSource("read x;").ok);
+        if (residentBefore != 0)
+        {
+            EXPECT_LT(residentBytes(), residentBefore + (256u << 20));
+        }
+
+        // a server with room for 256 KiB, of which a half-sent request holds 160 KiB
+        std::string limitedPath = (root / "limited.sock").string();
+        ScanServer limited(limitedPath, 1, 256 * 1024);
+        std::thread limitedThread([&limited]
+                                  { limited.run(); });
+        int holding = connectRaw(limitedPath);
+        ASSERT_GE(holding, 0);
+        ASSERT_TRUE(sendHeader(holding, 1u << 20));
+        std::string part(160 * 1024, ' ');
+        ASSERT_EQ(::send(holding, part.data(), part.size(), 0), static_cast<ssize_t>(part.size()));
+
+        // small requests still fit, one that would go over the limit is refused
+        ScanClient small(limitedPath);
+        EXPECT_TRUE(small.scanSource("read x;").ok);
+        std::string large(128 * 1024, 'x');
+        ScanClient refused(limitedPath);
+        ScanResponse response = refused.scanSource(large);
+        EXPECT_FALSE(response.ok);
+        EXPECT_NE(response.body.find("too many pending requests"), std::string::npos);
+
+        // closing the half-sent request gives its bytes back
+        ::close(holding);
+        ScanClient after(limitedPath);
+        EXPECT_TRUE(after.scanSource(large).ok);
+
+        limited.stop();
+        limitedThread.join();
+        for (int socket : announced)
+        {
+            ::close(socket);
+        }
+    }
+
+    // Test path requests, binary responses, empty sources and errors
+    TEST_F(ScanServerTest, PathsFormatsAndErrors)
+    {
+        std::string source = "if x < 10 then\n  write x\nend";
+        std::string path = (root / "input.tny").string();
+        FileHandler::writeFile(path, source);
+
+        ScanClient client(socketPath);
+        ScanResponse text = client.scanFile(path, ScanFormat::TEXT_WITH_POSITIONS);
+        ASSERT_TRUE(text.ok);
+        EXPECT_EQ(text.body, scanLocally(source, true));
+
+        // the binary response is a complete token pipe
+        ScanResponse binary = client.scanSource(source, ScanFormat::BINARY);
+        ASSERT_TRUE(binary.ok);
+        std::istringstream pipe(binary.body);
+        TokenPipeReader reader(pipe);
+        std::string pipeText;
+        while (std::optional<Token> token = reader.next())
+        {
+            pipeText += token->toString(true) + "\n";
+        }
+        EXPECT_EQ(pipeText, text.body);
+        EXPECT_EQ(binary.tokenCount, text.tokenCount);
+
+        ScanResponse empty = client.scanSource("");
+        EXPECT_TRUE(empty.ok);
+        EXPECT_EQ(empty.tokenCount, 0u);
+        EXPECT_EQ(empty.body, "");
+
+        // a failed request is answered with its error and the connection stays usable
+        ScanResponse missing = client.scanFile((root / "missing.tny").string());
+        EXPECT_FALSE(missing.ok);
+        EXPECT_FALSE(missing.body.empty());
+        EXPECT_TRUE(client.scanSource("x").ok);
+
+        // a header with a nonzero reserved field is answered with an error and the connection ends
+        int raw = connectRaw(socketPath);
+        ASSERT_GE(raw, 0);
+        ScanRequestHeader header{};
+        header.reserved = 1;
+        ASSERT_EQ(::send(raw, &header, sizeof(header), 0), static_cast<ssize_t>(sizeof(header)));
+        ScanResponseHeader responseHeader{};
+        ASSERT_EQ(::recv(raw, &responseHeader, sizeof(responseHeader), MSG_WAITALL), static_cast<ssize_t>(sizeof(responseHeader)));
+        EXPECT_EQ(responseHeader.ok, 0);
+        ::close(raw);
+
+        // a second server on a live socket is refused
+        EXPECT_THROW(ScanServer(socketPath, 1), std::runtime_error);
+    }
+
+} // namespace TINY::SCANNER
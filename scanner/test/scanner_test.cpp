@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
 #include "scanner.hpp"
 #include "token.hpp"
+#include "token_stream_builder.hpp"
 
 namespace TINY::SCANNER
 {
@@ -365,4 +370,232 @@ namespace TINY::SCANNER
 
         EXPECT_FALSE(scanner.hasMoreTokens());
     }
+
+    // New test case: A NUL byte inside a comment ends the input after one error
+    TEST(ScannerTest, NulInsideComment)
+    {
+        std::string input("read x; { note \0 } write y;", 27);
+        ASSERT_EQ(input.size(), 27u);
+
+        Scanner scanner(input);
+        EXPECT_EQ(scanner.getNextToken().getType(), TokenType::READ);
+        EXPECT_EQ(scanner.getNextToken().getType(), TokenType::IDENTIFIER);
+        EXPECT_EQ(scanner.getNextToken().getType(), TokenType::SEMICOLON);
+
+        Token error = scanner.getNextToken();
+        EXPECT_EQ(error.getType(), TokenType::UNKNOWN);
+        EXPECT_EQ(error.getValue(), "Unclosed comment");
+
+        EXPECT_FALSE(scanner.hasMoreTokens());
+        EXPECT_EQ(scanner.getNextToken().getType(), TokenType::END_OF_INPUT);
+        EXPECT_EQ(scanner.getNextToken().getType(), TokenType::END_OF_INPUT);
+    }
+
+    // New test case: Borrowed input view
+    TEST(ScannerTest, BorrowedInputView)
+    {
+        // Only the first statement is visible to the scanner, the rest of the buffer is not scanned
+        std::string buffer = "read x; write y;";
+        std::string_view input(buffer.data(), 7);
+
+        Scanner scanner(input);
+
+        EXPECT_EQ(scanner.getNextToken().getType(), TokenType::READ);
+        EXPECT_EQ(scanner.getNextToken().getType(), TokenType::IDENTIFIER);
+        EXPECT_EQ(scanner.getNextToken().getType(), TokenType::SEMICOLON);
+        EXPECT_FALSE(scanner.hasMoreTokens());
+    }
+
+    // New test case: End of input token
+    TEST(ScannerTest, EndOfInputToken)
+    {
+        std::string input = "x := 1 { trailing comment }\n";
+
+        Scanner scanner(input);
+
+        // Read every token in a single pass, without hasMoreTokens()
+        std::vector<TokenType> types;
+        while (true)
+        {
+            Token token = scanner.getNextToken();
+            if (token.getType() == TokenType::END_OF_INPUT)
+            {
+                break;
+            }
+            types.push_back(token.getType());
+        }
+        EXPECT_EQ(types, (std::vector<TokenType>{TokenType::IDENTIFIER, TokenType::ASSIGN, TokenType::NUMBER}));
+
+        // The end of input token is returned again on every further call
+        Token end = scanner.getNextToken();
+        EXPECT_EQ(end.getType(), TokenType::END_OF_INPUT);
+        EXPECT_EQ(end.getValue(), "");
+        EXPECT_EQ(end.getLine(), 2);
+        EXPECT_EQ(end.getColumn(), 1);
+
+        // An unclosed comment is reported once, then the input ends
+        Scanner unclosed("read { never closed");
+        EXPECT_EQ(unclosed.getNextToken().getType(), TokenType::READ);
+        EXPECT_EQ(unclosed.getNextToken().getValue(), "Unclosed comment");
+        EXPECT_EQ(unclosed.getNextToken().getType(), TokenType::END_OF_INPUT);
+    }
+
+    // New test case: Lazy token range
+    TEST(ScannerTest, TokenRange)
+    {
+        std::string input = "read x; { comment } y := x + 1";
+
+        Scanner scanner(input);
+
+        // The range yields the same tokens as getNextToken(), in order
+        std::vector<std::string> values;
+        for (const Token &token : scanner.tokens())
+        {
+            values.emplace_back(token.getValue());
+        }
+        EXPECT_EQ(values, (std::vector<std::string>{"read", "x", ";", "y", ":=", "x", "+", "1"}));
+
+        // The range consumed the scanner
+        EXPECT_FALSE(scanner.hasMoreTokens());
+        EXPECT_EQ(scanner.tokens().begin(), scanner.tokens().end());
+
+        // Ranges work with standard algorithms
+        Scanner counter(input);
+        Scanner::TokenRange range = counter.tokens();
+        EXPECT_EQ(std::count_if(range.begin(), range.end(), [](const Token &token)
+                                { return token.getType() == TokenType::IDENTIFIER; }),
+                  3);
+    }
+
+    // New test case: The lazy range yields the tokens build() stores, plus the unclosed comment error
+    TEST(ScannerTest, TokenRangeMatchesBuild)
+    {
+        std::vector<std::string> inputs = {
+            "read x; { comment } y := x + 1",
+            std::string("a { x \0 } b c", 13),
+            "if a < 1 then { open { nested } write a",
+            "x @ { a } # y",
+        };
+        for (const std::string &input : inputs)
+        {
+            Scanner lazy(input);
+            std::vector<std::string> ranged;
+            for (const Token &token : lazy.tokens())
+            {
+                ranged.push_back(token.toString(true));
+            }
+
+            // build() stops at an unclosed comment without a token, the range reports it
+            if (!ranged.empty() && ranged.back().rfind("Unclosed comment, ", 0) == 0)
+            {
+                ranged.pop_back();
+            }
+
+            Scanner eager(input);
+            TokenStreamBuilder builder(eager);
+            builder.build();
+            std::vector<std::string> built;
+            for (const Token &token : builder.getTokens().toTokens())
+            {
+                built.push_back(token.toString(true));
+            }
+            EXPECT_EQ(ranged, built) << input;
+        }
+    }
+
+    // New test case: Every policy combination scans the same types, and only what its policies keep
+    TEST(ScannerTest, Policies)
+    {
+        std::string input = "read x;\n{ note }\n  x := x * 10 @ { open";
+
+        Scanner reference(input);
+        BasicScanner<NoPositions, ViewValues> values(input);
+        BasicScanner<NoPositions, NoValues> types(input);
+        while (true)
+        {
+            Token token = reference.getNextToken();
+
+            Token valueOnly = values.getNextToken();
+            EXPECT_EQ(valueOnly.getType(), token.getType());
+            EXPECT_EQ(valueOnly.getValue(), token.getValue());
+            EXPECT_EQ(valueOnly.getLine(), 0);
+            EXPECT_EQ(valueOnly.getColumn(), 0);
+
+            Token typeOnly = types.getNextToken();
+            EXPECT_EQ(typeOnly.getType(), token.getType());
+            EXPECT_TRUE(typeOnly.getValue().empty());
+            EXPECT_EQ(typeOnly.getLine(), 0);
+
+            if (token.getType() == TokenType::END_OF_INPUT)
+            {
+                break;
+            }
+        }
+
+        // Ranges work the same for every instantiation
+        BasicScanner<NoPositions, ViewValues> ranged(input);
+        std::vector<std::string_view> rangeValues;
+        for (const Token &token : ranged.tokens())
+        {
+            rangeValues.push_back(token.getValue());
+        }
+        EXPECT_EQ(rangeValues, (std::vector<std::string_view>{"read", "x", ";", "x", ":=", "x", "*", "10", "@", "Unclosed comment"}));
+    }
+
+    // New test case: Restoring a checkpoint rescans the same tokens with the same positions
+    TEST(ScannerTest, Checkpoint)
+    {
+        std::string input = "read x;\n{ a { b } }\nx := x + 1 @\nwrite x";
+        Scanner scanner(input);
+        scanner.getNextToken();
+
+        Scanner::Checkpoint checkpoint = scanner.save();
+        std::vector<std::string> first;
+        for (const Token &token : scanner.tokens())
+        {
+            first.push_back(token.toString(true));
+        }
+        ASSERT_EQ(first.size(), 10u);
+
+        // Rewind from the end, then twice from the middle
+        scanner.restore(checkpoint);
+        EXPECT_EQ(scanner.getNextToken().toString(true), first[0]);
+        Scanner::Checkpoint middle = scanner.save();
+        EXPECT_EQ(middle.offset(), 6u);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            scanner.restore(middle);
+            std::vector<std::string> rest;
+            for (const Token &token : scanner.tokens())
+            {
+                rest.push_back(token.toString(true));
+            }
+            EXPECT_EQ(rest, std::vector<std::string>(first.begin() + 1, first.end()));
+        }
+
+        // The comment depth is part of the checkpoint
+        Scanner nested(input, 10, 2, 3, 1);
+        Scanner::Checkpoint inComment = nested.save();
+        Token afterComment = nested.getNextToken();
+        EXPECT_EQ(afterComment.getValue(), "x");
+        nested.restore(inComment);
+        EXPECT_EQ(nested.getNextToken().toString(true), afterComment.toString(true));
+
+        // A checkpoint of a previous input is rejected, even where the new input is long enough
+        scanner.reset("x");
+        EXPECT_THROW(scanner.restore(checkpoint), std::invalid_argument);
+        scanner.reset(input);
+        EXPECT_THROW(scanner.restore(middle), std::invalid_argument);
+        scanner.restore(Scanner::Checkpoint());
+        EXPECT_EQ(scanner.getNextToken().getValue(), "read");
+
+        // An incremental update moves the scanner to the edited source too
+        std::string source = input;
+        Scanner edited(source);
+        TokenStreamBuilder builder(edited);
+        builder.build();
+        Scanner::Checkpoint end = edited.save();
+        builder.applyEdit(source, 5, 1, "y");
+        EXPECT_THROW(edited.restore(end), std::invalid_argument);
+    }
 } // namespace TINY::SCANNER
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "simd_scan.hpp"
+
+namespace TINY::SCANNER::SIMD
+{
+
+    namespace
+    {
+        // Runs a check once for every kernel the CPU supports, then restores the detected kernel
+        template <typename Check>
+        void forEachKernel(Check check)
+        {
+            Kernel detected = activeKernel();
+            for (Kernel kernel : {Kernel::SCALAR, Kernel::SSE2, Kernel::AVX2})
+            {
+                if (selectKernel(kernel))
+                {
+                    SCOPED_TRACE(std::string(kernelName(kernel)));
+                    check();
+                }
+            }
+            selectKernel(detected);
+        }
+    } // namespace
+
+    // Test whitespace skipping at every position of a long run, across vector boundaries
+    TEST(SimdScanTest, FindNonSpace)
+    {
+        forEachKernel([]
+                      {
+            const std::string spaces = " \t\n\v\f\r";
+            for (size_t length = 0; length < 80; ++length)
+            {
+                std::string input;
+                for (size_t i = 0; i < length; ++i)
+                {
+                    input += spaces[i % spaces.size()];
+                }
+                input += "x" + std::string(40, ' ');
+                EXPECT_EQ(findNonSpace(input.data(), input.data() + input.size()), input.data() + length);
+            }
+
+            // Bytes around the whitespace range are not whitespace, and an all-space range returns end
+            std::string edges = "\x08\x0E\x1F!";
+            for (size_t i = 0; i < edges.size(); ++i)
+            {
+                EXPECT_EQ(findNonSpace(edges.data() + i, edges.data() + edges.size()), edges.data() + i);
+            }
+            std::string blanks(100, ' ');
+            EXPECT_EQ(findNonSpace(blanks.data(), blanks.data() + blanks.size()), blanks.data() + blanks.size()); });
+    }
+
+    // Test comment delimiter search for '{', '}' and '\0'
+    TEST(SimdScanTest, FindCommentDelimiter)
+    {
+        forEachKernel([]
+                      {
+            for (char delimiter : {'{', '}', '\0'})
+            {
+                for (size_t offset = 0; offset < 70; ++offset)
+                {
+                    std::string input(100, 'a');
+                    input[offset] = delimiter;
+                    input[offset + 1] = '{';
+                    EXPECT_EQ(findCommentDelimiter(input.data(), input.data() + input.size()), input.data() + offset);
+                }
+            }
+            std::string text(100, 'a');
+            EXPECT_EQ(findCommentDelimiter(text.data(), text.data() + text.size()), text.data() + text.size()); });
+    }
+
+    // Test newline counting over ranges of every length
+    TEST(SimdScanTest, CountNewlines)
+    {
+        forEachKernel([]
+                      {
+            std::string input;
+            for (size_t i = 0; i < 200; ++i)
+            {
+                input += (i % 3 == 0) ? '\n' : 'x';
+            }
+            for (size_t length = 0; length <= input.size(); ++length)
+            {
+                EXPECT_EQ(countNewlines(input.data(), input.data() + length), (length + 2) / 3);
+            } });
+    }
+} // namespace TINY::SCANNER::SIMD
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "scanner.hpp"
+#include "stream_scanner.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Renders tokens with their positions, for comparing token streams
+        std::vector<std::string> render(const std::vector<Token> &tokens)
+        {
+            std::vector<std::string> lines;
+            for (const Token &token : tokens)
+            {
+                lines.push_back(token.toString(true));
+            }
+            return lines;
+        }
+
+        // Scans the whole input at once with the Scanner
+        std::vector<std::string> scanWhole(const std::string &input)
+        {
+            Scanner scanner(input);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            return render(builder.getTokens().toTokens());
+        }
+
+        // Feeds the input to a StreamScanner in chunks of the given size, rendering each token
+        // in the callback, where its value is valid
+        std::vector<std::string> scanInChunks(const std::string &input, size_t chunkSize)
+        {
+            std::vector<std::string> lines;
+            StreamScanner scanner([&lines](const Token &token)
+                                  { lines.push_back(token.toString(true)); });
+            for (size_t offset = 0; offset < input.size(); offset += chunkSize)
+            {
+                scanner.feed(std::string_view(input).substr(offset, chunkSize));
+            }
+            scanner.finish();
+            return lines;
+        }
+    } // namespace
+
+    // Test that every chunk size gives the same tokens and positions as scanning the whole input
+    TEST(StreamScannerTest, ChunkBoundaries)
+    {
+        std::string input = "{ header { nested\n comment } }\nread abc;\n"
+                            "if x1 < 10 then y := x * 42 { inline } end\n"
+                            "repeat z:=z-1 until z = 0; a : = b; @ } _\n"
+                            "write longidentifiername";
+
+        std::vector<std::string> expected = scanWhole(input);
+        for (size_t chunkSize = 1; chunkSize <= input.size(); ++chunkSize)
+        {
+            EXPECT_EQ(scanInChunks(input, chunkSize), expected) << "chunk size " << chunkSize;
+        }
+    }
+
+    // Test that scanning stops at an unclosed comment split across chunks
+    TEST(StreamScannerTest, UnclosedCommentAcrossChunks)
+    {
+        std::string input = "read x; { outer { inner } write y;";
+
+        for (size_t chunkSize = 1; chunkSize <= input.size(); ++chunkSize)
+        {
+            std::vector<Token> tokens;
+            StreamScanner scanner([&tokens](const Token &token)
+                                  { tokens.push_back(token); });
+            for (size_t offset = 0; offset < input.size(); offset += chunkSize)
+            {
+                scanner.feed(std::string_view(input).substr(offset, chunkSize));
+            }
+            scanner.finish();
+
+            ASSERT_EQ(tokens.size(), 3u);
+            EXPECT_EQ(tokens[2].getType(), TokenType::SEMICOLON);
+            EXPECT_TRUE(scanner.hasUnclosedComment());
+        }
+    }
+
+    // Test scanning a stream through a small read buffer
+    TEST(StreamScannerTest, ScanStream)
+    {
+        std::string input;
+        for (int i = 0; i < 1000; ++i)
+        {
+            input += "x := x + 1; { step }\n";
+        }
+        std::istringstream stream(input);
+
+        size_t tokenCount = 0;
+        StreamScanner scanner([&tokenCount](const Token &)
+                              { ++tokenCount; });
+        EXPECT_EQ(scanner.scan(stream, 64), input.size());
+        EXPECT_EQ(tokenCount, 6000u);
+        EXPECT_FALSE(scanner.hasUnclosedComment());
+    }
+
+    // Test that a token longer than the limit is rejected, whether or not a chunk boundary cuts it
+    TEST(StreamScannerTest, TokenLengthLimit)
+    {
+        std::string atLimit = "x := " + std::string(64, 'a') + ";";
+        std::string overLimit = "x := " + std::string(65, 'a') + ";";
+        for (size_t chunkSize : {size_t(7), overLimit.size()})
+        {
+            size_t tokenCount = 0;
+            StreamScanner scanner([&tokenCount](const Token &)
+                                  { ++tokenCount; },
+                                  64);
+            for (size_t offset = 0; offset < atLimit.size(); offset += chunkSize)
+            {
+                scanner.feed(std::string_view(atLimit).substr(offset, chunkSize));
+            }
+            EXPECT_EQ(tokenCount, 4u);
+
+            StreamScanner limited([](const Token &) {}, 64);
+            EXPECT_THROW(
+                {
+                    for (size_t offset = 0; offset < overLimit.size(); offset += chunkSize)
+                    {
+                        limited.feed(std::string_view(overLimit).substr(offset, chunkSize));
+                    }
+                },
+                std::runtime_error)
+                << "chunk size " << chunkSize;
+        }
+    }
+
+    // Test that a line's tokens are emitted as soon as the line is fed, with comments spanning lines
+    TEST(StreamScannerTest, LineAtATime)
+    {
+        std::vector<std::string> lines = {"read x; { outer\n", "{ inner }\n", "still } x := 10\n", "write x\n"};
+        std::vector<size_t> countsAfterLine = {3, 3, 6, 8};
+
+        std::vector<std::string> tokens;
+        StreamScanner scanner([&tokens](const Token &token)
+                              { tokens.push_back(token.toString(true)); });
+        std::string input;
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            scanner.feed(lines[i]);
+            input += lines[i];
+            EXPECT_EQ(tokens.size(), countsAfterLine[i]) << "after line " << i + 1;
+        }
+        scanner.finish();
+        EXPECT_EQ(tokens, scanWhole(input));
+        EXPECT_FALSE(scanner.hasUnclosedComment());
+    }
+} // namespace TINY::SCANNER
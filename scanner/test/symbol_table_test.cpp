@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "scanner.hpp"
+#include "symbol_table.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER
+{
+
+    // Test that equal spellings share an ID and IDs are dense in order of first appearance
+    TEST(SymbolTableTest, InternAssignsDenseIds)
+    {
+        SymbolTable table;
+        EXPECT_EQ(table.intern("x"), 0u);
+        EXPECT_EQ(table.intern("count"), 1u);
+        EXPECT_EQ(table.intern("x"), 0u);
+        EXPECT_EQ(table.intern("y"), 2u);
+
+        EXPECT_EQ(table.size(), 3u);
+        EXPECT_EQ(table.spelling(1), "count");
+        EXPECT_EQ(table.find("y"), 2u);
+        EXPECT_EQ(table.find("z"), SymbolTable::NO_SYMBOL);
+    }
+
+    // Test that spellings are copied into the table and survive the source, copies and moves
+    TEST(SymbolTableTest, SpellingsOwnedByTable)
+    {
+        SymbolTable table;
+        {
+            std::string name = "temporary";
+            std::string huge(SymbolTable::BLOCK_SIZE + 10, 'q');
+            table.intern(name);
+            table.intern(huge);
+            for (int i = 0; i < 20000; ++i)
+            {
+                table.intern("name" + std::to_string(i)); // spans several arena blocks
+            }
+        }
+        EXPECT_EQ(table.spelling(0), "temporary");
+        EXPECT_EQ(table.spelling(1).size(), SymbolTable::BLOCK_SIZE + 10);
+        EXPECT_EQ(table.spelling(20001), "name19999");
+
+        SymbolTable copy = table;
+        EXPECT_EQ(copy.size(), table.size());
+        EXPECT_EQ(copy.find("name123"), table.find("name123"));
+        EXPECT_NE(copy.spelling(0).data(), table.spelling(0).data());
+
+        SymbolTable moved = std::move(table);
+        EXPECT_EQ(moved.spelling(0), "temporary");
+        EXPECT_EQ(table.size(), 0u);
+    }
+
+    // Test the symbol IDs the token stream gives to identifier tokens
+    TEST(SymbolTableTest, TokenStreamSymbols)
+    {
+        std::string input = "read x; y := x + 1; write y";
+        Scanner scanner(input);
+        TokenStreamBuilder builder(scanner);
+        builder.build();
+        const TokenStream &tokens = builder.getTokens();
+
+        const std::uint32_t none = SymbolTable::NO_SYMBOL;
+        std::vector<std::uint32_t> expected = {none, 0, none, 1, none, 0, none, none, none, none, 1};
+        EXPECT_EQ(tokens.getSymbols(), expected);
+        EXPECT_EQ(tokens.getSymbolTable().spelling(tokens[3].getSymbol()), "y");
+    }
+
+} // namespace TINY::SCANNER
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "thread_pool.hpp"
+
+namespace TINY::SCANNER
+{
+
+    // Test that every submitted task runs exactly once before wait returns
+    TEST(ThreadPoolTest, RunsEveryTask)
+    {
+        ThreadPool pool(4);
+        EXPECT_EQ(pool.size(), 4u);
+
+        std::vector<std::atomic<int>> runs(1000);
+        for (std::atomic<int> &run : runs)
+        {
+            pool.submit([&run]
+                        { ++run; });
+        }
+        pool.wait();
+
+        for (const std::atomic<int> &run : runs)
+        {
+            EXPECT_EQ(run.load(), 1);
+        }
+
+        // the pool can be reused after waiting
+        std::atomic<int> more{0};
+        pool.submit([&more]
+                    { ++more; });
+        pool.wait();
+        EXPECT_EQ(more.load(), 1);
+    }
+
+    // Test that a failing task does not stop the others and its exception reaches wait
+    TEST(ThreadPoolTest, ReportsFirstError)
+    {
+        ThreadPool pool(2);
+        std::atomic<int> finished{0};
+        for (int i = 0; i < 10; ++i)
+        {
+            pool.submit([i, &finished]
+                        {
+                if (i == 3)
+                {
+                    throw std::runtime_error("task failed");
+                }
+                ++finished; });
+        }
+        EXPECT_THROW(pool.wait(), std::runtime_error);
+        EXPECT_EQ(finished.load(), 9);
+
+        // the error is reported once
+        EXPECT_NO_THROW(pool.wait());
+    }
+
+} // namespace TINY::SCANNER
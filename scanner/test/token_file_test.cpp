@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "file_handler.hpp"
+#include "scanner.hpp"
+#include "token_file.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Path of a scratch file in the system's temporary directory
+        std::string tempPath(const std::string &name)
+        {
+            return (std::filesystem::temp_directory_path() / name).string();
+        }
+    } // namespace
+
+    // Test that a token file holds the same tokens as the stream it was written from
+    TEST(TokenFileTest, RoundTrip)
+    {
+        std::string input = "read x;\nx := x + 1 { note }\nwrite x @";
+        Scanner scanner(input);
+        TokenStreamBuilder builder(scanner);
+        builder.build();
+        const TokenStream &tokens = builder.getTokens();
+
+        std::string path = tempPath("token_file_round_trip.bin");
+        FileHandler::writeBinaryTokens(path, tokens);
+
+        {
+            TokenFile file(path);
+            ASSERT_EQ(file.size(), tokens.size());
+            for (size_t i = 0; i < tokens.size(); ++i)
+            {
+                EXPECT_EQ(file.record(i).type, tokens[i].getType());
+                EXPECT_EQ(file.record(i).line, static_cast<uint32_t>(tokens[i].getLine()));
+                EXPECT_EQ(file.record(i).column, static_cast<uint32_t>(tokens[i].getColumn()));
+                EXPECT_EQ(file.valueAt(i), tokens[i].getValue());
+                EXPECT_EQ(file.toToken(i).toString(true), tokens[i].toString(true));
+            }
+
+            // Repeated values share one entry in the string pool
+            EXPECT_EQ(file.record(1).offset, file.record(3).offset);
+        }
+        std::remove(path.c_str());
+    }
+
+    // Test that files which are not complete token files are rejected
+    TEST(TokenFileTest, RejectsInvalidFiles)
+    {
+        std::string path = tempPath("token_file_invalid.bin");
+
+        FileHandler::writeFile(path, "not a token file, just some text");
+        EXPECT_THROW(TokenFile file(path), std::runtime_error);
+
+        // A valid file cut short in the middle of its records
+        std::string input = "x := 1; y := 2";
+        Scanner scanner(input);
+        TokenStreamBuilder builder(scanner);
+        builder.build();
+        FileHandler::writeBinaryTokens(path, builder.getTokens());
+        std::string content = FileHandler::readFile(path);
+        FileHandler::writeFile(path, content.substr(0, sizeof(TokenFileHeader) + sizeof(TokenRecord) + 3));
+        EXPECT_THROW(TokenFile file(path), std::runtime_error);
+
+        // A record whose type is not a token type
+        std::string badType = content;
+        badType[sizeof(TokenFileHeader) + offsetof(TokenRecord, type)] = static_cast<char>(0xff);
+        FileHandler::writeFile(path, badType);
+        try
+        {
+            TokenFile file(path);
+            ADD_FAILURE() << "a record with an invalid type was accepted";
+        }
+        catch (const std::runtime_error &error)
+        {
+            EXPECT_NE(std::string(error.what()).find("invalid token type"), std::string::npos);
+        }
+
+        // The same file with its version written in the other byte order
+        std::swap(content[4], content[5]);
+        FileHandler::writeFile(path, content);
+        try
+        {
+            TokenFile file(path);
+            ADD_FAILURE() << "a file of the other byte order was accepted";
+        }
+        catch (const std::runtime_error &error)
+        {
+            EXPECT_NE(std::string(error.what()).find("other byte order"), std::string::npos);
+        }
+
+        std::remove(path.c_str());
+    }
+
+} // namespace TINY::SCANNER
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "scanner.hpp"
+#include "token_pipe.hpp"
+
+namespace TINY::SCANNER
+{
+
+    // Test that a token pipe read back holds the tokens it was written from, in order
+    TEST(TokenPipeTest, RoundTrip)
+    {
+        std::string input = "read x;\nx := x + 1 { note }\nwrite x @";
+        std::vector<Token> tokens;
+        Scanner scanner(input);
+        for (const Token &token : scanner.tokens())
+        {
+            tokens.push_back(token);
+        }
+
+        // a buffer smaller than one record still writes every token, in order
+        std::ostringstream output;
+        {
+            TokenPipeWriter writer(output, 8);
+            for (const Token &token : tokens)
+            {
+                writer.write(token);
+            }
+            writer.finish();
+        }
+
+        std::istringstream pipe(output.str());
+        TokenPipeReader reader(pipe);
+        for (const Token &token : tokens)
+        {
+            std::optional<Token> read = reader.next();
+            ASSERT_TRUE(read.has_value());
+            EXPECT_EQ(read->toString(true), token.toString(true));
+        }
+        EXPECT_FALSE(reader.next().has_value());
+        EXPECT_FALSE(reader.next().has_value());
+    }
+
+    // Test that tokens reach the stream on flush, and that a cut or foreign stream is rejected
+    TEST(TokenPipeTest, FlushAndTruncation)
+    {
+        std::ostringstream output;
+        TokenPipeWriter writer(output);
+        writer.write(TokenType::IDENTIFIER, "abc", 2, 4);
+        EXPECT_TRUE(output.str().empty());
+        writer.flush();
+        EXPECT_EQ(output.str().size(), sizeof(TokenPipeHeader) + sizeof(TokenPipeRecord) + 3);
+
+        // no end record yet: the reader sees the token, then a stream cut short
+        std::istringstream cut(output.str());
+        TokenPipeReader reader(cut);
+        EXPECT_EQ(reader.next()->getValue(), "abc");
+        EXPECT_THROW(reader.next(), std::runtime_error);
+
+        std::istringstream inValue(output.str().substr(0, output.str().size() - 1));
+        TokenPipeReader valueReader(inValue);
+        EXPECT_THROW(valueReader.next(), std::runtime_error);
+
+        std::istringstream notPipe("TNYT\x01\x00\x14\x00");
+        EXPECT_THROW(TokenPipeReader{notPipe}, std::runtime_error);
+
+        std::string swapped = output.str();
+        std::swap(swapped[4], swapped[5]);
+        std::istringstream otherByteOrder(swapped);
+        EXPECT_THROW(TokenPipeReader{otherByteOrder}, std::runtime_error);
+    }
+
+} // namespace TINY::SCANNER
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "scanner.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER
+{
+
+    namespace
+    {
+        // Renders tokens with their positions, for comparing token streams
+        std::vector<std::string> render(const std::vector<Token> &tokens)
+        {
+            std::vector<std::string> lines;
+            for (const Token &token : tokens)
+            {
+                lines.push_back(token.toString(true));
+            }
+            return lines;
+        }
+
+        // Tokenizes the input with build()
+        std::vector<std::string> buildSequential(const std::string &input)
+        {
+            Scanner scanner(input);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+            return render(builder.getTokens().toTokens());
+        }
+
+        // Tokenizes the input with buildParallel() and tiny segments
+        std::vector<std::string> buildInSegments(const std::string &input, size_t segmentCount)
+        {
+            Scanner scanner(input);
+            TokenStreamBuilder builder(scanner);
+            builder.buildParallel(segmentCount, 1);
+            return render(builder.getTokens().toTokens());
+        }
+
+        // Builds a random multi-line source with nested comments that span many lines
+        std::string makeRandomSource(unsigned seed)
+        {
+            static const std::vector<std::string> pieces = {
+                "x", "count", "if", "then", "end", "repeat", "until", "read", "write", ":=", ":", "=",
+                "<", "+", "-", "*", "/", "(", ")", ";", "42", "7", "{", "}", "@", " ", "  ", "\n", "\n", "\t"};
+            std::mt19937 random(seed);
+            std::uniform_int_distribution<size_t> pick(0, pieces.size() - 1);
+            std::string source;
+            for (int i = 0; i < 2000; ++i)
+            {
+                source += pieces[pick(random)];
+                source += ' ';
+            }
+            return source;
+        }
+    } // namespace
+
+    // Test that parallel builds match the sequential build on inputs with comments across segments
+    TEST(TokenStreamBuilderTest, ParallelMatchesSequential)
+    {
+        for (unsigned seed = 1; seed <= 20; ++seed)
+        {
+            std::string input = makeRandomSource(seed);
+            std::vector<std::string> expected = buildSequential(input);
+            for (size_t segments : {2u, 3u, 8u, 64u})
+            {
+                EXPECT_EQ(buildInSegments(input, segments), expected) << "seed " << seed << ", " << segments << " segments";
+            }
+        }
+    }
+
+    // Test a comment that opens in the first segment and closes in the last one
+    TEST(TokenStreamBuilderTest, ParallelCommentSpanningSegments)
+    {
+        std::string input = "read x;\n{ a\n { b\n } c\n }\n d\n} write\n x; }\n{ unclosed\n y";
+
+        std::vector<std::string> expected = buildSequential(input);
+        ASSERT_EQ(expected.size(), 9u);
+        for (size_t segments = 2; segments <= 10; ++segments)
+        {
+            EXPECT_EQ(buildInSegments(input, segments), expected) << segments << " segments";
+        }
+    }
+
+    // Test that the scanner is left where a sequential build leaves it
+    TEST(TokenStreamBuilderTest, ParallelLeavesScannerAtEnd)
+    {
+        std::string input = "read x;\nwrite y;\nx := 1\n";
+        Scanner scanner(input);
+        TokenStreamBuilder builder(scanner);
+        builder.buildParallel(3, 1);
+
+        EXPECT_EQ(builder.getTokens().size(), 9u);
+        EXPECT_FALSE(scanner.hasMoreTokens());
+    }
+
+    // Test that segments merged in parallel get the same dense symbol IDs as a sequential build
+    TEST(TokenStreamBuilderTest, ParallelSymbolsMatchSequential)
+    {
+        std::string input = makeRandomSource(7);
+
+        Scanner sequentialScanner(input);
+        TokenStreamBuilder sequential(sequentialScanner);
+        sequential.build();
+
+        Scanner parallelScanner(input);
+        TokenStreamBuilder parallel(parallelScanner);
+        parallel.buildParallel(8, 1);
+
+        EXPECT_EQ(parallel.getTokens().getSymbols(), sequential.getTokens().getSymbols());
+        EXPECT_EQ(parallel.getTokens().getSymbolTable().size(), sequential.getTokens().getSymbolTable().size());
+    }
+
+    // Test that random edits, comment delimiters and newlines included, give the same stream as a rebuild
+    TEST(TokenStreamBuilderTest, UpdateMatchesRebuild)
+    {
+        static const std::vector<std::string> insertions = {"", "x", "y1", "if", ":", "=", ":=", "{", "}", "{ c }", "\n", " ", "42", "@", "{{", "}}", std::string(1, '\0')};
+        for (unsigned seed = 1; seed <= 10; ++seed)
+        {
+            std::string source = makeRandomSource(seed).substr(0, 1500);
+            Scanner scanner(source);
+            TokenStreamBuilder builder(scanner);
+            builder.build();
+
+            std::mt19937 random(seed);
+            for (int edit = 0; edit < 100; ++edit)
+            {
+                size_t offset = std::uniform_int_distribution<size_t>(0, source.size())(random);
+                size_t removed = std::min(source.size() - offset, std::uniform_int_distribution<size_t>(0, 3)(random));
+                const std::string &text = insertions[std::uniform_int_distribution<size_t>(0, insertions.size() - 1)(random)];
+                builder.applyEdit(source, offset, removed, text);
+
+                const TokenStream &tokens = builder.getTokens();
+                ASSERT_EQ(render(tokens.toTokens()), buildSequential(source)) << "seed " << seed << ", edit " << edit;
+                for (size_t i = 0; i < tokens.size(); ++i)
+                {
+                    if (tokens[i].getType() == TokenType::IDENTIFIER)
+                    {
+                        ASSERT_EQ(tokens.getSymbolTable().spelling(tokens[i].getSymbol()), tokens[i].getValue());
+                    }
+                }
+
+                // the scanner is left where a build of the edited source leaves it
+                Scanner rebuiltScanner(source);
+                TokenStreamBuilder rebuilt(rebuiltScanner);
+                rebuilt.build();
+                Scanner probe = scanner;
+                ASSERT_EQ(probe.getNextToken().toString(true), rebuiltScanner.getNextToken().toString(true))
+                    << "seed " << seed << ", edit " << edit;
+            }
+        }
+    }
+
+    // Test that a local edit only rescans the tokens around it
+    TEST(TokenStreamBuilderTest, UpdateRescansLocally)
+    {
+        std::string source;
+        for (int i = 0; i < 1000; ++i)
+        {
+            source += "x := x + 1;\n";
+        }
+        Scanner scanner(source);
+        TokenStreamBuilder builder(scanner);
+        builder.build();
+
+        // rename the identifier at the start of line 501 and give it a longer name
+        size_t offset = 500 * 12;
+        TokenStreamUpdate update = builder.applyEdit(source, offset, 1, "total");
+        EXPECT_EQ(update.firstToken, 500u * 6);
+        EXPECT_EQ(update.removedTokens, 1u);
+        EXPECT_EQ(update.insertedTokens, 1u);
+        EXPECT_LT(update.rescannedBytes, 20u);
+
+        const TokenStream &tokens = builder.getTokens();
+        EXPECT_EQ(tokens[500 * 6].toString(true), "total, IDENTIFIER [Line: 501, Column: 6]");
+        EXPECT_EQ(tokens[500 * 6 + 1].toString(true), ":=, ASSIGN [Line: 501, Column: 9]");
+        EXPECT_EQ(tokens[501 * 6].toString(true), "x, IDENTIFIER [Line: 502, Column: 2]");
+        EXPECT_EQ(tokens.getOffsets()[501 * 6], 501u * 12 + 4);
+
+        // a newline inserted in the middle of a line moves the rest of that line to a new line
+        builder.applyEdit(source, offset + 5, 0, "\n");
+        EXPECT_EQ(tokens[500 * 6 + 1].toString(true), ":=, ASSIGN [Line: 502, Column: 4]");
+        EXPECT_EQ(render(tokens.toTokens()), buildSequential(source));
+
+        EXPECT_THROW(builder.applyEdit(source, source.size() + 1, 0, "x"), std::out_of_range);
+    }
+} // namespace TINY::SCANNER
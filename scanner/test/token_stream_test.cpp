@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "scanner.hpp"
+#include "token_stream.hpp"
+#include "token_stream_builder.hpp"
+
+namespace TINY::SCANNER
+{
+
+    // Test that the parallel arrays describe the tokens and values are views into the source
+    TEST(TokenStreamTest, ArraysAndSourceViews)
+    {
+        std::string input = "read x;\n  y := 42";
+        Scanner scanner(input);
+        TokenStreamBuilder builder(scanner);
+        builder.build();
+        const TokenStream &tokens = builder.getTokens();
+
+        ASSERT_EQ(tokens.size(), 6u);
+        EXPECT_EQ(tokens.getTypes()[3], TokenType::IDENTIFIER);
+        EXPECT_EQ(tokens.getOffsets()[3], 10u);
+        EXPECT_EQ(tokens.getLengths()[4], 2u);
+        EXPECT_EQ(tokens[5].getLine(), 2);
+        EXPECT_EQ(tokens[5].getColumn(), 10);
+        EXPECT_EQ(tokens.getLineIndex().newlineCount(), 1u);
+
+        std::string_view value = tokens[4].getValue();
+        EXPECT_EQ(value, ":=");
+        EXPECT_EQ(value.data(), input.data() + 12);
+    }
+
+    // Test that rows behave like the Token objects the Scanner returns
+    TEST(TokenStreamTest, RowsMatchTokens)
+    {
+        std::string input = "if x < 10 then { note } write x @ end";
+        Scanner scanner(input);
+        TokenStreamBuilder builder(scanner);
+        builder.build();
+
+        Scanner reference(input);
+        size_t count = 0;
+        for (TokenStream::Row row : builder.getTokens())
+        {
+            ASSERT_TRUE(reference.hasMoreTokens());
+            Token token = reference.getNextToken();
+            EXPECT_EQ(row.getType(), token.getType());
+            EXPECT_EQ(row.getValue(), token.getValue());
+            EXPECT_EQ(row.getLine(), token.getLine());
+            EXPECT_EQ(row.getColumn(), token.getColumn());
+            EXPECT_EQ(row.toString(true), token.toString(true));
+            ++count;
+        }
+        EXPECT_FALSE(reference.hasMoreTokens());
+        EXPECT_EQ(count, builder.getTokens().size());
+    }
+
+    // Test appending one stream to another and resetting a stream
+    TEST(TokenStreamTest, AppendAndReset)
+    {
+        std::string input = "a b";
+        TokenStream first(input);
+        first.push_back(TokenType::IDENTIFIER, 0, 1);
+        TokenStream second(input);
+        second.push_back(TokenType::IDENTIFIER, 2, 1);
+
+        first.append(second);
+        ASSERT_EQ(first.size(), 2u);
+        EXPECT_EQ(first[1].getValue(), "b");
+        EXPECT_EQ(first.toTokens()[1].toString(true), "b, IDENTIFIER [Line: 1, Column: 4]");
+
+        first.reset("");
+        EXPECT_TRUE(first.empty());
+        EXPECT_EQ(first.begin(), first.end());
+    }
+
+    // Test replacing a range of tokens and shifting the tokens after an edit
+    TEST(TokenStreamTest, ReplaceAndShift)
+    {
+        std::string input = "a b c\nd";
+        TokenStream tokens(input);
+        tokens.push_back(TokenType::IDENTIFIER, 0, 1);
+        tokens.push_back(TokenType::IDENTIFIER, 2, 1);
+        tokens.push_back(TokenType::IDENTIFIER, 4, 1);
+        tokens.push_back(TokenType::IDENTIFIER, 6, 1);
+        EXPECT_EQ(tokens[2].getColumn(), 6);
+
+        // "b" becomes "x y": the edit adds two bytes before "c" on its line
+        std::string edited = "a x y c\nd";
+        TokenStream replacement(edited);
+        replacement.push_back(TokenType::IDENTIFIER, 2, 1);
+        replacement.push_back(TokenType::IDENTIFIER, 4, 1);
+
+        // the positions come from the edited source, the old line index is dropped
+        tokens.rebind(edited);
+        tokens.shift(2, 2);
+        tokens.replace(1, 1, replacement);
+
+        ASSERT_EQ(tokens.size(), 5u);
+        EXPECT_EQ(tokens[2].toString(true), "y, IDENTIFIER [Line: 1, Column: 6]");
+        EXPECT_EQ(tokens[3].toString(true), "c, IDENTIFIER [Line: 1, Column: 8]");
+        EXPECT_EQ(tokens[4].toString(true), "d, IDENTIFIER [Line: 2, Column: 2]");
+        EXPECT_EQ(tokens.getSymbolTable().spelling(tokens[2].getSymbol()), "y");
+    }
+
+    // Test that threads looking up positions of a fresh stream all get the same line index
+    TEST(TokenStreamTest, ConcurrentPositionLookups)
+    {
+        std::string input;
+        for (int line = 0; line < 1000; ++line)
+        {
+            input += "read x;\n";
+        }
+        Scanner scanner(input);
+        TokenStreamBuilder builder(scanner);
+        builder.build();
+        const TokenStream &tokens = builder.getTokens();
+
+        std::vector<const LineIndex *> indexes(8);
+        std::vector<int> lines(indexes.size());
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < indexes.size(); ++i)
+        {
+            threads.emplace_back([&tokens, &indexes, &lines, i]
+                                 {
+                lines[i] = tokens[tokens.size() - 1].getLine();
+                indexes[i] = &tokens.getLineIndex(); });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        for (size_t i = 0; i < indexes.size(); ++i)
+        {
+            EXPECT_EQ(lines[i], 1000);
+            EXPECT_EQ(indexes[i], &tokens.getLineIndex());
+        }
+    }
+
+} // namespace TINY::SCANNER
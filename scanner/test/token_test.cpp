@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
 #include "token.hpp"
 
 namespace TINY::SCANNER
@@ -23,4 +26,23 @@ namespace TINY::SCANNER
         EXPECT_EQ(token.toString(false), "if, IF");
         EXPECT_EQ(token.toString(true), "if, IF [Line: 1, Column: 1]");
     }
+
+    // Test that tokens are assignable and sortable, and view the characters they were given
+    TEST(TokenTest, CopyAssignAndSort)
+    {
+        std::string source = "x := 10";
+        std::vector<Token> tokens = {Token(TokenType::NUMBER, std::string_view(source).substr(5, 2), 1, 8),
+                                     Token(TokenType::IDENTIFIER, std::string_view(source).substr(0, 1), 1, 2),
+                                     Token(TokenType::ASSIGN, std::string_view(source).substr(2, 2), 1, 5)};
+        std::sort(tokens.begin(), tokens.end(), [](const Token &a, const Token &b)
+                  { return a.getColumn() < b.getColumn(); });
+        EXPECT_EQ(tokens[0].getValue(), "x");
+        EXPECT_EQ(tokens[1].getValue(), ":=");
+        EXPECT_EQ(tokens[2].getValue(), "10");
+        EXPECT_EQ(tokens[0].getValue().data(), source.data());
+
+        Token copy = tokens[2];
+        copy = tokens[0];
+        EXPECT_EQ(copy.toString(true), "x, IDENTIFIER [Line: 1, Column: 2]");
+    }
 } // namespace TINY::SCANNER
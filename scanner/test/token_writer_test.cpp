@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include "scanner.hpp"
+#include "token_stream_builder.hpp"
+#include "token_writer.hpp"
+
+namespace TINY::SCANNER
+{
+
+    // Test that the written lines are the ones Token::toString returns
+    TEST(TokenWriterTest, MatchesToString)
+    {
+        std::string input = "read x; { note }\nx := -2147483647 * 10 @ until x = 0";
+        Scanner scanner(input);
+        TokenStreamBuilder builder(scanner);
+        builder.build();
+        const TokenStream &tokens = builder.getTokens();
+
+        for (bool includePosition : {false, true})
+        {
+            std::string expected;
+            for (TokenStream::Row token : tokens)
+            {
+                expected += token.toString(includePosition) + "\n";
+            }
+
+            std::ostringstream output;
+            TokenWriter writer(output);
+            writer.write(tokens, includePosition);
+            writer.flush();
+            EXPECT_EQ(output.str(), expected);
+        }
+
+        EXPECT_EQ(Token(TokenType::NUMBER, "7", -2147483647 - 1, 0).toString(true),
+                  "7, NUMBER [Line: -2147483648, Column: 0]");
+    }
+
+    // Test that lines reach the stream when the buffer fills, and lines longer than the buffer are written whole
+    TEST(TokenWriterTest, SmallBuffer)
+    {
+        std::string longValue(300, 'a');
+        std::ostringstream output;
+        {
+            TokenWriter writer(output, 128);
+            writer.write(Token(TokenType::IDENTIFIER, "x", 1, 2), true);
+            writer.write(Token(TokenType::IDENTIFIER, longValue, 1, 303), true);
+            for (int i = 0; i < 20; ++i)
+            {
+                writer.write(TokenType::SEMICOLON, ";", 2, i + 1);
+            }
+            EXPECT_FALSE(output.str().empty());
+        }
+
+        std::string expected = "x, IDENTIFIER [Line: 1, Column: 2]\n" + longValue + ", IDENTIFIER [Line: 1, Column: 303]\n";
+        for (int i = 0; i < 20; ++i)
+        {
+            expected += ";, SEMICOLON\n";
+        }
+        EXPECT_EQ(output.str(), expected);
+    }
+
+} // namespace TINY::SCANNER
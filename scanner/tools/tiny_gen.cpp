@@ -0,0 +1,229 @@
+/**
+ * @file tiny_gen.cpp
+ * @brief Entry point for tiny-gen, which writes synthetic TINY programs for benchmarks and stress tests.
+ */
+
+#include <getopt.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "program_generator.hpp"
+
+namespace
+{
+    // getopt_long values of the options that only have a long form
+    enum LongOnlyOption
+    {
+        DEPTH_OPTION = 256,
+        EXPRESSION_LENGTH_OPTION,
+        COMMENT_DENSITY_OPTION,
+        COMMENT_DEPTH_OPTION,
+        VOCABULARY_OPTION
+    };
+
+    void printHelp()
+    {
+        std::cout << "Usage: tiny-gen [options] [output_file]\n"
+                  << "Writes a random, syntactically valid TINY program, to standard output by default.\n"
+                  << "Options:\n"
+                  << "  -h, --help                      Show this help message\n"
+                  << "  -o, --output <file>             Specify the output file\n"
+                  << "  -n, --size <bytes>[K|M|G]       Minimum program size (default 64K)\n"
+                  << "  -s, --seed <n>                  Seed of the random choices (default 1)\n"
+                  << "      --depth <n>                 Maximum nesting of if/repeat statements (default 3)\n"
+                  << "      --expression-length <n>     Maximum operators per expression (default 4)\n"
+                  << "      --comment-density <p>       Probability of a comment before a statement (default 0.1)\n"
+                  << "      --comment-depth <n>         Maximum nesting of comments, 0 for none (default 1)\n"
+                  << "      --vocabulary <n>            Number of distinct identifiers (default 26)\n"
+                  << "\n"
+                  << "Examples:\n"
+                  << "  tiny-gen -n 1G -s 7 big.tny\n"
+                  << "  tiny-gen --depth 8 --comment-density 0.5 --comment-depth 4 -o deep.tny\n";
+    }
+
+    // Parses an unsigned number, rejecting signs, spaces and trailing text
+    unsigned long long parseNumber(const std::string &value, const std::string &option)
+    {
+        if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+        {
+            throw std::invalid_argument("Invalid value '" + value + "' for " + option + ", use a non-negative number.");
+        }
+        try
+        {
+            return std::stoull(value);
+        }
+        catch (const std::out_of_range &)
+        {
+            throw std::invalid_argument("Value '" + value + "' for " + option + " is too large.");
+        }
+    }
+
+    // Parses a size with an optional K, M or G (binary) suffix
+    size_t parseSize(std::string value)
+    {
+        unsigned shift = 0;
+        if (!value.empty())
+        {
+            switch (value.back())
+            {
+            case 'K':
+            case 'k':
+                shift = 10;
+                break;
+            case 'M':
+            case 'm':
+                shift = 20;
+                break;
+            case 'G':
+            case 'g':
+                shift = 30;
+                break;
+            default:
+                break;
+            }
+        }
+        if (shift > 0)
+        {
+            value.pop_back();
+        }
+        unsigned long long size = parseNumber(value, "--size");
+        if (size > (std::numeric_limits<size_t>::max() >> shift))
+        {
+            throw std::invalid_argument("Size '" + value + "' is too large.");
+        }
+        return static_cast<size_t>(size << shift);
+    }
+
+    // Parses a probability between 0 and 1
+    double parseProbability(const std::string &value)
+    {
+        size_t parsed = 0;
+        double probability = 0;
+        try
+        {
+            probability = std::stod(value, &parsed);
+        }
+        catch (const std::exception &)
+        {
+            parsed = 0;
+        }
+        if (parsed != value.size() || value.empty() || !(probability >= 0 && probability <= 1))
+        {
+            throw std::invalid_argument("Invalid comment density '" + value + "', use a number between 0 and 1.");
+        }
+        return probability;
+    }
+
+    // Parses the command line into the options and the output path; returns false if only help was asked for
+    bool parseArgs(int argc, char *argv[], TINY::SCANNER::GeneratorOptions &options, std::string &outputPath)
+    {
+        static struct option long_options[] = {
+            {"help", no_argument, 0, 'h'},
+            {"output", required_argument, 0, 'o'},
+            {"size", required_argument, 0, 'n'},
+            {"seed", required_argument, 0, 's'},
+            {"depth", required_argument, 0, DEPTH_OPTION},
+            {"expression-length", required_argument, 0, EXPRESSION_LENGTH_OPTION},
+            {"comment-density", required_argument, 0, COMMENT_DENSITY_OPTION},
+            {"comment-depth", required_argument, 0, COMMENT_DEPTH_OPTION},
+            {"vocabulary", required_argument, 0, VOCABULARY_OPTION},
+            {0, 0, 0, 0} // Terminate the option array
+        };
+
+        int option_index = 0;
+        int c;
+        while ((c = getopt_long(argc, argv, "ho:n:s:", long_options, &option_index)) != -1)
+        {
+            switch (c)
+            {
+            case 'h':
+                printHelp();
+                return false;
+
+            case 'o':
+                outputPath = optarg;
+                break;
+
+            case 'n':
+                options.size = parseSize(optarg);
+                break;
+
+            case 's':
+                options.seed = parseNumber(optarg, "--seed");
+                break;
+
+            case DEPTH_OPTION:
+                options.maxNestingDepth = static_cast<size_t>(parseNumber(optarg, "--depth"));
+                break;
+
+            case EXPRESSION_LENGTH_OPTION:
+                options.maxExpressionLength = static_cast<size_t>(parseNumber(optarg, "--expression-length"));
+                break;
+
+            case COMMENT_DENSITY_OPTION:
+                options.commentDensity = parseProbability(optarg);
+                break;
+
+            case COMMENT_DEPTH_OPTION:
+                options.maxCommentDepth = static_cast<size_t>(parseNumber(optarg, "--comment-depth"));
+                break;
+
+            case VOCABULARY_OPTION:
+                options.vocabularySize = static_cast<size_t>(parseNumber(optarg, "--vocabulary"));
+                break;
+
+            default:
+                throw std::invalid_argument("Invalid option specified, use -h or --help for usage information.");
+            }
+        }
+
+        if (optind < argc)
+        {
+            if (!outputPath.empty() || optind + 1 < argc)
+            {
+                throw std::invalid_argument("Too many arguments, use -h or --help for usage information.");
+            }
+            outputPath = argv[optind];
+        }
+        return true;
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        TINY::SCANNER::GeneratorOptions options;
+        std::string outputPath;
+        if (!parseArgs(argc, argv, options, outputPath))
+        {
+            return EXIT_SUCCESS;
+        }
+
+        TINY::SCANNER::ProgramGenerator generator(options);
+        if (outputPath.empty())
+        {
+            generator.generate(std::cout);
+        }
+        else
+        {
+            std::ofstream file(outputPath, std::ios::binary);
+            if (!file)
+            {
+                throw std::runtime_error("Could not open output file: " + outputPath);
+            }
+            generator.generate(file);
+        }
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "\033[1;31m" << "Error: " << e.what() << "\033[0m" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}